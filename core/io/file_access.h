@@ -157,6 +157,10 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	// Returns a pointer to the next `p_length` bytes and moves past them if the file content is in memory, so it can be read without copying it.
+	// Returns `nullptr` without moving if it isn't, or if there are less than `p_length` bytes left, in which case `get_buffer()` must be used.
+	// The pointer is valid until the file is closed.
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -197,6 +201,10 @@ public:
 
 	void store_var(const Variant &p_var, bool p_full_objects = false);
 
+	// Maps the whole file in memory for reading, returns `nullptr` if it can't be mapped.
+	// The mapping is released when the file is closed.
+	virtual const uint8_t *map_read_only() { return nullptr; }
+
 	virtual void close() = 0;
 
 	virtual bool file_exists(const String &p_name) = 0; ///< return true if a file exists
@@ -139,6 +139,18 @@ uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessMemory::get_mapped_buffer(uint64_t p_length) const {
+	ERR_FAIL_NULL_V(data, nullptr);
+
+	if (pos > length || p_length > length - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ret = &data[pos];
+	pos += p_length;
+	return ret;
+}
+
 Error FileAccessMemory::get_error() const {
 	return pos >= length ? ERR_FILE_EOF : OK;
 }
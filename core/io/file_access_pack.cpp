@@ -190,6 +190,9 @@ PackedData::~PackedData() {
 //////////////////////////////////////////////////////////////////
 
 bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	// The pack may have been replaced since it was last loaded, its new directory must not be read from an old mapping.
+	_forget_mapped_pack(p_path);
+
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
 	if (f.is_null()) {
 		return false;
@@ -327,7 +330,47 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	return true;
 }
 
+PackedSourcePCK::MappedPack PackedSourcePCK::_get_mapped_pack(const String &p_pack) {
+	MutexLock lock(mapped_packs_mutex);
+
+	const uint64_t modified_time = FileAccess::get_modified_time(p_pack);
+	HashMap<String, MappedPack>::Iterator E = mapped_packs.find(p_pack);
+	if (E) {
+		if (E->value.modified_time == modified_time) {
+			return E->value;
+		}
+		// Replaced or modified in place, files already open keep reading the old mapping.
+		mapped_packs.remove(E);
+	}
+
+	// Failures are remembered too, so files of packs that can't be mapped are opened the regular way right away.
+	MappedPack mp;
+	mp.modified_time = modified_time;
+	Ref<FileAccess> f = FileAccess::open(p_pack, FileAccess::READ);
+	if (f.is_valid()) {
+		mp.data = f->map_read_only();
+		if (mp.data) {
+			mp.file = f;
+			mp.length = f->get_length();
+		}
+	}
+	mapped_packs.insert(p_pack, mp);
+	return mp;
+}
+
+void PackedSourcePCK::_forget_mapped_pack(const String &p_pack) {
+	MutexLock lock(mapped_packs_mutex);
+	mapped_packs.erase(p_pack);
+}
+
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	// Encrypted files are decrypted as they are read, so they can't be used from the mapping.
+	if (!p_file->encrypted && PackedData::get_singleton()->is_memory_mapping_enabled()) {
+		MappedPack mp = _get_mapped_pack(p_file->pack);
+		if (mp.data && p_file->offset <= mp.length && p_file->size <= mp.length - p_file->offset) {
+			return memnew(FileAccessPack(p_path, *p_file, mp.file, mp.data + p_file->offset));
+		}
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -339,7 +382,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped_data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -347,7 +392,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!is_open(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -355,7 +400,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid()) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -376,7 +423,7 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!is_open(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -389,21 +436,37 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (mapped_data) {
+		memcpy(p_dst, mapped_data + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_mapped_buffer(uint64_t p_length) const {
+	if (!mapped_data || eof || pos > pf.size || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ret = mapped_data + pos;
+	pos += p_length;
+	return ret;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!is_open(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -427,6 +490,8 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped_data = nullptr;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
@@ -457,6 +522,15 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	eof = false;
 }
 
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped_data) :
+		pf(p_file),
+		pos(0),
+		eof(false),
+		off(p_file.offset),
+		mapped_pack(p_mapped_pack),
+		mapped_data(p_mapped_data) {
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // DIR ACCESS
 //////////////////////////////////////////////////////////////////////////////////
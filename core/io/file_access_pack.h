@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -106,6 +107,7 @@ private:
 
 	static PackedData *singleton;
 	bool disabled = false;
+	bool memory_mapping_enabled = true;
 
 	void _free_packed_dirs(PackedDir *p_dir);
 	void _get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const;
@@ -120,6 +122,10 @@ public:
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	// Read the files of packs through a memory mapping of the whole pack when supported, instead of opening the pack for each file.
+	void set_memory_mapping_enabled(bool p_enabled) { memory_mapping_enabled = p_enabled; }
+	_FORCE_INLINE_ bool is_memory_mapping_enabled() const { return memory_mapping_enabled; }
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
@@ -143,6 +149,19 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	struct MappedPack {
+		Ref<FileAccess> file; // Owns the mapping, null if the pack can't be mapped.
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+		uint64_t modified_time = 0; // Of the pack when it was mapped, a pack replaced since then is mapped again.
+	};
+
+	Mutex mapped_packs_mutex;
+	HashMap<String, MappedPack> mapped_packs;
+
+	MappedPack _get_mapped_pack(const String &p_pack);
+	void _forget_mapped_pack(const String &p_pack);
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -156,6 +175,11 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+
+	// Used instead of `f` when the pack is memory-mapped, `mapped_data` points to the start of the file.
+	Ref<FileAccess> mapped_pack;
+	const uint8_t *mapped_data = nullptr;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -177,6 +201,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -191,6 +216,7 @@ public:
 	virtual void close() override;
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped_data);
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -933,8 +933,13 @@ String ResourceLoaderBinary::get_unicode_string() {
 	if (len == 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
 	String s;
+	const uint8_t *mapped = f->get_mapped_buffer(len);
+	if (mapped) {
+		s.parse_utf8((const char *)mapped, len);
+		return s;
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], len);
 	s.parse_utf8(&str_buf[0]);
 	return s;
 }
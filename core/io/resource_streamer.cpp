@@ -0,0 +1,376 @@
+/**************************************************************************/
+/*  resource_streamer.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "resource_streamer.h"
+
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/os/os.h"
+
+uint64_t ResourceStreamer::_estimate_size(const String &p_path) {
+	// There is no generic way to tell how much memory a resource uses, so go by the size of the file it was loaded from.
+	const String path = ResourceLoader::import_remap(ResourceLoader::path_remap(p_path));
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	return f.is_valid() ? f->get_length() : 0;
+}
+
+void ResourceStreamer::_dispatch() {
+	LocalVector<String> failed;
+
+	while ((int)loading.size() < max_concurrent_loads && !queued.is_empty()) {
+		uint32_t best = 0;
+		const Request *best_request = requests.getptr(queued[0]);
+		for (uint32_t i = 1; i < queued.size(); i++) {
+			const Request *r = requests.getptr(queued[i]);
+			if (r->priority > best_request->priority || (r->priority == best_request->priority && r->order < best_request->order)) {
+				best = i;
+				best_request = r;
+			}
+		}
+
+		const String path = queued[best];
+		queued.remove_at_unordered(best);
+
+		Request &r = requests[path];
+		if (ResourceLoader::load_threaded_request(path, r.type_hint, use_sub_threads) != OK) {
+			requests.erase(path);
+			metrics.failed++;
+			failed.push_back(path);
+			continue;
+		}
+
+		r.status = STATUS_LOADING;
+		r.dispatched_usec = OS::get_singleton()->get_ticks_usec();
+		metrics.dispatched++;
+		metrics.wait_total_usec += r.dispatched_usec - r.requested_usec;
+		loading.push_back(path);
+	}
+
+	for (const String &path : failed) {
+		emit_signal(SNAME("resource_load_failed"), path);
+	}
+}
+
+void ResourceStreamer::_collect() {
+	LocalVector<Pair<String, Ref<Resource>>> loaded;
+	LocalVector<String> failed;
+
+	for (uint32_t i = 0; i < loading.size();) {
+		const String path = loading[i];
+		if (ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_IN_PROGRESS) {
+			i++;
+			continue;
+		}
+		loading.remove_at_unordered(i);
+
+		// Always claim the result, even for canceled requests, as the loader keeps it around until then.
+		Ref<Resource> res = ResourceLoader::load_threaded_get(path);
+
+		HashMap<String, Request>::Iterator E = requests.find(path);
+		ERR_CONTINUE(!E);
+		Request &r = E->value;
+		if (r.canceled) {
+			requests.remove(E);
+		} else if (res.is_null()) {
+			requests.remove(E);
+			metrics.failed++;
+			failed.push_back(path);
+		} else {
+			uint64_t latency = OS::get_singleton()->get_ticks_usec() - r.requested_usec;
+			metrics.loaded++;
+			metrics.latency_total_usec += latency;
+			metrics.latency_max_usec = MAX(metrics.latency_max_usec, latency);
+
+			r.resource = res;
+			_make_resident(path, r);
+			loaded.push_back(Pair<String, Ref<Resource>>(path, res));
+		}
+	}
+
+	for (const Pair<String, Ref<Resource>> &E : loaded) {
+		emit_signal(SNAME("resource_loaded"), E.first, E.second);
+	}
+	for (const String &path : failed) {
+		emit_signal(SNAME("resource_load_failed"), path);
+	}
+}
+
+void ResourceStreamer::_make_resident(const String &p_path, Request &r_request) {
+	const String &res_path = r_request.resource->get_path();
+	r_request.size = _estimate_size(res_path.is_empty() ? p_path : res_path);
+	r_request.status = STATUS_LOADED;
+
+	Group &group = groups[r_request.group];
+	group.usage += r_request.size;
+	r_request.lru = group.lru.push_front(p_path);
+}
+
+void ResourceStreamer::_release_resident(Request &r_request) {
+	Group *group = groups.getptr(r_request.group);
+	ERR_FAIL_NULL(group);
+	group->usage -= r_request.size;
+	group->lru.erase(r_request.lru);
+	r_request.lru = nullptr;
+	r_request.resource.unref();
+}
+
+void ResourceStreamer::_enforce_budgets() {
+	LocalVector<String> evicted;
+
+	for (KeyValue<StringName, Group> &E : groups) {
+		Group &group = E.value;
+		// The most recently used resource is always kept, even if it doesn't fit in the budget on its own.
+		while (group.budget > 0 && group.usage > group.budget && group.lru.size() > 1) {
+			const String path = group.lru.back()->get();
+			HashMap<String, Request>::Iterator R = requests.find(path);
+			ERR_BREAK(!R);
+			_release_resident(R->value);
+			requests.remove(R);
+			metrics.evicted++;
+			evicted.push_back(path);
+		}
+	}
+
+	for (const String &path : evicted) {
+		emit_signal(SNAME("resource_evicted"), path);
+	}
+}
+
+Error ResourceStreamer::request(const String &p_path, const String &p_type_hint, int p_priority, const StringName &p_group) {
+	ERR_FAIL_COND_V(p_path.is_empty(), ERR_INVALID_PARAMETER);
+
+	HashMap<String, Request>::Iterator E = requests.find(p_path);
+	if (E) {
+		Request &r = E->value;
+		r.priority = p_priority;
+		if (r.canceled) {
+			// Requested again before the canceled load was done, so its result can be kept after all.
+			r.canceled = false;
+			r.group = p_group;
+			r.requested_usec = OS::get_singleton()->get_ticks_usec();
+			metrics.requested++;
+		} else if (r.status == STATUS_LOADED) {
+			groups[r.group].lru.move_to_front(r.lru);
+		}
+		return OK;
+	}
+
+	Request r;
+	r.type_hint = p_type_hint;
+	r.group = p_group;
+	r.priority = p_priority;
+	r.order = next_order++;
+	r.requested_usec = OS::get_singleton()->get_ticks_usec();
+	requests.insert(p_path, r);
+	queued.push_back(p_path);
+	metrics.requested++;
+
+	return OK;
+}
+
+bool ResourceStreamer::cancel(const String &p_path) {
+	HashMap<String, Request>::Iterator E = requests.find(p_path);
+	if (!E || E->value.canceled) {
+		return false;
+	}
+
+	Request &r = E->value;
+	switch (r.status) {
+		case STATUS_QUEUED: {
+			queued.erase(p_path);
+			requests.remove(E);
+			metrics.canceled++;
+		} break;
+		case STATUS_LOADING: {
+			r.canceled = true;
+			metrics.canceled++;
+		} break;
+		case STATUS_LOADED: {
+			_release_resident(r);
+			requests.remove(E);
+		} break;
+		default:
+			break;
+	}
+	return true;
+}
+
+void ResourceStreamer::clear() {
+	LocalVector<String> to_remove;
+	for (KeyValue<String, Request> &E : requests) {
+		Request &r = E.value;
+		switch (r.status) {
+			case STATUS_QUEUED: {
+				metrics.canceled++;
+				to_remove.push_back(E.key);
+			} break;
+			case STATUS_LOADING: {
+				if (!r.canceled) {
+					r.canceled = true;
+					metrics.canceled++;
+				}
+			} break;
+			case STATUS_LOADED: {
+				_release_resident(r);
+				to_remove.push_back(E.key);
+			} break;
+			default:
+				break;
+		}
+	}
+
+	for (const String &path : to_remove) {
+		requests.erase(path);
+	}
+	queued.clear();
+}
+
+ResourceStreamer::Status ResourceStreamer::get_status(const String &p_path) const {
+	const Request *r = requests.getptr(p_path);
+	if (!r || r->canceled) {
+		return STATUS_NONE;
+	}
+	return r->status;
+}
+
+Ref<Resource> ResourceStreamer::get_resource(const String &p_path) {
+	Request *r = requests.getptr(p_path);
+	if (!r || r->status != STATUS_LOADED) {
+		return Ref<Resource>();
+	}
+	groups[r->group].lru.move_to_front(r->lru);
+	return r->resource;
+}
+
+void ResourceStreamer::poll() {
+	_collect();
+	_enforce_budgets();
+	_dispatch();
+}
+
+void ResourceStreamer::set_max_concurrent_loads(int p_count) {
+	ERR_FAIL_COND(p_count < 1);
+	max_concurrent_loads = p_count;
+}
+
+int ResourceStreamer::get_max_concurrent_loads() const {
+	return max_concurrent_loads;
+}
+
+void ResourceStreamer::set_use_sub_threads(bool p_enable) {
+	use_sub_threads = p_enable;
+}
+
+bool ResourceStreamer::is_using_sub_threads() const {
+	return use_sub_threads;
+}
+
+void ResourceStreamer::set_group_budget(const StringName &p_group, int64_t p_bytes) {
+	ERR_FAIL_COND(p_bytes < 0);
+	groups[p_group].budget = p_bytes;
+}
+
+int64_t ResourceStreamer::get_group_budget(const StringName &p_group) const {
+	const Group *group = groups.getptr(p_group);
+	return group ? group->budget : 0;
+}
+
+int64_t ResourceStreamer::get_group_usage(const StringName &p_group) const {
+	const Group *group = groups.getptr(p_group);
+	return group ? group->usage : 0;
+}
+
+Dictionary ResourceStreamer::get_metrics() const {
+	uint64_t resident = 0;
+	uint64_t resident_bytes = 0;
+	for (const KeyValue<StringName, Group> &E : groups) {
+		resident += E.value.lru.size();
+		resident_bytes += E.value.usage;
+	}
+
+	Dictionary ret;
+	ret["requested"] = metrics.requested;
+	ret["loaded"] = metrics.loaded;
+	ret["failed"] = metrics.failed;
+	ret["canceled"] = metrics.canceled;
+	ret["evicted"] = metrics.evicted;
+	ret["queued"] = queued.size();
+	ret["loading"] = loading.size();
+	ret["resident"] = resident;
+	ret["resident_bytes"] = resident_bytes;
+	ret["average_wait_usec"] = metrics.dispatched ? metrics.wait_total_usec / metrics.dispatched : 0;
+	ret["average_latency_usec"] = metrics.loaded ? metrics.latency_total_usec / metrics.loaded : 0;
+	ret["max_latency_usec"] = metrics.latency_max_usec;
+	return ret;
+}
+
+void ResourceStreamer::reset_metrics() {
+	metrics = Metrics();
+}
+
+void ResourceStreamer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("request", "path", "type_hint", "priority", "group"), &ResourceStreamer::request, DEFVAL(""), DEFVAL(0), DEFVAL(StringName()));
+	ClassDB::bind_method(D_METHOD("cancel", "path"), &ResourceStreamer::cancel);
+	ClassDB::bind_method(D_METHOD("clear"), &ResourceStreamer::clear);
+	ClassDB::bind_method(D_METHOD("get_status", "path"), &ResourceStreamer::get_status);
+	ClassDB::bind_method(D_METHOD("get_resource", "path"), &ResourceStreamer::get_resource);
+	ClassDB::bind_method(D_METHOD("poll"), &ResourceStreamer::poll);
+
+	ClassDB::bind_method(D_METHOD("set_max_concurrent_loads", "count"), &ResourceStreamer::set_max_concurrent_loads);
+	ClassDB::bind_method(D_METHOD("get_max_concurrent_loads"), &ResourceStreamer::get_max_concurrent_loads);
+	ClassDB::bind_method(D_METHOD("set_use_sub_threads", "enable"), &ResourceStreamer::set_use_sub_threads);
+	ClassDB::bind_method(D_METHOD("is_using_sub_threads"), &ResourceStreamer::is_using_sub_threads);
+
+	ClassDB::bind_method(D_METHOD("set_group_budget", "group", "bytes"), &ResourceStreamer::set_group_budget);
+	ClassDB::bind_method(D_METHOD("get_group_budget", "group"), &ResourceStreamer::get_group_budget);
+	ClassDB::bind_method(D_METHOD("get_group_usage", "group"), &ResourceStreamer::get_group_usage);
+
+	ClassDB::bind_method(D_METHOD("get_metrics"), &ResourceStreamer::get_metrics);
+	ClassDB::bind_method(D_METHOD("reset_metrics"), &ResourceStreamer::reset_metrics);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_concurrent_loads", PROPERTY_HINT_RANGE, "1,16,1,or_greater"), "set_max_concurrent_loads", "get_max_concurrent_loads");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_sub_threads"), "set_use_sub_threads", "is_using_sub_threads");
+
+	ADD_SIGNAL(MethodInfo("resource_loaded", PropertyInfo(Variant::STRING, "path"), PropertyInfo(Variant::OBJECT, "resource", PROPERTY_HINT_RESOURCE_TYPE, "Resource")));
+	ADD_SIGNAL(MethodInfo("resource_load_failed", PropertyInfo(Variant::STRING, "path")));
+	ADD_SIGNAL(MethodInfo("resource_evicted", PropertyInfo(Variant::STRING, "path")));
+
+	BIND_ENUM_CONSTANT(STATUS_NONE);
+	BIND_ENUM_CONSTANT(STATUS_QUEUED);
+	BIND_ENUM_CONSTANT(STATUS_LOADING);
+	BIND_ENUM_CONSTANT(STATUS_LOADED);
+}
+
+ResourceStreamer::~ResourceStreamer() {
+	// Loads in flight must still be claimed, or the loader would keep them forever.
+	for (const String &path : loading) {
+		ResourceLoader::load_threaded_get(path);
+	}
+}
@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  resource_streamer.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RESOURCE_STREAMER_H
+#define RESOURCE_STREAMER_H
+
+#include "core/io/resource.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+
+// Schedules threaded loads on top of `ResourceLoader::load_threaded_request()`.
+// Requests are queued and dispatched by priority, only `max_concurrent_loads` at a time, so they can
+// still be reprioritized or canceled while waiting. Loaded resources are kept resident per group,
+// and the least recently used ones are dropped when a group goes over its memory budget.
+// Not thread-safe, all methods must be called from the same thread.
+class ResourceStreamer : public RefCounted {
+	GDCLASS(ResourceStreamer, RefCounted);
+
+public:
+	enum Status {
+		STATUS_NONE,
+		STATUS_QUEUED,
+		STATUS_LOADING,
+		STATUS_LOADED,
+	};
+
+private:
+	struct Request {
+		String type_hint;
+		StringName group;
+		int priority = 0;
+		Status status = STATUS_QUEUED;
+		bool canceled = false; // Loads in flight can't be stopped, their result is dropped once done.
+		uint64_t order = 0; // Keeps requests of the same priority in FIFO order.
+		uint64_t requested_usec = 0;
+		uint64_t dispatched_usec = 0;
+
+		Ref<Resource> resource;
+		uint64_t size = 0;
+		List<String>::Element *lru = nullptr;
+	};
+
+	struct Group {
+		uint64_t budget = 0; // Zero means unlimited.
+		uint64_t usage = 0;
+		List<String> lru; // Most recently used first.
+	};
+
+	struct Metrics {
+		uint64_t requested = 0;
+		uint64_t dispatched = 0;
+		uint64_t loaded = 0;
+		uint64_t failed = 0;
+		uint64_t canceled = 0;
+		uint64_t evicted = 0;
+		uint64_t latency_total_usec = 0;
+		uint64_t latency_max_usec = 0;
+		uint64_t wait_total_usec = 0;
+	};
+
+	HashMap<String, Request> requests;
+	HashMap<StringName, Group> groups;
+	LocalVector<String> queued;
+	LocalVector<String> loading;
+	uint64_t next_order = 0;
+	int max_concurrent_loads = 2;
+	bool use_sub_threads = false;
+	Metrics metrics;
+
+	static uint64_t _estimate_size(const String &p_path);
+
+	void _dispatch();
+	void _collect();
+	void _make_resident(const String &p_path, Request &r_request);
+	void _release_resident(Request &r_request);
+	void _enforce_budgets();
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error request(const String &p_path, const String &p_type_hint = "", int p_priority = 0, const StringName &p_group = StringName());
+	bool cancel(const String &p_path);
+	void clear();
+
+	Status get_status(const String &p_path) const;
+	Ref<Resource> get_resource(const String &p_path);
+
+	void poll();
+
+	void set_max_concurrent_loads(int p_count);
+	int get_max_concurrent_loads() const;
+
+	void set_use_sub_threads(bool p_enable);
+	bool is_using_sub_threads() const;
+
+	void set_group_budget(const StringName &p_group, int64_t p_bytes);
+	int64_t get_group_budget(const StringName &p_group) const;
+	int64_t get_group_usage(const StringName &p_group) const;
+
+	Dictionary get_metrics() const;
+	void reset_metrics();
+
+	ResourceStreamer() {}
+	~ResourceStreamer();
+};
+
+VARIANT_ENUM_CAST(ResourceStreamer::Status);
+
+#endif // RESOURCE_STREAMER_H
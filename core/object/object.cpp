@@ -43,21 +43,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1076,6 +1061,7 @@ void Object::add_user_signal(const MethodInfo &p_signal) {
 	SignalData s;
 	s.user = p_signal;
 	signal_map[p_signal.name] = s;
+	_signal_map_version++;
 }
 
 bool Object::_has_user_signal(const StringName &p_name) const {
@@ -1097,6 +1083,7 @@ void Object::_remove_user_signal(const StringName &p_name) {
 	}
 
 	signal_map.erase(p_name);
+	_signal_map_version++;
 }
 
 Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
@@ -1127,6 +1114,71 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+Object::SignalData::SlotCache *Object::SignalData::SlotCacheRef::_try_reference(uintptr_t p_current) {
+	// Only one thread at a time can take a reference, clear() waits for it to be done.
+	if ((p_current & REFERENCING) || !cache.compare_exchange_weak(p_current, p_current | REFERENCING, std::memory_order_acquire)) {
+		return nullptr;
+	}
+	SlotCache *current = reinterpret_cast<SlotCache *>(p_current);
+	current->refcount.ref();
+	cache.store(p_current, std::memory_order_release);
+	return current;
+}
+
+Object::SignalData::SlotCache *Object::SignalData::SlotCacheRef::acquire(const HashMap<Callable, Slot, HashableHasher<Callable>> &p_slot_map) {
+	uintptr_t current = cache.load(std::memory_order_acquire);
+	while (likely(current)) {
+		SlotCache *referenced = _try_reference(current);
+		if (likely(referenced)) {
+			return referenced;
+		}
+		current = cache.load(std::memory_order_acquire);
+	}
+
+	SlotCache *built = memnew(SlotCache);
+	built->refcount.init(2); // One for this object, one for the caller.
+	built->entries.resize(p_slot_map.size());
+	uint32_t i = 0;
+	for (const KeyValue<Callable, Slot> &slot_kv : p_slot_map) {
+		built->entries[i].callable = slot_kv.value.conn.callable;
+		built->entries[i].flags = slot_kv.value.conn.flags;
+		built->has_one_shot = built->has_one_shot || (slot_kv.value.conn.flags & CONNECT_ONE_SHOT);
+		i++;
+	}
+	DEV_ASSERT(!(reinterpret_cast<uintptr_t>(built) & REFERENCING));
+
+	while (true) {
+		current = 0;
+		if (cache.compare_exchange_weak(current, reinterpret_cast<uintptr_t>(built), std::memory_order_acq_rel)) {
+			return built;
+		}
+		if (current) {
+			// Another thread emitting the same signal built it as well, keep the first one.
+			SlotCache *referenced = _try_reference(current);
+			if (referenced) {
+				memdelete(built);
+				return referenced;
+			}
+		}
+	}
+}
+
+void Object::SignalData::SlotCacheRef::release(SlotCache *p_cache) {
+	if (p_cache->refcount.unref()) {
+		memdelete(p_cache);
+	}
+}
+
+void Object::SignalData::SlotCacheRef::clear() {
+	uintptr_t current = cache.load(std::memory_order_acquire);
+	while ((current & REFERENCING) || !cache.compare_exchange_weak(current, 0, std::memory_order_acq_rel)) {
+		current = cache.load(std::memory_order_acquire);
+	}
+	if (current) {
+		release(reinterpret_cast<SlotCache *>(current));
+	}
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
@@ -1143,35 +1195,66 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
-	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
-	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
-	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
+	return _emit_signal_slots(s, p_name, p_args, p_argcount);
+}
 
-	// Ensure that disconnecting the signal or even deleting the object
-	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-	uint32_t slot_count = 0;
+Object::SignalHandle Object::get_signal_handle(const StringName &p_name) const {
+	SignalHandle handle;
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_V_MSG(!signal_map.has(p_name) && !ClassDB::has_signal(get_class_name(), p_name) && (script.is_null() || !Ref<Script>(script)->has_script_signal(p_name)), handle, vformat("Can't get a handle to non-existing signal \"%s\".", p_name));
+#endif
+	handle.object = this;
+	handle.name = p_name;
+	handle.data = const_cast<SignalData *>(signal_map.getptr(p_name));
+	handle.version = _signal_map_version;
+	return handle;
+}
 
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
+Error Object::emit_signal_handlep(SignalHandle &p_handle, const Variant **p_args, int p_argcount) {
+	ERR_FAIL_COND_V_MSG(p_handle.object != this, ERR_INVALID_PARAMETER, "The signal handle was not obtained from this object.");
+
+	if (_block_signals) {
+		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	DEV_ASSERT(slot_count == s->slot_map.size());
+	if (unlikely(p_handle.version != _signal_map_version)) {
+		// Entries of the map stay at the same address until erased, so it only has to be resolved again after signals were added or removed.
+		p_handle.data = signal_map.getptr(p_handle.name);
+		p_handle.version = _signal_map_version;
+	}
 
-	// Disconnect all one-shot connections before emitting to prevent recursion.
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+	if (!p_handle.data) {
+		//not connected? just return
+		return ERR_UNAVAILABLE;
+	}
+
+	return _emit_signal_slots(p_handle.data, p_handle.name, p_args, p_argcount);
+}
+
+Error Object::_emit_signal_slots(SignalData *p_signal_data, const StringName &p_name, const Variant **p_args, int p_argcount) {
+	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
+	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
+	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
+
+	// Ensure that disconnecting the signal or even deleting the object
+	// will not affect the signal calling. The cache is only replaced, never modified, while this reference is held.
+	SignalData::SlotCache *cache = p_signal_data->slot_cache.acquire(p_signal_data->slot_map);
+	const SignalData::SlotCache::Entry *slots = cache->entries.ptr();
+	const uint32_t slot_count = cache->entries.size();
+
+	if (cache->has_one_shot) {
+		// Disconnect all one-shot connections before emitting to prevent recursion.
+		for (uint32_t i = 0; i < slot_count; ++i) {
+			bool disconnect = slots[i].flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-			disconnect = false;
-		}
+			if (disconnect && (slots[i].flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+				disconnect = false;
+			}
 #endif
-		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			if (disconnect) {
+				_disconnect(p_name, slots[i].callable);
+			}
 		}
 	}
 
@@ -1180,8 +1263,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Error err = OK;
 
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+		const Callable &callable = slots[i].callable;
+		const uint32_t &flags = slots[i].flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1217,9 +1300,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
+	SignalData::SlotCacheRef::release(cache);
 
 	return err;
 }
@@ -1404,6 +1485,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 		signal_map[p_signal] = SignalData();
 		s = &signal_map[p_signal];
+		_signal_map_version++;
 	}
 
 	//compare with the base callable, so binds can be ignored
@@ -1434,6 +1516,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->slot_cache.clear();
 
 	return OK;
 }
@@ -1509,10 +1592,12 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->slot_cache.clear();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
 		signal_map.erase(p_signal);
+		_signal_map_version++;
 	}
 
 	return true;
@@ -2146,6 +2231,7 @@ Object::~Object() {
 
 		signal_map.erase(E.key);
 	}
+	_signal_map_version++;
 
 	// Disconnect signals that connect to this object.
 	while (connections.size()) {
@@ -39,6 +39,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/callable_bind.h"
@@ -588,6 +589,25 @@ public:
 		Connection(const Variant &p_variant);
 	};
 
+private:
+	struct SignalData;
+
+public:
+	// Signal of a specific object resolved ahead of time with `get_signal_handle()`, for signals emitted often.
+	// Emitting through it skips looking up the signal by name, unless signals were added or removed since.
+	class SignalHandle {
+		friend class Object;
+
+		const Object *object = nullptr;
+		StringName name;
+		SignalData *data = nullptr;
+		uint32_t version = 0;
+
+	public:
+		_FORCE_INLINE_ const StringName &get_name() const { return name; }
+		_FORCE_INLINE_ bool is_null() const { return object == nullptr; }
+	};
+
 private:
 #ifdef DEBUG_ENABLED
 	friend struct _ObjectDebugLock;
@@ -605,12 +625,49 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// Contiguous copy of the connections, so emitting does not have to gather them from `slot_map` each time.
+		// It's rebuilt lazily after the connections change. Emissions hold a reference to it, so connecting or
+		// disconnecting from a callback replaces the cache instead of modifying the one being iterated.
+		struct SlotCache {
+			struct Entry {
+				Callable callable;
+				uint32_t flags = 0;
+			};
+
+			SafeRefCount refcount;
+			LocalVector<Entry> entries;
+			bool has_one_shot = false;
+		};
+
+		// Owns the cache of a signal. Copies start empty, the cache is built again on the next emission.
+		class SlotCacheRef {
+			// The lowest bit of the pointer is set while a reference is being taken, so the cache can't be cleared
+			// and freed in between. Caches are allocated with memnew, so the bit is never part of the address.
+			static constexpr uintptr_t REFERENCING = 1;
+			std::atomic<uintptr_t> cache = 0;
+
+			SlotCache *_try_reference(uintptr_t p_current);
+
+		public:
+			SlotCache *acquire(const HashMap<Callable, Slot, HashableHasher<Callable>> &p_slot_map);
+			static void release(SlotCache *p_cache);
+			void clear();
+
+			void operator=(const SlotCacheRef &p_other) { clear(); }
+			SlotCacheRef() {}
+			SlotCacheRef(const SlotCacheRef &p_other) {}
+			~SlotCacheRef() { clear(); }
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		SlotCacheRef slot_cache;
 		bool removable = false;
 	};
 
 	HashMap<StringName, SignalData> signal_map;
+	// Changes whenever a signal is added to or removed from `signal_map`, see `SignalHandle`.
+	uint32_t _signal_map_version = 0;
 	List<Connection> connections;
 #ifdef DEBUG_ENABLED
 	SafeRefCount _lock_index;
@@ -755,6 +812,7 @@ protected:
 	friend class PlaceholderExtensionInstance;
 
 	bool _disconnect(const StringName &p_signal, const Callable &p_callable, bool p_force = false);
+	Error _emit_signal_slots(SignalData *p_signal_data, const StringName &p_name, const Variant **p_args, int p_argcount);
 
 #ifdef TOOLS_ENABLED
 	struct VirtualMethodTracker {
@@ -922,6 +980,20 @@ public:
 	}
 
 	MTVIRTUAL Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount);
+
+	SignalHandle get_signal_handle(const StringName &p_name) const;
+
+	template <typename... VarArgs>
+	Error emit_signal(SignalHandle &p_handle, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		return emit_signal_handlep(p_handle, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+
+	MTVIRTUAL Error emit_signal_handlep(SignalHandle &p_handle, const Variant **p_args, int p_argcount);
 	MTVIRTUAL bool has_signal(const StringName &p_name) const;
 	MTVIRTUAL void get_signal_list(List<MethodInfo> *p_signals) const;
 	MTVIRTUAL void get_signal_connection_list(const StringName &p_signal, List<Connection> *p_connections) const;
@@ -1054,4 +1126,22 @@ public:
 	static int get_object_count();
 };
 
+#ifdef DEBUG_ENABLED
+// Held while calling into an object, so freeing it from the call is reported.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+#endif
+
 #endif // OBJECT_H
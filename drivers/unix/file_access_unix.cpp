@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -163,6 +164,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapping) {
+		munmap(mapping, mapping_length);
+		mapping = nullptr;
+		mapping_length = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -430,6 +437,31 @@ Error FileAccessUnix::_set_read_only_attribute(const String &p_file, bool p_ro)
 #endif
 }
 
+const uint8_t *FileAccessUnix::map_read_only() {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	if (mapping) {
+		return mapping;
+	}
+	if (flags != READ) {
+		return nullptr;
+	}
+
+	uint64_t length = get_length();
+	if (length == 0 || length > SIZE_MAX) {
+		return nullptr;
+	}
+
+	void *data = mmap(nullptr, length, PROT_READ, MAP_SHARED, fileno(f), 0);
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapping = (uint8_t *)data;
+	mapping_length = length;
+	return mapping;
+}
+
 void FileAccessUnix::close() {
 	_close();
 }
@@ -49,6 +49,9 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	uint8_t *mapping = nullptr;
+	uint64_t mapping_length = 0;
+
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -90,6 +93,8 @@ public:
 	virtual bool _get_read_only_attribute(const String &p_file) override;
 	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override;
 
+	virtual const uint8_t *map_read_only() override;
+
 	virtual void close() override;
 
 	FileAccessUnix() {}
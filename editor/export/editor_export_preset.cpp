@@ -87,6 +87,7 @@ void EditorExportPreset::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_encrypt_directory"), &EditorExportPreset::get_enc_directory);
 	ClassDB::bind_method(D_METHOD("get_encryption_key"), &EditorExportPreset::get_script_encryption_key);
 	ClassDB::bind_method(D_METHOD("get_script_export_mode"), &EditorExportPreset::get_script_export_mode);
+	ClassDB::bind_method(D_METHOD("is_script_bytecode_cache_enabled"), &EditorExportPreset::is_script_bytecode_cache_enabled);
 
 	ClassDB::bind_method(D_METHOD("get_or_env", "name", "env_var"), &EditorExportPreset::_get_or_env);
 	ClassDB::bind_method(D_METHOD("get_version", "name", "windows_version"), &EditorExportPreset::get_version);
@@ -496,6 +497,15 @@ int EditorExportPreset::get_script_export_mode() const {
 	return script_mode;
 }
 
+void EditorExportPreset::set_script_bytecode_cache_enabled(bool p_enabled) {
+	script_bytecode_cache = p_enabled;
+	EditorExport::singleton->save_presets();
+}
+
+bool EditorExportPreset::is_script_bytecode_cache_enabled() const {
+	return script_bytecode_cache;
+}
+
 Variant EditorExportPreset::get_or_env(const StringName &p_name, const String &p_env_var, bool *r_valid) const {
 	const String from_env = OS::get_singleton()->get_environment(p_env_var);
 	if (!from_env.is_empty()) {
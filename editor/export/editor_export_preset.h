@@ -96,6 +96,7 @@ private:
 
 	String script_key;
 	int script_mode = MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
+	bool script_bytecode_cache = false;
 
 protected:
 	bool _set(const StringName &p_name, const Variant &p_value);
@@ -181,6 +182,9 @@ public:
 	void set_script_export_mode(int p_mode);
 	int get_script_export_mode() const;
 
+	void set_script_bytecode_cache_enabled(bool p_enabled);
+	bool is_script_bytecode_cache_enabled() const;
+
 	Variant _get_or_env(const StringName &p_name, const String &p_env_var) const {
 		return get_or_env(p_name, p_env_var);
 	}
@@ -416,6 +416,8 @@ void ProjectExportDialog::_edit_preset(int p_index) {
 
 	int script_export_mode = current->get_script_export_mode();
 	script_mode->select(script_export_mode);
+	script_bytecode_cache->set_pressed(current->is_script_bytecode_cache_enabled());
+	script_bytecode_cache->set_disabled(script_export_mode == EditorExportPreset::MODE_SCRIPT_TEXT);
 
 	updating = false;
 }
@@ -658,6 +660,20 @@ void ProjectExportDialog::_script_export_mode_changed(int p_mode) {
 	ERR_FAIL_COND(current.is_null());
 
 	current->set_script_export_mode(p_mode);
+	script_bytecode_cache->set_disabled(p_mode == EditorExportPreset::MODE_SCRIPT_TEXT);
+
+	_update_current_preset();
+}
+
+void ProjectExportDialog::_script_bytecode_cache_changed(bool p_pressed) {
+	if (updating) {
+		return;
+	}
+
+	Ref<EditorExportPreset> current = get_current_preset();
+	ERR_FAIL_COND(current.is_null());
+
+	current->set_script_bytecode_cache_enabled(p_pressed);
 
 	_update_current_preset();
 }
@@ -705,6 +721,7 @@ void ProjectExportDialog::_duplicate_preset() {
 	preset->set_exclude_filter(current->get_exclude_filter());
 	preset->set_patches(current->get_patches());
 	preset->set_custom_features(current->get_custom_features());
+	preset->set_script_bytecode_cache_enabled(current->is_script_bytecode_cache_enabled());
 
 	for (const KeyValue<StringName, Variant> &E : current->get_values()) {
 		preset->set(E.key, E.value);
@@ -1674,6 +1691,12 @@ ProjectExportDialog::ProjectExportDialog() {
 	script_mode->add_item(TTR("Compressed binary tokens (smaller files)"), (int)EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED);
 	script_mode->connect(SceneStringName(item_selected), callable_mp(this, &ProjectExportDialog::_script_export_mode_changed));
 
+	script_bytecode_cache = memnew(CheckButton);
+	script_bytecode_cache->connect(SceneStringName(toggled), callable_mp(this, &ProjectExportDialog::_script_bytecode_cache_changed));
+	script_bytecode_cache->set_text(TTR("Cache Compiled Bytecode (faster startup)"));
+	script_bytecode_cache->set_tooltip_text(TTR("Also export the compiled bytecode of each script, so the exported project doesn't have to compile them.\nScripts are still compiled normally if the cache can't be used, for example with a different export template version."));
+	script_vb->add_child(script_bytecode_cache);
+
 	sections->add_child(script_vb);
 
 	sections->connect("tab_changed", callable_mp(this, &ProjectExportDialog::_tab_changed));
@@ -175,6 +175,7 @@ class ProjectExportDialog : public ConfirmationDialog {
 	LineEdit *seed_input = nullptr;
 
 	OptionButton *script_mode = nullptr;
+	CheckButton *script_bytecode_cache = nullptr;
 
 	void _open_export_template_manager();
 
@@ -202,6 +203,7 @@ class ProjectExportDialog : public ConfirmationDialog {
 	bool _validate_script_encryption_key(const String &p_key);
 
 	void _script_export_mode_changed(int p_mode);
+	void _script_bytecode_cache_changed(bool p_pressed);
 
 	void _open_key_help_link();
 
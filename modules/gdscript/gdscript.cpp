@@ -31,10 +31,12 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -814,6 +816,20 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+
+	if (!bytecode_cache.is_empty()) {
+		// The cache is only good for the first compilation, later reloads go through the compiler.
+		Vector<uint8_t> cache = bytecode_cache;
+		bytecode_cache.clear();
+		if (!has_instances && GDScriptBytecodeCache::load(this, cache) == OK) {
+			reloading = false;
+			if (ScriptServer::is_scripting_enabled() || is_tool()) {
+				return _static_init();
+			}
+			return OK;
+		}
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -831,6 +847,10 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
+	// Parse the scripts this one depends on in parallel, instead of one by one as the analyzer reaches them.
+	// They only need to be kept until the analysis is done, the analyzer references the ones it uses.
+	Vector<Ref<GDScriptParserRef>> dependency_parsers = GDScriptCache::parse_dependencies(&parser);
+
 	GDScriptAnalyzer analyzer(&parser);
 	err = analyzer.analyze();
 
@@ -1171,6 +1191,10 @@ Vector<uint8_t> GDScript::get_as_binary_tokens() const {
 	return tokenizer.parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
 }
 
+void GDScript::set_bytecode_cache_source(const Vector<uint8_t> &p_bytecode_cache) {
+	bytecode_cache = p_bytecode_cache;
+}
+
 const HashMap<StringName, GDScriptFunction *> &GDScript::debug_get_member_functions() const {
 	return member_functions;
 }
@@ -1560,6 +1584,11 @@ void GDScript::clear(ClearData *p_clear_data) {
 	}
 	clearing = true;
 
+	if (!destructing) {
+		// Instances may outlive the functions and members cached from this script.
+		GDScriptInlineCache::invalidate_all();
+	}
+
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
 	bool is_root = false;
@@ -2301,6 +2330,12 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+#ifdef DEBUG_ENABLED
+	if (GLOBAL_GET("debug/gdscript/sampling_profiler/enabled") && !Engine::get_singleton()->is_editor_hint()) {
+		GDScriptSamplingProfiler::start(GLOBAL_GET("debug/gdscript/sampling_profiler/interval_usec"));
+	}
+#endif
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2342,6 +2377,25 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	if (GDScriptSamplingProfiler::is_active()) {
+		GDScriptSamplingProfiler::stop();
+		const String output_path = GLOBAL_GET("debug/gdscript/sampling_profiler/output_path");
+		if (GDScriptSamplingProfiler::save(output_path) == OK) {
+			print_line(vformat("GDScript sampling profile saved to \"%s\" (%d samples).", output_path, GDScriptSamplingProfiler::get_sample_count()));
+		}
+		GDScriptSamplingProfiler::clear();
+	}
+
+	if (is_print_verbose_enabled()) {
+		GDScriptInlineCache::Statistics stats = get_inline_cache_statistics();
+		if (stats.hits + stats.misses > 0) {
+			print_line(vformat("GDScript inline caches: %d hits, %d misses (%.1f%% hit rate) in %d sites (%d monomorphic, %d polymorphic, %d megamorphic).",
+					stats.hits, stats.misses, 100.0 * stats.hits / (stats.hits + stats.misses), stats.sites, stats.monomorphic, stats.polymorphic, stats.megamorphic));
+		}
+	}
+#endif
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2499,6 +2553,36 @@ int GDScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_
 	return current;
 }
 
+#ifdef DEBUG_ENABLED
+GDScriptInlineCache::Statistics GDScriptLanguage::get_inline_cache_statistics() {
+	MutexLock lock(mutex);
+
+	GDScriptInlineCache::Statistics stats;
+	SelfList<GDScriptFunction> *elem = function_list.first();
+	while (elem) {
+		const GDScriptFunction *function = elem->self();
+		for (int i = 0; i < function->_inline_cache_count; i++) {
+			function->_inline_caches_ptr[i].accumulate_statistics(stats);
+		}
+		elem = elem->next();
+	}
+	return stats;
+}
+
+void GDScriptLanguage::reset_inline_cache_statistics() {
+	MutexLock lock(mutex);
+
+	SelfList<GDScriptFunction> *elem = function_list.first();
+	while (elem) {
+		GDScriptFunction *function = elem->self();
+		for (int i = 0; i < function->_inline_cache_count; i++) {
+			function->_inline_caches_ptr[i].reset_statistics();
+		}
+		elem = elem->next();
+	}
+}
+#endif
+
 void GDScriptLanguage::profiling_collate_native_call_data(bool p_accumulated) {
 #ifdef DEBUG_ENABLED
 	// The same native call can be called from multiple functions, so join them together here.
@@ -2972,7 +3056,14 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+	superinstruction_call_threshold = GLOBAL_DEF(PropertyInfo(Variant::INT, "gdscript/runtime/superinstruction_call_threshold", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"), 1000);
+	threaded_dependency_parsing = GLOBAL_DEF("gdscript/loading/threaded_dependency_parsing", true);
+
 #ifdef DEBUG_ENABLED
+	GLOBAL_DEF("debug/gdscript/sampling_profiler/enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/gdscript/sampling_profiler/interval_usec", PROPERTY_HINT_RANGE, "50,100000,1,or_greater"), 1000);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "debug/gdscript/sampling_profiler/output_path", PROPERTY_HINT_SAVE_FILE, "*.folded,*.json"), "user://gdscript_profile.folded");
+
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
 	for (int i = 0; i < (int)GDScriptWarning::WARNING_MAX; i++) {
@@ -84,8 +84,10 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
+	friend class GDScriptInlineCache;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
@@ -178,6 +180,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> bytecode_cache; // Compiled state cached on export, consumed by the next reload.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -309,6 +312,8 @@ public:
 	const Vector<uint8_t> &get_binary_tokens_source() const;
 	Vector<uint8_t> get_as_binary_tokens() const;
 
+	void set_bytecode_cache_source(const Vector<uint8_t> &p_bytecode_cache);
+
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
 
 	virtual void get_script_method_list(List<MethodInfo> *p_list) const override;
@@ -350,6 +355,7 @@ public:
 class GDScriptInstance : public ScriptInstance {
 	friend class GDScript;
 	friend class GDScriptFunction;
+	friend class GDScriptInlineCache;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptCompiler;
@@ -449,6 +455,9 @@ class GDScriptLanguage : public ScriptLanguage {
 	static thread_local CallStack _call_stack;
 	int _debug_max_call_stack = 0;
 
+	uint32_t superinstruction_call_threshold = 0;
+	bool threaded_dependency_parsing = true;
+
 	void _add_global(const StringName &p_name, const Variant &p_value);
 	void _remove_global(const StringName &p_name);
 
@@ -550,6 +559,9 @@ public:
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
 	_FORCE_INLINE_ const HashMap<StringName, Variant> &get_named_globals_map() const { return named_globals; }
+	_FORCE_INLINE_ uint32_t get_superinstruction_call_threshold() const { return superinstruction_call_threshold; }
+	_FORCE_INLINE_ bool is_threaded_dependency_parsing_enabled() const { return threaded_dependency_parsing; }
+	void set_threaded_dependency_parsing_enabled(bool p_enabled) { threaded_dependency_parsing = p_enabled; }
 	// These two functions should be used when behavior needs to be consistent between in-editor and running the scene
 	bool has_any_global_constant(const StringName &p_name) { return named_globals.has(p_name) || globals.has(p_name); }
 	Variant get_any_global_constant(const StringName &p_name);
@@ -624,6 +636,12 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) override;
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) override;
 
+#ifdef DEBUG_ENABLED
+	// Aggregated over the inline caches of every loaded function.
+	GDScriptInlineCache::Statistics get_inline_cache_statistics();
+	void reset_inline_cache_statistics();
+#endif
+
 	/* LOADER FUNCTIONS */
 
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
@@ -226,6 +226,13 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_code_ptr = &function->code.write[0];
 		function->_code_size = opcodes.size();
 
+		uint32_t superinstruction_call_threshold = GDScriptLanguage::get_singleton()->get_superinstruction_call_threshold();
+		if (superinstruction_call_threshold > 0 && !superinstruction_candidates.is_empty()) {
+			function->superinstruction_candidates = superinstruction_candidates;
+			function->superinstruction_call_threshold = superinstruction_call_threshold;
+			function->superinstructions_pending = true;
+		}
+
 	} else {
 		function->_code_ptr = nullptr;
 		function->_code_size = 0;
@@ -395,6 +402,11 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_cache_count = inline_cache_count;
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, inline_cache_count);
+	}
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
@@ -564,6 +576,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		append(Address());
 		append(p_target);
 		append(op_func);
+		last_operator_validated_end = opcodes.size();
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -571,6 +584,9 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 
 	// No specific types, perform variant evaluation.
+#ifdef TOOLS_ENABLED
+	function->untyped_operator_positions.push_back(opcodes.size());
+#endif
 	append_opcode(GDScriptFunction::OPCODE_OPERATOR);
 	append(p_left_operand);
 	append(Address());
@@ -620,6 +636,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		append(p_right_operand);
 		append(p_target);
 		append(op_func);
+		last_operator_validated_end = opcodes.size();
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -627,6 +644,9 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	}
 
 	// No specific types, perform variant evaluation.
+#ifdef TOOLS_ENABLED
+	function->untyped_operator_positions.push_back(opcodes.size());
+#endif
 	append_opcode(GDScriptFunction::OPCODE_OPERATOR);
 	append(p_left_operand);
 	append(p_right_operand);
@@ -861,6 +881,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append(inline_cache_count++);
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -879,6 +900,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append(inline_cache_count++);
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1028,6 +1050,9 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+#ifdef TOOLS_ENABLED
+	function->global_index_positions.push_back(opcodes.size());
+#endif
 	append(p_global_index);
 }
 
@@ -1093,6 +1118,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1118,6 +1144,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1352,6 +1379,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1365,6 +1393,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1378,6 +1407,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1864,6 +1894,9 @@ void GDScriptByteCodeGenerator::write_return(const Address &p_return_value) {
 }
 
 void GDScriptByteCodeGenerator::write_assert(const Address &p_test, const Address &p_message) {
+#ifdef TOOLS_ENABLED
+	function->has_assert = true;
+#endif
 	append_opcode(GDScriptFunction::OPCODE_ASSERT);
 	append(p_test);
 	append(p_message);
@@ -99,6 +99,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int current_line = 0;
 	int instr_args_max = 0;
 
+	// End of the last validated operator, to find instructions that can be fused with it.
+	int last_operator_validated_end = -1;
+	Vector<int> superinstruction_candidates;
+
+	int inline_cache_count = 0;
+
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
 #endif
@@ -374,6 +380,18 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 	void append_opcode(GDScriptFunction::Opcode p_code) {
+		if (opcodes.size() == last_operator_validated_end) {
+			switch (p_code) {
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+				case GDScriptFunction::OPCODE_JUMP_IF:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+				case GDScriptFunction::OPCODE_ASSIGN:
+					superinstruction_candidates.push_back(opcodes.size() - 5);
+					break;
+				default:
+					break;
+			}
+		}
 		opcodes.push_back(p_code);
 	}
 
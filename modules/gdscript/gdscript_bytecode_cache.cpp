@@ -0,0 +1,1879 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_tokenizer_buffer.h"
+#include "gdscript_utility_functions.h"
+
+#ifdef TOOLS_ENABLED
+#include "gdscript_parser.h"
+#endif
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+static constexpr int MAX_NESTING_DEPTH = 64;
+static const uint8_t CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+
+struct GDScriptBytecodeCache::Writer {
+	Vector<uint8_t> buffer;
+	uint32_t flags = 0;
+	String error;
+	HashSet<const GDScript *> script_refs; // Classes of other files referenced by what was written.
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	bool has_failed() const {
+		return !error.is_empty();
+	}
+
+	void put_bytes(const uint8_t *p_data, int p_size) {
+		int pos = buffer.size();
+		buffer.resize(pos + p_size);
+		memcpy(buffer.ptrw() + pos, p_data, p_size);
+	}
+
+	void put_u8(uint8_t p_value) {
+		buffer.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		uint8_t bytes[4];
+		encode_uint32(p_value, bytes);
+		put_bytes(bytes, 4);
+	}
+
+	void put_i32(int32_t p_value) {
+		put_u32((uint32_t)p_value);
+	}
+
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	void put_ints(const Vector<int> &p_ints) {
+		put_u32(p_ints.size());
+		for (int value : p_ints) {
+			put_i32(value);
+		}
+	}
+
+	void put_variant(const Variant &p_value) {
+		int len = 0;
+		Error err = encode_variant(p_value, nullptr, len);
+		if (err != OK) {
+			fail(vformat(R"(Value of type "%s" can't be encoded.)", Variant::get_type_name(p_value.get_type())));
+			return;
+		}
+		put_u32(len);
+		int pos = buffer.size();
+		buffer.resize(pos + len);
+		encode_variant(p_value, buffer.ptrw() + pos, len);
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	bool failed = false;
+
+	bool has(int p_bytes) {
+		if (failed || p_bytes < 0 || p_bytes > size - pos) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (!has(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(data + pos);
+		pos += 4;
+		return value;
+	}
+
+	int32_t get_i32() {
+		return (int32_t)get_u32();
+	}
+
+	// Counts are checked against the remaining data, so a damaged cache fails instead of allocating huge buffers.
+	uint32_t get_count(int p_min_element_size = 1) {
+		uint32_t count = get_u32();
+		if (!failed && (uint64_t)count * p_min_element_size > (uint64_t)(size - pos)) {
+			failed = true;
+		}
+		return failed ? 0 : count;
+	}
+
+	String get_string() {
+		uint32_t len = get_count();
+		if (failed || len == 0) {
+			return String();
+		}
+		String string;
+		if (string.parse_utf8((const char *)data + pos, len) != OK) {
+			failed = true;
+		}
+		pos += len;
+		return string;
+	}
+
+	StringName get_string_name() {
+		return StringName(get_string());
+	}
+
+	Vector<int> get_ints() {
+		Vector<int> ints;
+		uint32_t count = get_count(4);
+		ints.resize(count);
+		int *ptr = ints.ptrw();
+		for (uint32_t i = 0; i < count; i++) {
+			ptr[i] = get_i32();
+		}
+		return ints;
+	}
+
+	Variant get_variant() {
+		uint32_t len = get_count();
+		if (failed) {
+			return Variant();
+		}
+		Variant value;
+		if (decode_variant(value, data + pos, len) != OK) {
+			failed = true;
+			return Variant();
+		}
+		pos += len;
+		return value;
+	}
+
+	Reader(const Vector<uint8_t> &p_buffer) :
+			data(p_buffer.ptr()), size(p_buffer.size()) {}
+};
+
+struct GDScriptBytecodeCache::ClassTree {
+	StringName local_name;
+	StringName global_name;
+	String fully_qualified_name;
+	String simplified_icon_path;
+	Vector<ClassTree> subclasses;
+};
+
+struct GDScriptBytecodeCache::FunctionData {
+	StringName name;
+	bool is_static = false;
+	int initial_line = 0;
+	int argument_count = 0;
+	int stack_size = 0;
+	int instruction_args_size = 0;
+	Variant rpc_config;
+	GDScriptDataType return_type;
+	Vector<GDScriptDataType> argument_types;
+	MethodInfo method_info;
+	HashMap<int, Variant::Type> temporary_slots;
+	Vector<int> default_arguments;
+	Vector<int> code;
+	Vector<Variant> constants;
+	Vector<StringName> global_names;
+	Vector<Variant::ValidatedOperatorEvaluator> operator_funcs;
+	Vector<Variant::ValidatedSetter> setters;
+	Vector<Variant::ValidatedGetter> getters;
+	Vector<Variant::ValidatedKeyedSetter> keyed_setters;
+	Vector<Variant::ValidatedKeyedGetter> keyed_getters;
+	Vector<Variant::ValidatedIndexedSetter> indexed_setters;
+	Vector<Variant::ValidatedIndexedGetter> indexed_getters;
+	Vector<Variant::ValidatedBuiltInMethod> builtin_methods;
+	Vector<Variant::ValidatedConstructor> constructors;
+	Vector<Variant::ValidatedUtilityFunction> utilities;
+	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
+	Vector<MethodBind *> methods;
+	Vector<int> superinstruction_candidates;
+	uint32_t inline_cache_count = 0;
+	Vector<int> lambdas; // Indices into `ClassData::lambdas`.
+
+	// Names of the native symbols, used by the disassembler.
+	Vector<String> operator_names;
+	Vector<String> setter_names;
+	Vector<String> getter_names;
+	Vector<String> builtin_methods_names;
+	Vector<String> constructors_names;
+	Vector<String> utilities_names;
+	Vector<String> gds_utilities_names;
+};
+
+struct GDScriptBytecodeCache::LambdaData {
+	int capture_count = 0;
+	bool use_self = false;
+	FunctionData function;
+};
+
+struct GDScriptBytecodeCache::ClassData {
+	GDScript *script = nullptr;
+	bool tool = false;
+	Ref<GDScriptNativeClass> native;
+	Ref<GDScript> base;
+	LocalVector<Pair<StringName, GDScript::MemberInfo>> member_indices;
+	LocalVector<StringName> members;
+	LocalVector<Pair<StringName, GDScript::MemberInfo>> static_variables_indices;
+	LocalVector<Pair<StringName, Variant>> constants;
+	LocalVector<Pair<StringName, MethodInfo>> signals;
+	Dictionary rpc_config;
+	LocalVector<Pair<FunctionRole, FunctionData>> functions;
+	LocalVector<LambdaData> lambdas;
+};
+
+struct GDScriptBytecodeCache::LoadContext {
+	GDScript *root = nullptr;
+	LocalVector<ClassData> classes;
+	Error error = OK;
+
+	// Records why something in the cache couldn't be used in this process, as opposed to the data being damaged.
+	bool fail(Error p_error) {
+		if (error == OK) {
+			error = p_error;
+		}
+		return false;
+	}
+};
+
+uint32_t GDScriptBytecodeCache::_get_build_signature() {
+	// Things the bytecode depends on that aren't covered by the engine version, like custom builds.
+	uint32_t hash = hash_murmur3_one_32(sizeof(void *));
+	hash = hash_murmur3_one_32(sizeof(real_t), hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	return hash_fmix32(hash);
+}
+
+uint32_t GDScriptBytecodeCache::_get_method_signature(const MethodBind *p_method) {
+	uint32_t hash = hash_murmur3_one_32(p_method->get_argument_count());
+	for (int i = -1; i < p_method->get_argument_count(); i++) {
+		hash = hash_murmur3_one_32(p_method->get_argument_type(i), hash);
+	}
+	hash = hash_murmur3_one_32(p_method->is_vararg() | (p_method->is_static() << 1) | (p_method->is_const() << 2), hash);
+	return hash_fmix32(hash);
+}
+
+// Scripts loaded from source (not exported) are tokenized like the export would.
+uint32_t GDScriptBytecodeCache::_get_dependency_hash(const GDScript *p_script, bool p_compressed) {
+	const Vector<uint8_t> &binary_tokens = p_script->get_binary_tokens_source();
+	if (!binary_tokens.is_empty()) {
+		return hash_djb2_buffer(binary_tokens.ptr(), binary_tokens.size());
+	}
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(p_script->get_source_code(), p_compressed ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE);
+	return hash_djb2_buffer(tokens.ptr(), tokens.size());
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_binary_tokens_path) {
+	return p_binary_tokens_path.get_basename() + ".gdbc";
+}
+
+bool GDScriptBytecodeCache::_read_header(Reader &p_reader, const Vector<uint8_t> &p_binary_tokens, uint32_t &r_flags) {
+	if (!p_reader.has(4) || memcmp(p_reader.data, CACHE_MAGIC, 4) != 0) {
+		return false;
+	}
+	p_reader.pos += 4;
+
+	if (p_reader.get_u32() != FORMAT_VERSION) {
+		return false;
+	}
+	if (p_reader.get_string() != VERSION_FULL_CONFIG || p_reader.get_string() != VERSION_HASH) {
+		return false;
+	}
+	if (p_reader.get_u32() != _get_build_signature()) {
+		return false;
+	}
+	if (p_binary_tokens.is_empty() || p_reader.get_u32() != hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size())) {
+		return false;
+	}
+	uint32_t body_hash = p_reader.get_u32();
+	r_flags = p_reader.get_u32();
+	if (p_reader.failed) {
+		return false;
+	}
+	return body_hash == hash_djb2_buffer(p_reader.data + p_reader.pos, p_reader.size - p_reader.pos);
+}
+
+Error GDScriptBytecodeCache::_check_dependencies(Reader &p_reader, const GDScript *p_script) {
+	// Tokens are compressed as a whole export, so dependencies are hashed the same way as this script.
+	const Vector<uint8_t> &binary_tokens = p_script->get_binary_tokens_source();
+	const bool compressed = binary_tokens.size() >= 12 && decode_uint32(binary_tokens.ptr() + 8) != 0;
+
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		String path = p_reader.get_string();
+		uint32_t hash = p_reader.get_u32();
+		if (p_reader.failed) {
+			return ERR_FILE_CORRUPT;
+		}
+
+		Error err = OK;
+		Ref<GDScript> dependency = GDScriptCache::get_shallow_script(path, err, p_script->path);
+		if (err != OK || dependency.is_null()) {
+			return ERR_CANT_RESOLVE;
+		}
+		if (_get_dependency_hash(dependency.ptr(), compressed) != hash) {
+			return ERR_FILE_UNRECOGNIZED;
+		}
+	}
+	return OK;
+}
+
+bool GDScriptBytecodeCache::_read_class_tree(Reader &p_reader, ClassTree &r_tree, int p_depth) {
+	if (p_depth > MAX_NESTING_DEPTH) {
+		return false;
+	}
+	r_tree.local_name = p_reader.get_string_name();
+	r_tree.global_name = p_reader.get_string_name();
+	r_tree.fully_qualified_name = p_reader.get_string();
+	r_tree.simplified_icon_path = p_reader.get_string();
+
+	uint32_t count = p_reader.get_count();
+	r_tree.subclasses.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_read_class_tree(p_reader, r_tree.subclasses.write[i], p_depth + 1) || r_tree.subclasses[i].local_name == StringName()) {
+			return false;
+		}
+	}
+	return !p_reader.failed;
+}
+
+void GDScriptBytecodeCache::_make_scripts(GDScript *p_script, const ClassTree &p_tree) {
+	p_script->fully_qualified_name = p_tree.fully_qualified_name;
+	p_script->local_name = p_tree.local_name;
+	p_script->global_name = p_tree.global_name;
+	p_script->simplified_icon_path = p_tree.simplified_icon_path;
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	for (const ClassTree &subtree : p_tree.subclasses) {
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(subtree.local_name)) {
+			subclass = old_subclasses[subtree.local_name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(subtree.fully_qualified_name);
+		}
+
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(subtree.local_name, subclass);
+
+		_make_scripts(subclass.ptr(), subtree);
+	}
+}
+
+bool GDScriptBytecodeCache::_read_script_ref(Reader &p_reader, LoadContext &p_context, Ref<Script> &r_script) {
+	r_script = Ref<Script>();
+
+	switch (p_reader.get_u8()) {
+		case SCRIPT_REF_NONE: {
+			return !p_reader.failed;
+		}
+		case SCRIPT_REF_GDSCRIPT: {
+			String path = p_reader.get_string();
+			uint32_t depth = p_reader.get_count();
+			Vector<StringName> class_names;
+			for (uint32_t i = 0; i < depth; i++) {
+				class_names.push_back(p_reader.get_string_name());
+			}
+			if (p_reader.failed) {
+				return false;
+			}
+
+			Ref<GDScript> script;
+			if (path.is_empty()) {
+				script = Ref<GDScript>(p_context.root);
+			} else {
+				Error err = OK;
+				script = GDScriptCache::get_shallow_script(path, err, p_context.root->path);
+				if (err != OK || script.is_null()) {
+					return p_context.fail(ERR_CANT_RESOLVE);
+				}
+			}
+
+			for (const StringName &class_name : class_names) {
+				const Ref<GDScript> *subclass = script->subclasses.getptr(class_name);
+				if (subclass == nullptr) {
+					return p_context.fail(ERR_CANT_RESOLVE);
+				}
+				script = *subclass;
+			}
+
+			r_script = script;
+			return true;
+		}
+		case SCRIPT_REF_RESOURCE: {
+			String path = p_reader.get_string();
+			if (p_reader.failed) {
+				return false;
+			}
+			r_script = ResourceLoader::load(path, "Script");
+			return r_script.is_valid() || p_context.fail(ERR_CANT_RESOLVE);
+		}
+	}
+
+	return false;
+}
+
+bool GDScriptBytecodeCache::_read_value(Reader &p_reader, LoadContext &p_context, Variant &r_value, int p_depth) {
+	if (p_depth > MAX_NESTING_DEPTH) {
+		return false;
+	}
+
+	switch (p_reader.get_u8()) {
+		case VALUE_PLAIN: {
+			r_value = p_reader.get_variant();
+			return !p_reader.failed;
+		}
+		case VALUE_ARRAY: {
+			uint32_t builtin_type = p_reader.get_u32();
+			StringName class_name = p_reader.get_string_name();
+			Ref<Script> script;
+			if (!_read_script_ref(p_reader, p_context, script)) {
+				return false;
+			}
+			bool read_only = p_reader.get_u8();
+			uint32_t count = p_reader.get_count();
+			if (p_reader.failed || builtin_type >= Variant::VARIANT_MAX) {
+				return false;
+			}
+
+			Array array;
+			if (builtin_type != Variant::NIL) {
+				array.set_typed(builtin_type, class_name, script);
+			}
+			for (uint32_t i = 0; i < count; i++) {
+				Variant element;
+				if (!_read_value(p_reader, p_context, element, p_depth + 1)) {
+					return false;
+				}
+				array.push_back(element);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			r_value = array;
+			return true;
+		}
+		case VALUE_DICTIONARY: {
+			uint32_t key_type = p_reader.get_u32();
+			StringName key_class_name = p_reader.get_string_name();
+			Ref<Script> key_script;
+			if (!_read_script_ref(p_reader, p_context, key_script)) {
+				return false;
+			}
+			uint32_t value_type = p_reader.get_u32();
+			StringName value_class_name = p_reader.get_string_name();
+			Ref<Script> value_script;
+			if (!_read_script_ref(p_reader, p_context, value_script)) {
+				return false;
+			}
+			bool read_only = p_reader.get_u8();
+			uint32_t count = p_reader.get_count();
+			if (p_reader.failed || key_type >= Variant::VARIANT_MAX || value_type >= Variant::VARIANT_MAX) {
+				return false;
+			}
+
+			Dictionary dictionary;
+			if (key_type != Variant::NIL || value_type != Variant::NIL) {
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			for (uint32_t i = 0; i < count; i++) {
+				Variant key;
+				Variant value;
+				if (!_read_value(p_reader, p_context, key, p_depth + 1) || !_read_value(p_reader, p_context, value, p_depth + 1)) {
+					return false;
+				}
+				dictionary[key] = value;
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			r_value = dictionary;
+			return true;
+		}
+		case VALUE_NULL_OBJECT: {
+			r_value = (Object *)nullptr;
+			return !p_reader.failed;
+		}
+		case VALUE_SCRIPT: {
+			Ref<Script> script;
+			if (!_read_script_ref(p_reader, p_context, script) || script.is_null()) {
+				return false;
+			}
+			r_value = script;
+			return true;
+		}
+		case VALUE_RESOURCE: {
+			String path = p_reader.get_string();
+			String type = p_reader.get_string();
+			if (p_reader.failed) {
+				return false;
+			}
+			Ref<Resource> resource = ResourceLoader::load(path, type);
+			if (resource.is_null()) {
+				return p_context.fail(ERR_CANT_RESOLVE);
+			}
+			r_value = resource;
+			return true;
+		}
+		case VALUE_GLOBAL: {
+			StringName name = p_reader.get_string_name();
+			if (p_reader.failed) {
+				return false;
+			}
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+			if (index == nullptr) {
+				return p_context.fail(ERR_CANT_RESOLVE);
+			}
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[*index];
+			return r_value.get_type() == Variant::OBJECT || p_context.fail(ERR_CANT_RESOLVE);
+		}
+	}
+
+	return false;
+}
+
+bool GDScriptBytecodeCache::_read_data_type(Reader &p_reader, LoadContext &p_context, GDScriptDataType &r_type, int p_depth) {
+	if (p_depth > MAX_NESTING_DEPTH) {
+		return false;
+	}
+
+	r_type.has_type = p_reader.get_u8();
+	uint8_t kind = p_reader.get_u8();
+	uint32_t builtin_type = p_reader.get_u32();
+	r_type.native_type = p_reader.get_string_name();
+	if (p_reader.failed || kind > GDScriptDataType::GDSCRIPT || builtin_type >= Variant::VARIANT_MAX) {
+		return false;
+	}
+	r_type.kind = (GDScriptDataType::Kind)kind;
+	r_type.builtin_type = (Variant::Type)builtin_type;
+
+	Ref<Script> script;
+	if (!_read_script_ref(p_reader, p_context, script)) {
+		return false;
+	}
+	r_type.script_type = script.ptr();
+	// Classes of the same file only keep a plain pointer to avoid reference cycles.
+	if (p_reader.get_u8()) {
+		r_type.script_type_ref = script;
+	}
+
+	uint32_t count = p_reader.get_count();
+	r_type.container_element_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_read_data_type(p_reader, p_context, r_type.container_element_types.write[i], p_depth + 1)) {
+			return false;
+		}
+	}
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_property_info(Reader &p_reader, PropertyInfo &r_info) {
+	uint32_t type = p_reader.get_u32();
+	r_info.name = p_reader.get_string();
+	r_info.class_name = p_reader.get_string_name();
+	r_info.hint = (PropertyHint)p_reader.get_u32();
+	r_info.hint_string = p_reader.get_string();
+	r_info.usage = p_reader.get_u32();
+	if (p_reader.failed || type >= Variant::VARIANT_MAX) {
+		return false;
+	}
+	r_info.type = (Variant::Type)type;
+	return true;
+}
+
+bool GDScriptBytecodeCache::_read_method_info(Reader &p_reader, LoadContext &p_context, MethodInfo &r_info) {
+	r_info.name = p_reader.get_string();
+	if (!_read_property_info(p_reader, r_info.return_val)) {
+		return false;
+	}
+	r_info.flags = p_reader.get_u32();
+	r_info.id = p_reader.get_i32();
+
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		PropertyInfo argument;
+		if (!_read_property_info(p_reader, argument)) {
+			return false;
+		}
+		r_info.arguments.push_back(argument);
+	}
+
+	count = p_reader.get_count();
+	r_info.default_arguments.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_read_value(p_reader, p_context, r_info.default_arguments.write[i])) {
+			return false;
+		}
+	}
+
+	r_info.return_val_metadata = p_reader.get_i32();
+	r_info.arguments_metadata = p_reader.get_ints();
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_member_info(Reader &p_reader, LoadContext &p_context, StringName &r_name, GDScript::MemberInfo &r_info) {
+	r_name = p_reader.get_string_name();
+	r_info.index = p_reader.get_i32();
+	r_info.setter = p_reader.get_string_name();
+	r_info.getter = p_reader.get_string_name();
+	if (!_read_data_type(p_reader, p_context, r_info.data_type)) {
+		return false;
+	}
+	return _read_property_info(p_reader, r_info.property_info);
+}
+
+bool GDScriptBytecodeCache::_read_function(Reader &p_reader, LoadContext &p_context, ClassData &p_class, FunctionData &r_function, int p_depth) {
+	if (p_depth > MAX_NESTING_DEPTH) {
+		return false;
+	}
+
+	r_function.name = p_reader.get_string_name();
+	r_function.is_static = p_reader.get_u8();
+	r_function.initial_line = p_reader.get_i32();
+	r_function.argument_count = p_reader.get_i32();
+	r_function.stack_size = p_reader.get_i32();
+	r_function.instruction_args_size = p_reader.get_i32();
+	if (!_read_value(p_reader, p_context, r_function.rpc_config)) {
+		return false;
+	}
+	if (!_read_data_type(p_reader, p_context, r_function.return_type)) {
+		return false;
+	}
+
+	uint32_t count = p_reader.get_count();
+	r_function.argument_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_read_data_type(p_reader, p_context, r_function.argument_types.write[i])) {
+			return false;
+		}
+	}
+
+	if (!_read_method_info(p_reader, p_context, r_function.method_info)) {
+		return false;
+	}
+
+	count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < count; i++) {
+		int slot = p_reader.get_i32();
+		uint32_t type = p_reader.get_u32();
+		if (type >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		r_function.temporary_slots[slot] = (Variant::Type)type;
+	}
+
+	r_function.default_arguments = p_reader.get_ints();
+
+	// Global indices are stored by name, since the global array is laid out differently in each process.
+	Vector<Pair<int, StringName>> global_relocations;
+	count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < count; i++) {
+		int position = p_reader.get_i32();
+		global_relocations.push_back(Pair<int, StringName>(position, p_reader.get_string_name()));
+	}
+
+	r_function.code = p_reader.get_ints();
+	if (p_reader.failed) {
+		return false;
+	}
+
+	const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	int *code_ptr = r_function.code.ptrw();
+	for (const Pair<int, StringName> &relocation : global_relocations) {
+		if (relocation.first < 0 || relocation.first >= r_function.code.size()) {
+			return false;
+		}
+		const int *global_index = global_map.getptr(relocation.second);
+		if (global_index == nullptr) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		code_ptr[relocation.first] = *global_index;
+	}
+
+	count = p_reader.get_count();
+	r_function.constants.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_read_value(p_reader, p_context, r_function.constants.write[i])) {
+			return false;
+		}
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		r_function.global_names.push_back(p_reader.get_string_name());
+	}
+
+	// Native symbols are looked up again by name, so their addresses are the ones of this process.
+
+	count = p_reader.get_count(12);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t op = p_reader.get_u32();
+		uint32_t type_a = p_reader.get_u32();
+		uint32_t type_b = p_reader.get_u32();
+		if (op >= Variant::OP_MAX || type_a >= Variant::VARIANT_MAX || type_b >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)type_a, (Variant::Type)type_b);
+		if (evaluator == nullptr) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		r_function.operator_funcs.push_back(evaluator);
+		r_function.operator_names.push_back(Variant::get_operator_name((Variant::Operator)op));
+	}
+
+	count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t type = p_reader.get_u32();
+		StringName member = p_reader.get_string_name();
+		if (type >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		Variant::ValidatedSetter setter = Variant::get_member_validated_setter((Variant::Type)type, member);
+		if (setter == nullptr) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		r_function.setters.push_back(setter);
+		r_function.setter_names.push_back(member);
+	}
+
+	count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t type = p_reader.get_u32();
+		StringName member = p_reader.get_string_name();
+		if (type >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		Variant::ValidatedGetter getter = Variant::get_member_validated_getter((Variant::Type)type, member);
+		if (getter == nullptr) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		r_function.getters.push_back(getter);
+		r_function.getter_names.push_back(member);
+	}
+
+	count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t type = p_reader.get_u32();
+		if (type >= Variant::VARIANT_MAX || Variant::get_member_validated_keyed_setter((Variant::Type)type) == nullptr) {
+			return false;
+		}
+		r_function.keyed_setters.push_back(Variant::get_member_validated_keyed_setter((Variant::Type)type));
+	}
+
+	count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t type = p_reader.get_u32();
+		if (type >= Variant::VARIANT_MAX || Variant::get_member_validated_keyed_getter((Variant::Type)type) == nullptr) {
+			return false;
+		}
+		r_function.keyed_getters.push_back(Variant::get_member_validated_keyed_getter((Variant::Type)type));
+	}
+
+	count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t type = p_reader.get_u32();
+		if (type >= Variant::VARIANT_MAX || Variant::get_member_validated_indexed_setter((Variant::Type)type) == nullptr) {
+			return false;
+		}
+		r_function.indexed_setters.push_back(Variant::get_member_validated_indexed_setter((Variant::Type)type));
+	}
+
+	count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t type = p_reader.get_u32();
+		if (type >= Variant::VARIANT_MAX || Variant::get_member_validated_indexed_getter((Variant::Type)type) == nullptr) {
+			return false;
+		}
+		r_function.indexed_getters.push_back(Variant::get_member_validated_indexed_getter((Variant::Type)type));
+	}
+
+	count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t type = p_reader.get_u32();
+		StringName method = p_reader.get_string_name();
+		if (type >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		if (!Variant::has_builtin_method((Variant::Type)type, method)) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		r_function.builtin_methods.push_back(Variant::get_validated_builtin_method((Variant::Type)type, method));
+		r_function.builtin_methods_names.push_back(method);
+	}
+
+	count = p_reader.get_count(8);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t type = p_reader.get_u32();
+		int index = p_reader.get_i32();
+		if (type >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		if (index < 0 || index >= Variant::get_constructor_count((Variant::Type)type)) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		r_function.constructors.push_back(Variant::get_validated_constructor((Variant::Type)type, index));
+		r_function.constructors_names.push_back(Variant::get_type_name((Variant::Type)type));
+	}
+
+	count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < count; i++) {
+		StringName utility = p_reader.get_string_name();
+		if (!Variant::has_utility_function(utility)) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		r_function.utilities.push_back(Variant::get_validated_utility_function(utility));
+		r_function.utilities_names.push_back(utility);
+	}
+
+	count = p_reader.get_count(4);
+	for (uint32_t i = 0; i < count; i++) {
+		StringName utility = p_reader.get_string_name();
+		if (!GDScriptUtilityFunctions::function_exists(utility)) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		r_function.gds_utilities.push_back(GDScriptUtilityFunctions::get_function(utility));
+		r_function.gds_utilities_names.push_back(utility);
+	}
+
+	count = p_reader.get_count(12);
+	for (uint32_t i = 0; i < count; i++) {
+		StringName class_name = p_reader.get_string_name();
+		StringName method_name = p_reader.get_string_name();
+		uint32_t signature = p_reader.get_u32();
+		if (p_reader.failed) {
+			return false;
+		}
+		// The bytecode was generated for a specific signature, so a method that changed since can't be called with it.
+		MethodBind *method = ClassDB::get_method(class_name, method_name);
+		if (method == nullptr || method->get_instance_class() != class_name || _get_method_signature(method) != signature) {
+			return p_context.fail(ERR_CANT_RESOLVE);
+		}
+		r_function.methods.push_back(method);
+	}
+
+	r_function.superinstruction_candidates = p_reader.get_ints();
+	r_function.inline_cache_count = p_reader.get_u32();
+	if (r_function.inline_cache_count > (uint32_t)r_function.code.size()) {
+		return false; // Every cache is indexed by its own instruction.
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		LambdaData lambda;
+		lambda.capture_count = p_reader.get_i32();
+		lambda.use_self = p_reader.get_u8();
+		if (!_read_function(p_reader, p_context, p_class, lambda.function, p_depth + 1)) {
+			return false;
+		}
+		p_class.lambdas.push_back(lambda);
+		r_function.lambdas.push_back(p_class.lambdas.size() - 1);
+	}
+
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_class(Reader &p_reader, LoadContext &p_context, GDScript *p_script, const ClassTree &p_tree) {
+	ClassData data;
+	data.script = p_script;
+	data.tool = p_reader.get_u8();
+
+	StringName native_name = p_reader.get_string_name();
+	if (p_reader.failed) {
+		return false;
+	}
+	const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_name);
+	if (native_index != nullptr) {
+		data.native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+	}
+	if (data.native.is_null()) {
+		return p_context.fail(ERR_CANT_RESOLVE);
+	}
+
+	Ref<Script> base;
+	if (!_read_script_ref(p_reader, p_context, base)) {
+		return false;
+	}
+	data.base = base;
+	if (base.is_valid() && data.base.is_null()) {
+		return false;
+	}
+
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		Pair<StringName, GDScript::MemberInfo> member;
+		if (!_read_member_info(p_reader, p_context, member.first, member.second)) {
+			return false;
+		}
+		data.member_indices.push_back(member);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		data.members.push_back(p_reader.get_string_name());
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		Pair<StringName, GDScript::MemberInfo> member;
+		if (!_read_member_info(p_reader, p_context, member.first, member.second)) {
+			return false;
+		}
+		data.static_variables_indices.push_back(member);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		Pair<StringName, Variant> constant;
+		constant.first = p_reader.get_string_name();
+		if (!_read_value(p_reader, p_context, constant.second)) {
+			return false;
+		}
+		data.constants.push_back(constant);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		Pair<StringName, MethodInfo> signal;
+		signal.first = p_reader.get_string_name();
+		if (!_read_method_info(p_reader, p_context, signal.second)) {
+			return false;
+		}
+		data.signals.push_back(signal);
+	}
+
+	Variant rpc_config;
+	if (!_read_value(p_reader, p_context, rpc_config) || rpc_config.get_type() != Variant::DICTIONARY) {
+		return false;
+	}
+	data.rpc_config = rpc_config;
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count; i++) {
+		uint8_t role = p_reader.get_u8();
+		if (role > FUNCTION_STATIC_INITIALIZER) {
+			return false;
+		}
+		Pair<FunctionRole, FunctionData> function;
+		function.first = (FunctionRole)role;
+		if (!_read_function(p_reader, p_context, data, function.second)) {
+			return false;
+		}
+		data.functions.push_back(function);
+	}
+
+	p_context.classes.push_back(data);
+
+	for (const ClassTree &subtree : p_tree.subclasses) {
+		const Ref<GDScript> *subclass = p_script->subclasses.getptr(subtree.local_name);
+		if (subclass == nullptr || !_read_class(p_reader, p_context, subclass->ptr(), subtree)) {
+			return false;
+		}
+	}
+
+	return !p_reader.failed;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_create_function(GDScript *p_script, const ClassData &p_class, const FunctionData &p_function) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->name = p_function.name;
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(p_function.name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	function->_static = p_function.is_static;
+	function->return_type = p_function.return_type;
+	function->rpc_config = p_function.rpc_config;
+	function->argument_types = p_function.argument_types;
+	function->method_info = p_function.method_info;
+	function->_initial_line = p_function.initial_line;
+	function->_argument_count = p_function.argument_count;
+	function->_stack_size = p_function.stack_size;
+	function->_instruction_args_size = p_function.instruction_args_size;
+	function->temporary_slots = p_function.temporary_slots;
+
+	// Set up the same way as `GDScriptByteCodeGenerator::write_end()` does.
+
+	function->code = p_function.code;
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->_code_size ? function->code.ptrw() : nullptr;
+
+	uint32_t superinstruction_call_threshold = GDScriptLanguage::get_singleton()->get_superinstruction_call_threshold();
+	if (superinstruction_call_threshold > 0 && !p_function.superinstruction_candidates.is_empty()) {
+		function->superinstruction_candidates = p_function.superinstruction_candidates;
+		function->superinstruction_call_threshold = superinstruction_call_threshold;
+		function->superinstructions_pending = true;
+	}
+
+	function->default_arguments = p_function.default_arguments;
+	function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+
+	function->constants = p_function.constants;
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+
+	function->global_names = p_function.global_names;
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+
+#define SET_TABLE(m_table)                                                                         \
+	function->m_table = p_function.m_table;                                                        \
+	function->_##m_table##_count = function->m_table.size();                                       \
+	function->_##m_table##_ptr = function->m_table.is_empty() ? nullptr : function->m_table.ptr();
+
+	SET_TABLE(operator_funcs);
+	SET_TABLE(setters);
+	SET_TABLE(getters);
+	SET_TABLE(keyed_setters);
+	SET_TABLE(keyed_getters);
+	SET_TABLE(indexed_setters);
+	SET_TABLE(indexed_getters);
+	SET_TABLE(builtin_methods);
+	SET_TABLE(constructors);
+	SET_TABLE(utilities);
+	SET_TABLE(gds_utilities);
+
+#undef SET_TABLE
+
+	function->methods = p_function.methods;
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+
+	if (p_function.inline_cache_count) {
+		function->_inline_cache_count = p_function.inline_cache_count;
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, p_function.inline_cache_count);
+	}
+
+	for (int lambda_index : p_function.lambdas) {
+		const LambdaData &lambda = p_class.lambdas[lambda_index];
+		GDScriptFunction *lambda_function = _create_function(p_script, p_class, lambda.function);
+		function->lambdas.push_back(lambda_function);
+		p_script->lambda_info.insert(lambda_function, { lambda.capture_count, lambda.use_self });
+	}
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+
+#ifdef DEBUG_ENABLED
+	function->operator_names = p_function.operator_names;
+	function->setter_names = p_function.setter_names;
+	function->getter_names = p_function.getter_names;
+	function->builtin_methods_names = p_function.builtin_methods_names;
+	function->constructors_names = p_function.constructors_names;
+	function->utilities_names = p_function.utilities_names;
+	function->gds_utilities_names = p_function.gds_utilities_names;
+#endif
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_commit_class(const ClassData &p_class) {
+	GDScript *script = p_class.script;
+
+	script->tool = p_class.tool;
+	script->native = p_class.native;
+	script->base = p_class.base;
+	script->_base = p_class.base.ptr();
+
+	for (const Pair<StringName, GDScript::MemberInfo> &E : p_class.member_indices) {
+		script->member_indices.insert(E.first, E.second);
+	}
+	for (const StringName &E : p_class.members) {
+		script->members.insert(E);
+	}
+	for (const Pair<StringName, GDScript::MemberInfo> &E : p_class.static_variables_indices) {
+		script->static_variables_indices.insert(E.first, E.second);
+	}
+	script->static_variables.resize(script->static_variables_indices.size());
+
+	for (const Pair<StringName, Variant> &E : p_class.constants) {
+		script->constants.insert(E.first, E.second);
+	}
+	for (const Pair<StringName, MethodInfo> &E : p_class.signals) {
+		script->_signals.insert(E.first, E.second);
+	}
+	script->rpc_config = p_class.rpc_config;
+
+	for (const Pair<FunctionRole, FunctionData> &E : p_class.functions) {
+		GDScriptFunction *function = _create_function(script, p_class, E.second);
+		switch (E.first) {
+			case FUNCTION_MEMBER: {
+				script->member_functions.insert(function->name, function);
+				if (function->name == GDScriptLanguage::get_singleton()->strings._init) {
+					script->initializer = function;
+				}
+			} break;
+			case FUNCTION_IMPLICIT_INITIALIZER: {
+				script->implicit_initializer = function;
+			} break;
+			case FUNCTION_IMPLICIT_READY: {
+				script->implicit_ready = function;
+			} break;
+			case FUNCTION_STATIC_INITIALIZER: {
+				script->static_initializer = function;
+			} break;
+		}
+	}
+
+	script->_static_default_init();
+	script->valid = true;
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_cache, const Vector<uint8_t> &p_binary_tokens) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Reader reader(p_cache);
+	uint32_t flags = 0;
+	if (!_read_header(reader, p_binary_tokens, flags)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	ClassTree tree;
+	if (!_read_class_tree(reader, tree)) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	_make_scripts(p_script, tree);
+	return OK;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const Vector<uint8_t> &p_cache) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	// Only a script that was never compiled can be restored, there's no previous state to carry over.
+	if (p_script->_owner != nullptr || !p_script->member_functions.is_empty() || p_script->implicit_initializer != nullptr) {
+		return ERR_ALREADY_IN_USE;
+	}
+
+#ifdef DEBUG_ENABLED
+	// The debugger needs stack information that only the compiler generates.
+	if (EngineDebugger::is_active()) {
+		return ERR_UNAVAILABLE;
+	}
+#endif
+
+	Reader reader(p_cache);
+	uint32_t flags = 0;
+	if (!_read_header(reader, p_script->binary_tokens, flags)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+#ifndef DEBUG_ENABLED
+	if (flags & FLAG_HAS_ASSERT) {
+		return ERR_UNAVAILABLE;
+	}
+#endif
+
+	ClassTree tree;
+	if (!_read_class_tree(reader, tree)) {
+		return ERR_FILE_CORRUPT;
+	}
+	Error err = _check_dependencies(reader, p_script);
+	if (err != OK) {
+		return err;
+	}
+	_make_scripts(p_script, tree);
+
+	// Everything is decoded and resolved first, so a cache that can't be used leaves the script untouched.
+	LoadContext context;
+	context.root = p_script;
+	if (!_read_class(reader, context, p_script, tree) || reader.pos != reader.size) {
+		return context.error != OK ? context.error : ERR_FILE_CORRUPT;
+	}
+
+	for (const ClassData &E : context.classes) {
+		_commit_class(E);
+	}
+
+	if (flags & FLAG_STATIC_DATA) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+#ifdef TOOLS_ENABLED
+
+// Reverse lookup of the native functions referenced by compiled functions, so they can be stored by name.
+// Descriptors sharing the same function resolve to equivalent code, so keeping the first one is enough.
+struct GDScriptBytecodeCache::NativeSymbols {
+	struct Operator {
+		Variant::Operator op = Variant::OP_EQUAL;
+		Variant::Type type_a = Variant::NIL;
+		Variant::Type type_b = Variant::NIL;
+	};
+
+	struct Member {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct Constructor {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, Operator> operators;
+	RBMap<Variant::ValidatedSetter, Member> setters;
+	RBMap<Variant::ValidatedGetter, Member> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Member> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Constructor> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	template <typename K, typename V>
+	static void add(RBMap<K, V> &r_map, K p_function, const V &p_descriptor) {
+		if (p_function != nullptr && !r_map.has(p_function)) {
+			r_map.insert(p_function, p_descriptor);
+		}
+	}
+
+	template <typename K, typename V>
+	static const V *find(const RBMap<K, V> &p_map, K p_function) {
+		const typename RBMap<K, V>::Element *E = p_map.find(p_function);
+		return E ? &E->value() : nullptr;
+	}
+
+	NativeSymbols() {
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int type_a = 0; type_a < Variant::VARIANT_MAX; type_a++) {
+				for (int type_b = 0; type_b < Variant::VARIANT_MAX; type_b++) {
+					add(operators, Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)type_a, (Variant::Type)type_b), { (Variant::Operator)op, (Variant::Type)type_a, (Variant::Type)type_b });
+				}
+			}
+		}
+
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			Variant::Type type = (Variant::Type)i;
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				add(setters, Variant::get_member_validated_setter(type, member), { type, member });
+				add(getters, Variant::get_member_validated_getter(type, member), { type, member });
+			}
+
+			add(keyed_setters, Variant::get_member_validated_keyed_setter(type), type);
+			add(keyed_getters, Variant::get_member_validated_keyed_getter(type), type);
+			add(indexed_setters, Variant::get_member_validated_indexed_setter(type), type);
+			add(indexed_getters, Variant::get_member_validated_indexed_getter(type), type);
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				add(builtin_methods, Variant::get_validated_builtin_method(type, method), { type, method });
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				add(constructors, Variant::get_validated_constructor(type, j), { type, j });
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			add(utilities, Variant::get_validated_utility_function(function), function);
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			add(gds_utilities, GDScriptUtilityFunctions::get_function(function), function);
+		}
+	}
+};
+
+const GDScriptBytecodeCache::NativeSymbols &GDScriptBytecodeCache::_get_native_symbols() {
+	static const NativeSymbols symbols;
+	return symbols;
+}
+
+void GDScriptBytecodeCache::_write_script_ref(Writer &p_writer, const Script *p_script, const GDScript *p_root) {
+	if (p_script == nullptr) {
+		p_writer.put_u8(SCRIPT_REF_NONE);
+		return;
+	}
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript == nullptr) {
+		if (!p_script->get_path().is_resource_file()) {
+			p_writer.fail("References a built-in script.");
+			return;
+		}
+		p_writer.put_u8(SCRIPT_REF_RESOURCE);
+		p_writer.put_string(p_script->get_path());
+		return;
+	}
+
+	// Inner classes are stored as the chain of class names from the script file they are declared in.
+	Vector<StringName> class_names;
+	const GDScript *file_script = gdscript;
+	while (file_script->_owner != nullptr) {
+		class_names.push_back(file_script->local_name);
+		file_script = file_script->_owner;
+	}
+	class_names.reverse();
+
+	String path;
+	if (file_script != p_root) {
+		path = file_script->get_script_path();
+		if (!path.is_resource_file()) {
+			p_writer.fail("References a built-in script.");
+			return;
+		}
+		p_writer.script_refs.insert(gdscript);
+	}
+
+	p_writer.put_u8(SCRIPT_REF_GDSCRIPT);
+	p_writer.put_string(path);
+	p_writer.put_u32(class_names.size());
+	for (const StringName &class_name : class_names) {
+		p_writer.put_string(class_name);
+	}
+}
+
+void GDScriptBytecodeCache::_write_value(Writer &p_writer, const Variant &p_value, const GDScript *p_root, int p_depth) {
+	if (p_depth > MAX_NESTING_DEPTH) {
+		p_writer.fail("Constant value is nested too deeply.");
+		return;
+	}
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				p_writer.put_u8(VALUE_NULL_OBJECT);
+				return;
+			}
+
+			const Script *script = Object::cast_to<Script>(object);
+			if (script != nullptr) {
+				p_writer.put_u8(VALUE_SCRIPT);
+				_write_script_ref(p_writer, script, p_root);
+				return;
+			}
+
+			// Native classes and singletons.
+			const Variant *global_array = GDScriptLanguage::get_singleton()->get_global_array();
+			for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+				if (global_array[E.value].get_validated_object() == object) {
+					p_writer.put_u8(VALUE_GLOBAL);
+					p_writer.put_string(E.key);
+					return;
+				}
+			}
+
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource != nullptr && resource->get_path().is_resource_file()) {
+				p_writer.put_u8(VALUE_RESOURCE);
+				p_writer.put_string(resource->get_path());
+				p_writer.put_string(resource->get_class());
+				return;
+			}
+
+			p_writer.fail(vformat(R"(Constant object of type "%s" can't be cached.)", object->get_class()));
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			p_writer.put_u8(VALUE_ARRAY);
+			p_writer.put_u32(array.get_typed_builtin());
+			p_writer.put_string(array.get_typed_class_name());
+			_write_script_ref(p_writer, Object::cast_to<Script>(array.get_typed_script().get_validated_object()), p_root);
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				_write_value(p_writer, array[i], p_root, p_depth + 1);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_value;
+			p_writer.put_u8(VALUE_DICTIONARY);
+			p_writer.put_u32(dictionary.get_typed_key_builtin());
+			p_writer.put_string(dictionary.get_typed_key_class_name());
+			_write_script_ref(p_writer, Object::cast_to<Script>(dictionary.get_typed_key_script().get_validated_object()), p_root);
+			p_writer.put_u32(dictionary.get_typed_value_builtin());
+			p_writer.put_string(dictionary.get_typed_value_class_name());
+			_write_script_ref(p_writer, Object::cast_to<Script>(dictionary.get_typed_value_script().get_validated_object()), p_root);
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_u32(dictionary.size());
+			List<Variant> keys;
+			dictionary.get_key_list(&keys);
+			for (const Variant &key : keys) {
+				_write_value(p_writer, key, p_root, p_depth + 1);
+				_write_value(p_writer, dictionary[key], p_root, p_depth + 1);
+			}
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			p_writer.fail(vformat(R"(Constant value of type "%s" can't be cached.)", Variant::get_type_name(p_value.get_type())));
+		} break;
+		default: {
+			p_writer.put_u8(VALUE_PLAIN);
+			p_writer.put_variant(p_value);
+		} break;
+	}
+}
+
+void GDScriptBytecodeCache::_write_data_type(Writer &p_writer, const GDScriptDataType &p_type, const GDScript *p_root) {
+	p_writer.put_u8(p_type.has_type);
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	_write_script_ref(p_writer, p_type.script_type, p_root);
+	p_writer.put_u8(p_type.script_type_ref.is_valid());
+	p_writer.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		_write_data_type(p_writer, element_type, p_root);
+	}
+}
+
+void GDScriptBytecodeCache::_write_property_info(Writer &p_writer, const PropertyInfo &p_info) {
+	p_writer.put_u32(p_info.type);
+	p_writer.put_string(p_info.name);
+	p_writer.put_string(p_info.class_name);
+	p_writer.put_u32(p_info.hint);
+	p_writer.put_string(p_info.hint_string);
+	p_writer.put_u32(p_info.usage);
+}
+
+void GDScriptBytecodeCache::_write_method_info(Writer &p_writer, const MethodInfo &p_info, const GDScript *p_root) {
+	p_writer.put_string(p_info.name);
+	_write_property_info(p_writer, p_info.return_val);
+	p_writer.put_u32(p_info.flags);
+	p_writer.put_i32(p_info.id);
+	p_writer.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_write_property_info(p_writer, argument);
+	}
+	p_writer.put_u32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		_write_value(p_writer, default_argument, p_root);
+	}
+	p_writer.put_i32(p_info.return_val_metadata);
+	p_writer.put_ints(p_info.arguments_metadata);
+}
+
+void GDScriptBytecodeCache::_write_member_info(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info, const GDScript *p_root) {
+	p_writer.put_string(p_name);
+	p_writer.put_i32(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	_write_data_type(p_writer, p_info.data_type, p_root);
+	_write_property_info(p_writer, p_info.property_info);
+}
+
+void GDScriptBytecodeCache::_write_class_tree(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->fully_qualified_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_write_class_tree(p_writer, E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_write_function(Writer &p_writer, const GDScriptFunction *p_function, const GDScript *p_root) {
+	if (p_function->has_assert) {
+		p_writer.flags |= FLAG_HAS_ASSERT;
+	}
+
+	p_writer.put_string(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	p_writer.put_i32(p_function->_initial_line);
+	p_writer.put_i32(p_function->_argument_count);
+	p_writer.put_i32(p_function->_stack_size);
+	p_writer.put_i32(p_function->_instruction_args_size);
+	_write_value(p_writer, p_function->rpc_config, p_root);
+	_write_data_type(p_writer, p_function->return_type, p_root);
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		_write_data_type(p_writer, argument_type, p_root);
+	}
+	_write_method_info(p_writer, p_function->method_info, p_root);
+
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_i32(E.key);
+		p_writer.put_u32(E.value);
+	}
+
+	p_writer.put_ints(p_function->default_arguments);
+
+	// Clear what was stored in the bytecode by this process.
+	Vector<int> code = p_function->code;
+	int *code_ptr = code.ptrw();
+
+	constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+	for (int position : p_function->untyped_operator_positions) {
+		if (position < 0 || position + 7 + pointer_size > code.size()) {
+			p_writer.fail("Invalid operator position in bytecode.");
+			return;
+		}
+		for (int i = 5; i < 7 + pointer_size; i++) {
+			code_ptr[position + i] = 0; // Signature, return type and evaluator.
+		}
+	}
+
+	const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	p_writer.put_u32(p_function->global_index_positions.size());
+	for (int position : p_function->global_index_positions) {
+		if (position < 0 || position >= code.size()) {
+			p_writer.fail("Invalid global position in bytecode.");
+			return;
+		}
+		StringName global_name;
+		for (const KeyValue<StringName, int> &E : global_map) {
+			if (E.value == code_ptr[position]) {
+				global_name = E.key;
+				break;
+			}
+		}
+		if (global_name == StringName()) {
+			p_writer.fail("Unknown global referenced by bytecode.");
+			return;
+		}
+		p_writer.put_i32(position);
+		p_writer.put_string(global_name);
+		code_ptr[position] = 0;
+	}
+
+	p_writer.put_ints(code);
+
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		_write_value(p_writer, constant, p_root);
+	}
+
+	p_writer.put_u32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string(global_name);
+	}
+
+	const NativeSymbols &symbols = _get_native_symbols();
+
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const NativeSymbols::Operator *op = NativeSymbols::find(symbols.operators, evaluator);
+		if (op == nullptr) {
+			p_writer.fail("Unknown operator evaluator.");
+			return;
+		}
+		p_writer.put_u32(op->op);
+		p_writer.put_u32(op->type_a);
+		p_writer.put_u32(op->type_b);
+	}
+
+	p_writer.put_u32(p_function->setters.size());
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		const NativeSymbols::Member *member = NativeSymbols::find(symbols.setters, setter);
+		if (member == nullptr) {
+			p_writer.fail("Unknown member setter.");
+			return;
+		}
+		p_writer.put_u32(member->type);
+		p_writer.put_string(member->name);
+	}
+
+	p_writer.put_u32(p_function->getters.size());
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		const NativeSymbols::Member *member = NativeSymbols::find(symbols.getters, getter);
+		if (member == nullptr) {
+			p_writer.fail("Unknown member getter.");
+			return;
+		}
+		p_writer.put_u32(member->type);
+		p_writer.put_string(member->name);
+	}
+
+#define WRITE_TYPE_TABLE(m_table)                                                                 \
+	p_writer.put_u32(p_function->m_table.size());                                                 \
+	for (int i = 0; i < p_function->m_table.size(); i++) {                                        \
+		const Variant::Type *type = NativeSymbols::find(symbols.m_table, p_function->m_table[i]); \
+		if (type == nullptr) {                                                                    \
+			p_writer.fail("Unknown function in " #m_table ".");                                   \
+			return;                                                                               \
+		}                                                                                         \
+		p_writer.put_u32(*type);                                                                  \
+	}
+
+	WRITE_TYPE_TABLE(keyed_setters);
+	WRITE_TYPE_TABLE(keyed_getters);
+	WRITE_TYPE_TABLE(indexed_setters);
+	WRITE_TYPE_TABLE(indexed_getters);
+
+#undef WRITE_TYPE_TABLE
+
+	p_writer.put_u32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod builtin_method : p_function->builtin_methods) {
+		const NativeSymbols::Member *method = NativeSymbols::find(symbols.builtin_methods, builtin_method);
+		if (method == nullptr) {
+			p_writer.fail("Unknown built-in method.");
+			return;
+		}
+		p_writer.put_u32(method->type);
+		p_writer.put_string(method->name);
+	}
+
+	p_writer.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const NativeSymbols::Constructor *descriptor = NativeSymbols::find(symbols.constructors, constructor);
+		if (descriptor == nullptr) {
+			p_writer.fail("Unknown constructor.");
+			return;
+		}
+		p_writer.put_u32(descriptor->type);
+		p_writer.put_i32(descriptor->index);
+	}
+
+	p_writer.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *utility_name = NativeSymbols::find(symbols.utilities, utility);
+		if (utility_name == nullptr) {
+			p_writer.fail("Unknown utility function.");
+			return;
+		}
+		p_writer.put_string(*utility_name);
+	}
+
+	p_writer.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		const StringName *utility_name = NativeSymbols::find(symbols.gds_utilities, utility);
+		if (utility_name == nullptr) {
+			p_writer.fail("Unknown GDScript utility function.");
+			return;
+		}
+		p_writer.put_string(*utility_name);
+	}
+
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+		p_writer.put_u32(_get_method_signature(method));
+	}
+
+	p_writer.put_ints(p_function->superinstruction_candidates);
+	p_writer.put_u32(p_function->_inline_cache_count);
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		p_writer.put_i32(info ? info->capture_count : 0);
+		p_writer.put_u8(info ? info->use_self : false);
+		_write_function(p_writer, lambda, p_root);
+	}
+}
+
+void GDScriptBytecodeCache::_write_class(Writer &p_writer, const GDScript *p_script, const GDScript *p_root) {
+	if (p_script->native.is_null()) {
+		p_writer.fail("Class has no native base.");
+		return;
+	}
+	if (p_script->static_initializer != nullptr) {
+		p_writer.flags |= FLAG_STATIC_DATA;
+	}
+
+	p_writer.put_u8(p_script->tool);
+	p_writer.put_string(p_script->native->get_name());
+	_write_script_ref(p_writer, p_script->base.ptr(), p_root);
+
+	p_writer.put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		_write_member_info(p_writer, E.key, E.value, p_root);
+	}
+
+	p_writer.put_u32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_writer.put_string(member);
+	}
+
+	p_writer.put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		_write_member_info(p_writer, E.key, E.value, p_root);
+	}
+
+	p_writer.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string(E.key);
+		_write_value(p_writer, E.value, p_root);
+	}
+
+	p_writer.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string(E.key);
+		_write_method_info(p_writer, E.value, p_root);
+	}
+
+	_write_value(p_writer, p_script->rpc_config, p_root);
+
+	const GDScriptFunction *special_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	const FunctionRole special_roles[] = { FUNCTION_IMPLICIT_INITIALIZER, FUNCTION_IMPLICIT_READY, FUNCTION_STATIC_INITIALIZER };
+
+	uint32_t function_count = p_script->member_functions.size();
+	for (const GDScriptFunction *function : special_functions) {
+		function_count += function != nullptr;
+	}
+	p_writer.put_u32(function_count);
+
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		p_writer.put_u8(FUNCTION_MEMBER);
+		_write_function(p_writer, E.value, p_root);
+	}
+	for (int i = 0; i < 3; i++) {
+		if (special_functions[i] != nullptr) {
+			p_writer.put_u8(special_roles[i]);
+			_write_function(p_writer, special_functions[i], p_root);
+		}
+	}
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_write_class(p_writer, E.value.ptr(), p_root);
+	}
+}
+
+void GDScriptBytecodeCache::_write_dependencies(Writer &p_writer, const Writer &p_classes, const GDScript *p_root, bool p_compressed) {
+	// Inherited members are laid out by the whole base chain, so the files of all the bases are dependencies too.
+	RBMap<String, const GDScript *> files;
+	for (const GDScript *script : p_classes.script_refs) {
+		for (const GDScript *E = script; E != nullptr; E = E->base.ptr()) {
+			const GDScript *file_script = E;
+			while (file_script->_owner != nullptr) {
+				file_script = file_script->_owner;
+			}
+			if (file_script != p_root) {
+				files.insert(file_script->get_script_path(), file_script);
+			}
+		}
+	}
+
+	p_writer.put_u32(files.size());
+	for (const KeyValue<String, const GDScript *> &E : files) {
+		p_writer.put_string(E.key);
+		p_writer.put_u32(_get_dependency_hash(E.value, p_compressed));
+	}
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::serialize(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, String *r_error) {
+	ERR_FAIL_COND_V(p_script.is_null(), Vector<uint8_t>());
+	const GDScript *root = p_script.ptr();
+
+	Writer body;
+	if (!root->is_valid()) {
+		body.fail("The script isn't compiled.");
+	} else if (root->_owner != nullptr) {
+		body.fail("Only scripts of a file can be cached.");
+	} else if (p_binary_tokens.is_empty()) {
+		body.fail("The script has no binary tokens.");
+	} else {
+		// The classes are written first to know which other scripts they depend on.
+		Writer classes;
+		_write_class(classes, root, root);
+
+		const bool compressed = p_binary_tokens.size() >= 12 && decode_uint32(p_binary_tokens.ptr() + 8) != 0;
+		_write_class_tree(body, root);
+		_write_dependencies(body, classes, root, compressed);
+		body.buffer.append_array(classes.buffer);
+		body.flags |= classes.flags;
+		if (classes.has_failed()) {
+			body.fail(classes.error);
+		}
+	}
+
+	uint32_t flags = body.flags;
+	if (!body.has_failed() && (flags & FLAG_STATIC_DATA)) {
+		// Whether the script stays loaded for its static variables depends on an annotation the script doesn't keep.
+		GDScriptParser parser;
+		if (parser.parse_binary(p_binary_tokens, root->path) != OK) {
+			body.fail("The binary tokens can't be parsed.");
+		} else if (parser.get_tree()->annotated_static_unload) {
+			flags &= ~FLAG_STATIC_DATA;
+		}
+	}
+
+	if (body.has_failed()) {
+		if (r_error) {
+			*r_error = body.error;
+		}
+		return Vector<uint8_t>();
+	}
+
+	Writer writer;
+	writer.put_bytes(CACHE_MAGIC, 4);
+	writer.put_u32(FORMAT_VERSION);
+	writer.put_string(VERSION_FULL_CONFIG);
+	writer.put_string(VERSION_HASH);
+	writer.put_u32(_get_build_signature());
+	writer.put_u32(hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size()));
+	writer.put_u32(hash_djb2_buffer(body.buffer.ptr(), body.buffer.size()));
+	writer.put_u32(flags);
+	writer.buffer.append_array(body.buffer);
+	return writer.buffer;
+}
+
+#endif // TOOLS_ENABLED
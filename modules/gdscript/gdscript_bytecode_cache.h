@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+
+// Serialized compiled state of a script (bytecode, constants, global names, type and member information),
+// exported next to its binary tokens so loading it doesn't need the parser, analyzer and compiler.
+// A cache is only accepted by the engine build that exported it and together with the exact tokens it was
+// made from, and every native symbol it refers to is looked up again by name and checked when loading.
+// Member indices and constants of other scripts are baked into it too, so it also records the tokens of the
+// scripts it refers to (and of their base classes), and is rejected when any of them changed.
+// Whenever a cache is rejected, the script is compiled from its tokens as usual.
+class GDScriptBytecodeCache {
+	struct Writer;
+	struct Reader;
+	struct ClassTree;
+	struct FunctionData;
+	struct LambdaData;
+	struct ClassData;
+	struct LoadContext;
+
+	enum Flags {
+		FLAG_HAS_ASSERT = 1 << 0, // Assert conditions are evaluated even in release builds, so those don't load the cache.
+		FLAG_STATIC_DATA = 1 << 1, // The script needs to be kept alive for its static variables.
+	};
+
+	enum FunctionRole {
+		FUNCTION_MEMBER,
+		FUNCTION_IMPLICIT_INITIALIZER,
+		FUNCTION_IMPLICIT_READY,
+		FUNCTION_STATIC_INITIALIZER,
+	};
+
+	enum ScriptRefKind {
+		SCRIPT_REF_NONE,
+		SCRIPT_REF_GDSCRIPT, // GDScript class, by path and inner class names.
+		SCRIPT_REF_RESOURCE, // Any other script, by path.
+	};
+
+	enum ValueTag {
+		VALUE_PLAIN,
+		VALUE_ARRAY,
+		VALUE_DICTIONARY,
+		VALUE_NULL_OBJECT,
+		VALUE_SCRIPT,
+		VALUE_RESOURCE,
+		VALUE_GLOBAL, // Native class or singleton from the global array.
+	};
+
+	static uint32_t _get_build_signature();
+	static uint32_t _get_method_signature(const MethodBind *p_method);
+
+	static uint32_t _get_dependency_hash(const GDScript *p_script, bool p_compressed);
+
+	static bool _read_header(Reader &p_reader, const Vector<uint8_t> &p_binary_tokens, uint32_t &r_flags);
+	static Error _check_dependencies(Reader &p_reader, const GDScript *p_script);
+	static bool _read_class_tree(Reader &p_reader, ClassTree &r_tree, int p_depth = 0);
+	static void _make_scripts(GDScript *p_script, const ClassTree &p_tree);
+
+	static bool _read_script_ref(Reader &p_reader, LoadContext &p_context, Ref<Script> &r_script);
+	static bool _read_value(Reader &p_reader, LoadContext &p_context, Variant &r_value, int p_depth = 0);
+	static bool _read_data_type(Reader &p_reader, LoadContext &p_context, GDScriptDataType &r_type, int p_depth = 0);
+	static bool _read_property_info(Reader &p_reader, PropertyInfo &r_info);
+	static bool _read_method_info(Reader &p_reader, LoadContext &p_context, MethodInfo &r_info);
+	static bool _read_member_info(Reader &p_reader, LoadContext &p_context, StringName &r_name, GDScript::MemberInfo &r_info);
+	static bool _read_function(Reader &p_reader, LoadContext &p_context, ClassData &p_class, FunctionData &r_function, int p_depth = 0);
+	static bool _read_class(Reader &p_reader, LoadContext &p_context, GDScript *p_script, const ClassTree &p_tree);
+
+	static GDScriptFunction *_create_function(GDScript *p_script, const ClassData &p_class, const FunctionData &p_function);
+	static void _commit_class(const ClassData &p_class);
+
+#ifdef TOOLS_ENABLED
+	struct NativeSymbols;
+	static const NativeSymbols &_get_native_symbols();
+
+	static void _write_script_ref(Writer &p_writer, const Script *p_script, const GDScript *p_root);
+	static void _write_value(Writer &p_writer, const Variant &p_value, const GDScript *p_root, int p_depth = 0);
+	static void _write_data_type(Writer &p_writer, const GDScriptDataType &p_type, const GDScript *p_root);
+	static void _write_property_info(Writer &p_writer, const PropertyInfo &p_info);
+	static void _write_method_info(Writer &p_writer, const MethodInfo &p_info, const GDScript *p_root);
+	static void _write_member_info(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info, const GDScript *p_root);
+	static void _write_class_tree(Writer &p_writer, const GDScript *p_script);
+	static void _write_dependencies(Writer &p_writer, const Writer &p_classes, const GDScript *p_root, bool p_compressed);
+	static void _write_function(Writer &p_writer, const GDScriptFunction *p_function, const GDScript *p_root);
+	static void _write_class(Writer &p_writer, const GDScript *p_script, const GDScript *p_root);
+#endif
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 3;
+
+	static String get_cache_path(const String &p_binary_tokens_path);
+
+	// Creates the inner class scripts, like `GDScriptCompiler::make_scripts()` does from a parse tree.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_cache, const Vector<uint8_t> &p_binary_tokens);
+	// Restores the compiled state of a script, as an alternative to `GDScriptCompiler::compile()`.
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_cache);
+
+#ifdef TOOLS_ENABLED
+	// Returns an empty buffer if the script uses something that can't be cached, with the reason in `r_error`.
+	static Vector<uint8_t> serialize(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, String *r_error = nullptr);
+#endif
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
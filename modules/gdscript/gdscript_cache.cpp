@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
@@ -237,6 +238,104 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	return ref;
 }
 
+void GDScriptCache::_queue_dependency(const String &p_path, HashSet<String> &r_visited, Vector<Ref<GDScriptParserRef>> &r_parser_refs) {
+	if (r_visited.has(p_path)) {
+		return;
+	}
+	r_visited.insert(p_path);
+
+	// Scripts that already have a parser were (or are being) parsed by someone else.
+	if (p_path.get_extension().to_lower() != "gd" || singleton->parser_map.has(p_path)) {
+		return;
+	}
+	if (!FileAccess::exists(ResourceLoader::path_remap(p_path))) {
+		return;
+	}
+
+	Ref<GDScriptParserRef> ref;
+	ref.instantiate();
+	ref->path = p_path;
+	r_parser_refs.push_back(ref);
+}
+
+void GDScriptCache::_queue_dependencies(const GDScriptParser *p_parser, HashSet<String> &r_visited, Vector<Ref<GDScriptParserRef>> &r_parser_refs) {
+	for (const String &E : p_parser->get_dependency_paths()) {
+		_queue_dependency(E, r_visited, r_parser_refs);
+	}
+	for (const StringName &E : p_parser->get_referenced_class_names()) {
+		if (ScriptServer::is_global_class(E) && ScriptServer::get_global_class_language(E) == GDScriptLanguage::get_singleton()->get_name()) {
+			_queue_dependency(ScriptServer::get_global_class_path(E), r_visited, r_parser_refs);
+		}
+	}
+}
+
+void GDScriptCache::_parse_dependency_task(uint32_t p_index, Ref<GDScriptParserRef> *p_parser_refs) {
+	// The reference isn't in the parser map yet, so no other thread can reach it while it's parsed.
+	p_parser_refs[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+Vector<Ref<GDScriptParserRef>> GDScriptCache::parse_dependencies(const GDScriptParser *p_parser) {
+	Vector<Ref<GDScriptParserRef>> parsed;
+	if (singleton == nullptr || p_parser->script_path.is_empty() || !GDScriptLanguage::get_singleton()->is_threaded_dependency_parsing_enabled()) {
+		return parsed;
+	}
+
+	HashSet<String> visited;
+	visited.insert(p_parser->script_path);
+
+	// Dependencies are parsed one level at a time, since what a dependency needs is only known once it's parsed.
+	Vector<Ref<GDScriptParserRef>> pending;
+	bool first_level = true;
+	while (first_level || !pending.is_empty()) {
+		Vector<Ref<GDScriptParserRef>> level;
+		{
+			MutexLock lock(singleton->mutex);
+			if (singleton->cleared) {
+				break;
+			}
+			if (first_level) {
+				_queue_dependencies(p_parser, visited, level);
+				first_level = false;
+			}
+			for (const Ref<GDScriptParserRef> &E : pending) {
+				// Might have been cleared by a script removal while the lock was released.
+				if (E->parser != nullptr && E->status != GDScriptParserRef::EMPTY) {
+					_queue_dependencies(E->parser, visited, level);
+				}
+			}
+		}
+		pending.clear();
+
+		if (level.is_empty()) {
+			break;
+		}
+
+		// The cache lock is not held here, so other threads can keep loading unrelated scripts in the meantime.
+		if (level.size() == 1) {
+			level.write[0]->raise_status(GDScriptParserRef::PARSED);
+		} else {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(singleton, &GDScriptCache::_parse_dependency_task, level.ptrw(), level.size(), -1, true, SNAME("GDScriptParseDependencies"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		MutexLock lock(singleton->mutex);
+		for (const Ref<GDScriptParserRef> &E : level) {
+			if (singleton->cleared || singleton->parser_map.has(E->path)) {
+				// Another thread got there first, keep its parser. Don't let this one unregister it when freed.
+				E->abandoned = true;
+				continue;
+			}
+			singleton->parser_map[E->path] = E.ptr();
+			parsed.push_back(E);
+			if (E->result == OK) {
+				pending.push_back(E);
+			}
+		}
+	}
+
+	return parsed;
+}
+
 bool GDScriptCache::has_parser(const String &p_path) {
 	MutexLock lock(singleton->mutex);
 	return singleton->parser_map.has(p_path);
@@ -313,12 +412,18 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	Ref<GDScript> script;
 	script.instantiate();
 	script->set_path_cache(p_path);
+	Vector<uint8_t> bytecode_cache;
 	if (remapped_path.get_extension().to_lower() == "gdc") {
 		Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
 		if (buffer.is_empty()) {
 			r_error = ERR_FILE_CANT_READ;
 		}
 		script->set_binary_tokens_source(buffer);
+
+		const String cache_path = GDScriptBytecodeCache::get_cache_path(remapped_path);
+		if (!buffer.is_empty() && FileAccess::exists(cache_path)) {
+			bytecode_cache = FileAccess::get_file_as_bytes(cache_path);
+		}
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -327,9 +432,14 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	// An exported bytecode cache describes the inner classes, so the script doesn't need to be parsed at all.
+	if (!bytecode_cache.is_empty() && GDScriptBytecodeCache::make_scripts(script.ptr(), bytecode_cache, script->get_binary_tokens_source()) == OK) {
+		script->set_bytecode_cache_source(bytecode_cache);
+	} else {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
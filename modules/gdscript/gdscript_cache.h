@@ -102,10 +102,15 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	static void _queue_dependency(const String &p_path, HashSet<String> &r_visited, Vector<Ref<GDScriptParserRef>> &r_parser_refs);
+	static void _queue_dependencies(const GDScriptParser *p_parser, HashSet<String> &r_visited, Vector<Ref<GDScriptParserRef>> &r_parser_refs);
+	void _parse_dependency_task(uint32_t p_index, Ref<GDScriptParserRef> *p_parser_refs);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
+	static Vector<Ref<GDScriptParserRef>> parse_dependencies(const GDScriptParser *p_parser);
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
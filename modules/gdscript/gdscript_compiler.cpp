@@ -2646,6 +2646,11 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	parsing_classes.insert(p_script);
 
+	if (p_script->valid || !p_script->member_functions.is_empty() || !p_script->member_indices.is_empty()) {
+		// Recompiling a script that may have instances, what names resolve to can change.
+		GDScriptInlineCache::invalidate_all();
+	}
+
 	p_script->clearing = true;
 
 	p_script->native = Ref<GDScriptNativeClass>();
@@ -104,6 +104,46 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+void GDScriptFunction::_apply_superinstructions() {
+	superinstructions_pending = false;
+
+	// Instructions are replaced in place by a superinstruction of the same size, so addresses and jump targets stay valid,
+	// and a thread executing this function meanwhile runs either version correctly.
+	for (int pos : superinstruction_candidates) {
+		ERR_CONTINUE(pos < 0 || pos + 5 >= _code_size);
+		if (_code_ptr[pos] != OPCODE_OPERATOR_VALIDATED) {
+			continue;
+		}
+
+		const int next = pos + 5;
+		const int result_address = _code_ptr[pos + 3];
+		switch (_code_ptr[next]) {
+			case OPCODE_JUMP_IF: {
+				if (_code_ptr[next + 1] == result_address) {
+					_code_ptr[pos] = OPCODE_OPERATOR_VALIDATED_JUMP_IF;
+				}
+			} break;
+			case OPCODE_JUMP_IF_NOT: {
+				if (_code_ptr[next + 1] == result_address) {
+					_code_ptr[pos] = OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+				}
+			} break;
+			case OPCODE_ASSIGN: {
+				if (_code_ptr[next + 2] == result_address) {
+					_code_ptr[pos] = OPCODE_OPERATOR_VALIDATED_ASSIGN;
+				}
+			} break;
+			case OPCODE_OPERATOR_VALIDATED: {
+				_code_ptr[pos] = OPCODE_OPERATOR_VALIDATED_PAIR;
+			} break;
+			default:
+				break;
+		}
+	}
+
+	superinstruction_candidates.clear();
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -121,6 +161,10 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
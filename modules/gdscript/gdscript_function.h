@@ -31,6 +31,7 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "gdscript_inline_cache.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
@@ -257,6 +258,10 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
+		OPCODE_OPERATOR_VALIDATED_PAIR,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -444,6 +449,7 @@ private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptLanguage;
 
 	StringName name;
@@ -483,6 +489,21 @@ private:
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
 
+	// Positions of validated operators directly followed by an instruction they can be fused with.
+	// They are turned into superinstructions once the function has been called often enough.
+	Vector<int> superinstruction_candidates;
+	uint32_t superinstruction_call_threshold = 0;
+	SafeNumeric<uint32_t> superinstruction_call_count;
+	bool superinstructions_pending = false;
+
+#ifdef TOOLS_ENABLED
+	// Code positions holding data that only makes sense in the running process,
+	// so they can be fixed up when the bytecode is cached on export.
+	Vector<int> untyped_operator_positions; // `OPCODE_OPERATOR` caches its evaluator inline after the first run.
+	Vector<int> global_index_positions; // Indices into the global array, which differ between the editor and export templates.
+	bool has_assert = false;
+#endif
+
 	int _code_size = 0;
 	int _default_arg_count = 0;
 	int _constant_count = 0;
@@ -500,6 +521,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_cache_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -518,6 +540,7 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	GDScriptInlineCache *_inline_caches_ptr = nullptr; // Indexed by untyped named accesses and calls.
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -554,6 +577,7 @@ private:
 
 	_FORCE_INLINE_ String _get_call_error(const String &p_where, const Variant **p_argptrs, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
+	void _apply_superinstructions();
 
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
@@ -0,0 +1,356 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_inline_cache.h"
+
+#include "gdscript.h"
+
+#include "core/config/engine.h"
+#include "core/object/class_db.h"
+#include "core/variant/variant_internal.h"
+#include "scene/scene_string_names.h"
+
+SafeNumeric<uint32_t> GDScriptInlineCache::epoch;
+
+void GDScriptInlineCache::_resolve(Access p_access, Object *p_object, const GDScript *p_script, const StringName &p_name, Shape &r_shape) {
+	// The rules below mirror the lookup order of `Variant`, `Object` and `GDScriptInstance`, and only resolve
+	// names to something that can't change while the receiver keeps the same shape.
+	r_shape.kind = SHAPE_UNCACHED;
+
+	if (!p_object) {
+		if (p_access == ACCESS_GET) {
+			r_shape.builtin_getter = Variant::get_member_validated_getter(r_shape.type, p_name);
+			if (r_shape.builtin_getter) {
+				r_shape.kind = SHAPE_BUILTIN;
+				r_shape.member_type = Variant::get_member_type(r_shape.type, p_name);
+			}
+		} else if (p_access == ACCESS_SET) {
+			r_shape.builtin_setter = Variant::get_member_validated_setter(r_shape.type, p_name);
+			if (r_shape.builtin_setter) {
+				r_shape.kind = SHAPE_BUILTIN;
+				r_shape.member_type = Variant::get_member_type(r_shape.type, p_name);
+			}
+		}
+		// Built-in methods are already found with a single lookup, and need their arguments validated anyway.
+		return;
+	}
+
+	if (p_script) {
+		if (p_access == ACCESS_CALL) {
+			if (p_name == SceneStringName(_ready)) {
+				return; // Runs the implicit initializers first.
+			}
+			for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+				if (!sptr->valid) {
+					return;
+				}
+				HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+				if (E) {
+					r_shape.kind = SHAPE_SCRIPT;
+					r_shape.function = E->value;
+					return;
+				}
+			}
+		} else {
+			if (!p_script->valid) {
+				return;
+			}
+			HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = p_script->member_indices.find(p_name);
+			if (E) {
+				if (p_access == ACCESS_GET ? E->value.getter == StringName() : E->value.setter == StringName()) {
+					r_shape.kind = SHAPE_SCRIPT;
+					r_shape.member_index = E->value.index;
+					r_shape.member_data_type = E->value.data_type.has_type ? &E->value.data_type : nullptr;
+				}
+				return;
+			}
+
+			const StringName &fallback = p_access == ACCESS_GET ? GDScriptLanguage::get_singleton()->strings._get : GDScriptLanguage::get_singleton()->strings._set;
+			for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+				if (!sptr->valid || sptr->static_variables_indices.has(p_name) || sptr->member_functions.has(fallback)) {
+					return;
+				}
+				if (p_access == ACCESS_GET && (sptr->constants.has(p_name) || sptr->_signals.has(p_name) || sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name))) {
+					return;
+				}
+			}
+		}
+	}
+
+	ClassDB::ClassInfo *type = ClassDB::classes.getptr(r_shape.native_class);
+	if (!type || type->gdextension) {
+		// Extensions can handle names themselves, and be reloaded.
+		return;
+	}
+
+	if (p_access == ACCESS_CALL) {
+		if (p_name == CoreStringName(free_)) {
+			return;
+		}
+		r_shape.method = ClassDB::get_method(r_shape.native_class, p_name);
+		if (r_shape.method) {
+			r_shape.kind = SHAPE_NATIVE;
+		}
+		return;
+	}
+
+#ifdef TOOLS_ENABLED
+	if (p_access == ACCESS_SET && Engine::get_singleton()->is_editor_hint()) {
+		// `Object::set()` marks the object as edited.
+		return;
+	}
+#endif
+
+	for (const ClassDB::ClassInfo *check = type; check; check = check->inherits_ptr) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			// Indexed properties pass their index as an argument, and the others are called through `Object::callp()`.
+			r_shape.method = p_access == ACCESS_GET ? psg->_getptr : psg->_setptr;
+			if (psg->index < 0 && r_shape.method) {
+				r_shape.kind = SHAPE_NATIVE;
+			}
+			return;
+		}
+	}
+}
+
+const GDScriptInlineCache::Shape *GDScriptInlineCache::_find_shape(Access p_access, const Variant *p_base, const StringName &p_name, Object *&r_object, GDScriptInstance *&r_instance) {
+	if (megamorphic.is_set()) {
+		_count(false);
+		return nullptr;
+	}
+
+	const Variant::Type type = p_base->get_type();
+	Object *object = nullptr;
+	GDScript *script = nullptr;
+	if (type == Variant::OBJECT) {
+		object = p_base->get_validated_object();
+		if (unlikely(!object)) {
+			// Let `Variant` report the error.
+			_count(false);
+			return nullptr;
+		}
+		ScriptInstance *instance = object->get_script_instance();
+		if (instance) {
+			if (instance->get_language() != GDScriptLanguage::get_singleton() || instance->is_placeholder()) {
+				_count(false);
+				return nullptr;
+			}
+			r_instance = static_cast<GDScriptInstance *>(instance);
+			script = r_instance->script.ptr();
+		}
+	}
+	r_object = object;
+
+	const uint32_t current_epoch = epoch.get();
+	const Entry *current = entry.load(std::memory_order_acquire);
+	if (likely(current && current->epoch == current_epoch)) {
+		for (int i = 0; i < current->shape_count; i++) {
+			const Shape &shape = current->shapes[i];
+			if (shape.type == type && (!object || (shape.native_class == object->get_class_name() && shape.script == script && (!script || shape.script_id == script->get_instance_id())))) {
+				if (shape.kind == SHAPE_UNCACHED) {
+					_count(false);
+					return nullptr;
+				}
+				_count(true);
+				return &shape;
+			}
+		}
+	}
+
+	_count(false);
+
+	Shape shape;
+	shape.type = type;
+	if (object) {
+		shape.native_class = object->get_class_name();
+		shape.script = script;
+		shape.script_id = script ? script->get_instance_id() : ObjectID();
+	}
+
+	static Mutex update_mutex;
+	MutexLock lock(update_mutex);
+
+	_resolve(p_access, object, script, p_name, shape);
+
+	// Another thread may have updated the cache in the meantime, but adding the same shape twice is harmless.
+	current = entry.load(std::memory_order_acquire);
+	Entry *new_entry = memnew(Entry);
+	new_entry->epoch = current_epoch;
+	if (current && current->epoch == current_epoch) {
+		if (current->shape_count == MAX_SHAPES) {
+			memdelete(new_entry);
+			megamorphic.set();
+			return nullptr;
+		}
+		for (int i = 0; i < current->shape_count; i++) {
+			new_entry->shapes[i] = current->shapes[i];
+		}
+		new_entry->shape_count = current->shape_count;
+	} else if (current && ++updates > MAX_UPDATES) {
+		memdelete(new_entry);
+		megamorphic.set();
+		return nullptr;
+	}
+
+	Shape &added = new_entry->shapes[new_entry->shape_count++];
+	added = shape;
+	new_entry->previous = last_entry;
+	last_entry = new_entry;
+	entry.store(new_entry, std::memory_order_release);
+
+	return added.kind == SHAPE_UNCACHED ? nullptr : &added;
+}
+
+bool GDScriptInlineCache::get_named(const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const Shape *shape = _find_shape(ACCESS_GET, p_base, p_name, object, instance);
+	if (!shape) {
+		return false;
+	}
+
+	switch (shape->kind) {
+		case SHAPE_BUILTIN: {
+			VariantInternal::initialize(&r_ret, shape->member_type);
+			shape->builtin_getter(p_base, &r_ret);
+		} break;
+		case SHAPE_NATIVE: {
+			Callable::CallError ce;
+			r_ret = shape->method->call(object, nullptr, 0, ce);
+		} break;
+		case SHAPE_SCRIPT: {
+			r_ret = instance->members[shape->member_index];
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptInlineCache::set_named(Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid) {
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const Shape *shape = _find_shape(ACCESS_SET, p_base, p_name, object, instance);
+	if (!shape) {
+		return false;
+	}
+
+	switch (shape->kind) {
+		case SHAPE_BUILTIN: {
+			if (p_value->get_type() != shape->member_type) {
+				return false; // Needs a conversion.
+			}
+			shape->builtin_setter(p_base, p_value);
+			r_valid = true;
+		} break;
+		case SHAPE_NATIVE: {
+			Callable::CallError ce;
+			shape->method->call(object, &p_value, 1, ce);
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+		} break;
+		case SHAPE_SCRIPT: {
+			if (shape->member_data_type && !shape->member_data_type->is_type(*p_value)) {
+				return false; // Needs a conversion, or fails.
+			}
+			instance->members.write[shape->member_index] = *p_value;
+			r_valid = true;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptInlineCache::call(Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const Shape *shape = _find_shape(ACCESS_CALL, p_base, p_name, object, instance);
+	if (!shape) {
+		return false;
+	}
+
+	if (shape->kind != SHAPE_NATIVE && shape->kind != SHAPE_SCRIPT) {
+		return false;
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+#ifdef DEBUG_ENABLED
+	// Reports the object being freed during the call, as `Object::callp()` which is skipped does.
+	_ObjectDebugLock debug_lock(object);
+#endif
+	switch (shape->kind) {
+		case SHAPE_NATIVE: {
+			r_ret = shape->method->call(object, p_args, p_argcount, r_error);
+		} break;
+		case SHAPE_SCRIPT: {
+			r_ret = shape->function->call(instance, p_args, p_argcount, r_error);
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptInlineCache::accumulate_statistics(Statistics &r_stats) const {
+	r_stats.sites++;
+#ifdef DEBUG_ENABLED
+	r_stats.hits += hits.load(std::memory_order_relaxed);
+	r_stats.misses += misses.load(std::memory_order_relaxed);
+#endif
+	if (megamorphic.is_set()) {
+		r_stats.megamorphic++;
+		return;
+	}
+	const Entry *current = entry.load(std::memory_order_acquire);
+	if (current && current->shape_count == 1) {
+		r_stats.monomorphic++;
+	} else if (current && current->shape_count > 1) {
+		r_stats.polymorphic++;
+	}
+}
+
+void GDScriptInlineCache::reset_statistics() {
+#ifdef DEBUG_ENABLED
+	hits.store(0, std::memory_order_relaxed);
+	misses.store(0, std::memory_order_relaxed);
+#endif
+}
+
+GDScriptInlineCache::~GDScriptInlineCache() {
+	while (last_entry) {
+		Entry *previous = last_entry->previous;
+		memdelete(last_entry);
+		last_entry = previous;
+	}
+}
@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_INLINE_CACHE_H
+#define GDSCRIPT_INLINE_CACHE_H
+
+#include "core/string/string_name.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/variant.h"
+
+#include <atomic>
+
+class GDScript;
+class GDScriptFunction;
+class GDScriptInstance;
+struct GDScriptDataType;
+class MethodBind;
+
+// Per call site cache for the untyped `OPCODE_GET_NAMED`, `OPCODE_SET_NAMED` and `OPCODE_CALL*` instructions.
+// It remembers what the name resolved to for the last few receiver shapes (the Variant type, or the native class
+// and script of an object), so the name based lookup through the script instance and `ClassDB` can be skipped.
+// Each instruction stores the index of its cache in the function, see `GDScriptFunction::_inline_caches_ptr`.
+class GDScriptInlineCache {
+public:
+	static constexpr int MAX_SHAPES = 4;
+	// Number of times a site can be refilled after being invalidated before it gives up.
+	static constexpr int MAX_UPDATES = 16;
+
+	struct Statistics {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint32_t sites = 0;
+		uint32_t monomorphic = 0;
+		uint32_t polymorphic = 0;
+		uint32_t megamorphic = 0;
+	};
+
+private:
+	enum ShapeKind : uint8_t {
+		SHAPE_UNCACHED, // The receiver is known, but the name can't be resolved ahead of time. Take the slow path.
+		SHAPE_BUILTIN, // Validated member getter or setter of a built-in type.
+		SHAPE_NATIVE, // Getter, setter or method bind of a native class.
+		SHAPE_SCRIPT, // Member variable or function of a GDScript.
+	};
+
+	struct Shape {
+		ShapeKind kind = SHAPE_UNCACHED;
+		Variant::Type type = Variant::NIL;
+		// Objects only.
+		StringName native_class;
+		const GDScript *script = nullptr;
+		ObjectID script_id;
+
+		Variant::Type member_type = Variant::NIL;
+		union {
+			Variant::ValidatedGetter builtin_getter;
+			Variant::ValidatedSetter builtin_setter;
+			MethodBind *method;
+			GDScriptFunction *function;
+			int member_index;
+		};
+		const GDScriptDataType *member_data_type = nullptr; // Typed script member, values must match it to be set directly.
+
+		Shape() :
+				method(nullptr) {}
+	};
+
+	// Published atomically and never modified afterwards, so it can be read without locking.
+	struct Entry {
+		uint32_t epoch = 0;
+		int shape_count = 0;
+		Shape shapes[MAX_SHAPES];
+		Entry *previous = nullptr; // Entries are only freed with the cache, as other threads may still be reading them.
+	};
+
+	enum Access {
+		ACCESS_GET,
+		ACCESS_SET,
+		ACCESS_CALL,
+	};
+
+	static SafeNumeric<uint32_t> epoch;
+
+	std::atomic<const Entry *> entry = nullptr;
+	Entry *last_entry = nullptr;
+	SafeFlag megamorphic;
+	int updates = 0;
+#ifdef DEBUG_ENABLED
+	// Statistics only, so increments racing between threads can be lost.
+	std::atomic<uint64_t> hits = 0;
+	std::atomic<uint64_t> misses = 0;
+#endif
+
+	_FORCE_INLINE_ void _count(bool p_hit) {
+#ifdef DEBUG_ENABLED
+		std::atomic<uint64_t> &counter = p_hit ? hits : misses;
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#endif
+	}
+
+	static void _resolve(Access p_access, Object *p_object, const GDScript *p_script, const StringName &p_name, Shape &r_shape);
+	const Shape *_find_shape(Access p_access, const Variant *p_base, const StringName &p_name, Object *&r_object, GDScriptInstance *&r_instance);
+
+public:
+	// Must be called whenever what a name resolves to may have changed, like when a script is recompiled.
+	static void invalidate_all() { epoch.increment(); }
+
+	// Return `false` when the access was not handled by the cache and has to go through `Variant`.
+	// `r_ret` must not alias `p_base`.
+	bool get_named(const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	bool set_named(Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid);
+	bool call(Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+
+	void accumulate_statistics(Statistics &r_stats) const;
+	void reset_statistics();
+
+	GDScriptInlineCache() {}
+	~GDScriptInlineCache();
+};
+
+#endif // GDSCRIPT_INLINE_CACHE_H
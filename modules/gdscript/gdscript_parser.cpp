@@ -766,6 +766,18 @@ const HashMap<String, Ref<GDScriptParserRef>> &GDScriptParser::get_depended_pars
 	return depended_parsers;
 }
 
+void GDScriptParser::add_dependency(const String &p_path) {
+	if (p_path.is_empty()) {
+		return;
+	}
+	// Resolved the same way the analyzer does for `extends` and `preload()`.
+	if (p_path.is_relative_path()) {
+		dependencies.insert(script_path.get_base_dir().path_join(p_path).simplify_path());
+	} else {
+		dependencies.insert(p_path.simplify_path());
+	}
+}
+
 GDScriptParser::ClassNode *GDScriptParser::find_class(const String &p_qualified_name) const {
 	String first = p_qualified_name.get_slice("::", 0);
 
@@ -891,6 +903,7 @@ void GDScriptParser::parse_extends() {
 			push_error(vformat(R"(Only strings or identifiers can be used after "extends", found "%s" instead.)", Variant::get_type_name(previous.literal.get_type())));
 		}
 		current_class->extends_path = previous.literal;
+		add_dependency(current_class->extends_path);
 
 		if (!match(GDScriptTokenizer::Token::PERIOD)) {
 			return;
@@ -903,6 +916,9 @@ void GDScriptParser::parse_extends() {
 		return;
 	}
 	current_class->extends.push_back(parse_identifier());
+	if (current_class->extends_path.is_empty()) {
+		referenced_class_names.insert(current_class->extends[0]->name);
+	}
 
 	while (match(GDScriptTokenizer::Token::PERIOD)) {
 		make_completion_context(COMPLETION_INHERIT_TYPE, current_class, chain_index++);
@@ -3124,6 +3140,9 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_attribute(ExpressionNode *
 	}
 
 	attribute->base = p_previous_operand;
+	if (p_previous_operand && p_previous_operand->type == Node::IDENTIFIER) {
+		referenced_class_names.insert(static_cast<IdentifierNode *>(p_previous_operand)->name);
+	}
 
 	if (current.is_node_name()) {
 		current.type = GDScriptTokenizer::Token::IDENTIFIER;
@@ -3401,6 +3420,11 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_preload(ExpressionNode *p_
 
 	if (preload->path == nullptr) {
 		push_error(R"(Expected resource path after "(".)");
+	} else if (preload->path->type == Node::LITERAL) {
+		const Variant &path = static_cast<LiteralNode *>(preload->path)->value;
+		if (path.get_type() == Variant::STRING) {
+			add_dependency(path);
+		}
 	}
 
 	pop_completion_call();
@@ -3579,6 +3603,7 @@ GDScriptParser::TypeNode *GDScriptParser::parse_type(bool p_allow_void) {
 	IdentifierNode *type_element = parse_identifier();
 
 	type->type_chain.push_back(type_element);
+	referenced_class_names.insert(type_element->name);
 
 	if (match(GDScriptTokenizer::Token::BRACKET_OPEN)) {
 		// Typed collection (like Array[int], Dictionary[String, int]).
@@ -44,6 +44,7 @@
 #include "core/string/string_name.h"
 #include "core/string/ustring.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/list.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/vector.h"
@@ -1330,6 +1331,7 @@ public:
 
 private:
 	friend class GDScriptAnalyzer;
+	friend class GDScriptCache;
 	friend class GDScriptParserRef;
 
 	bool _is_tool = false;
@@ -1341,6 +1343,10 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	// Paths from `extends` and `preload()` literals, and identifiers that may name a global class.
+	// Gathered while parsing so dependencies can be loaded before the analyzer asks for them.
+	HashSet<String> dependencies;
+	HashSet<StringName> referenced_class_names;
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1452,6 +1458,7 @@ private:
 		return node;
 	}
 	void clear();
+	void add_dependency(const String &p_path);
 	void push_error(const String &p_message, const Node *p_origin = nullptr);
 #ifdef DEBUG_ENABLED
 	void push_warning(const Node *p_source, GDScriptWarning::Code p_code, const Vector<String> &p_symbols);
@@ -1593,6 +1600,9 @@ public:
 		// TODO: Keep track of deps.
 		return List<String>();
 	}
+	// Not reported by `get_dependencies()`, as they are only gathered to parse the dependencies ahead of the analysis.
+	const HashSet<String> &get_dependency_paths() const { return dependencies; }
+	const HashSet<StringName> &get_referenced_class_names() const { return referenced_class_names; }
 #ifdef DEBUG_ENABLED
 	const List<GDScriptWarning> &get_warnings() const { return warnings; }
 	const HashSet<int> &get_unsafe_lines() const { return unsafe_lines; }
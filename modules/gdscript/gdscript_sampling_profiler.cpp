@@ -0,0 +1,255 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript_function.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+
+// Keeps about an hour of samples at the default interval, later samples are only aggregated.
+static const uint32_t MAX_TIMELINE_SAMPLES = 4 * 1024 * 1024;
+
+SafeFlag GDScriptSamplingProfiler::active;
+SafeNumeric<uint64_t> GDScriptSamplingProfiler::tick;
+thread_local uint64_t GDScriptSamplingProfiler::thread_tick = 0;
+thread_local LocalVector<GDScriptSamplingProfiler::Frame> GDScriptSamplingProfiler::thread_frames;
+
+Mutex GDScriptSamplingProfiler::mutex;
+Thread GDScriptSamplingProfiler::sampler_thread;
+SafeFlag GDScriptSamplingProfiler::sampler_exit;
+uint64_t GDScriptSamplingProfiler::interval_usec = 1000;
+uint64_t GDScriptSamplingProfiler::start_time = 0;
+
+HashMap<String, uint32_t> GDScriptSamplingProfiler::stack_indices;
+LocalVector<String> GDScriptSamplingProfiler::stacks;
+LocalVector<uint64_t> GDScriptSamplingProfiler::stack_weights;
+LocalVector<GDScriptSamplingProfiler::Sample> GDScriptSamplingProfiler::samples;
+
+void GDScriptSamplingProfiler::_sampler_thread_func(void *p_userdata) {
+	Thread::set_name("GDScript Sampling Profiler");
+	while (!sampler_exit.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		tick.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::_take_sample() {
+	const uint64_t current_tick = tick.get();
+	const uint64_t weight = current_tick - thread_tick;
+	thread_tick = current_tick;
+	if (!active.is_set() || thread_frames.is_empty()) {
+		return;
+	}
+
+	// Outermost call first, as in collapsed stacks. Every frame is "function (path:line)", so each line gets its own node.
+	String stack;
+	for (uint32_t i = 0; i < thread_frames.size(); i++) {
+		const Frame &frame = thread_frames[i];
+		if (i > 0) {
+			stack += ";";
+		}
+		stack += String(frame.function->get_name()) + " (" + String(frame.function->get_source()) + ":" + itos(*frame.line) + ")";
+	}
+
+	MutexLock lock(mutex);
+	uint32_t index;
+	HashMap<String, uint32_t>::Iterator E = stack_indices.find(stack);
+	if (E) {
+		index = E->value;
+	} else {
+		index = stacks.size();
+		stack_indices.insert(stack, index);
+		stacks.push_back(stack);
+		stack_weights.push_back(0);
+	}
+	stack_weights[index] += weight;
+
+	if (samples.size() < MAX_TIMELINE_SAMPLES) {
+		Sample sample;
+		sample.timestamp = OS::get_singleton()->get_ticks_usec() - start_time;
+		sample.thread_id = Thread::get_caller_id();
+		sample.weight = weight;
+		sample.stack = index;
+		samples.push_back(sample);
+	}
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(p_interval_usec == 0, "The sampling interval must be greater than zero.");
+	if (active.is_set()) {
+		return;
+	}
+
+	interval_usec = p_interval_usec;
+	{
+		MutexLock lock(mutex);
+		if (samples.is_empty()) {
+			start_time = OS::get_singleton()->get_ticks_usec();
+		}
+	}
+
+	sampler_exit.clear();
+	active.set();
+	sampler_thread.start(_sampler_thread_func, nullptr);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+
+	active.clear();
+	sampler_exit.set();
+	sampler_thread.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	stack_indices.clear();
+	stacks.clear();
+	stack_weights.clear();
+	samples.clear();
+	start_time = OS::get_singleton()->get_ticks_usec();
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	uint64_t count = 0;
+	for (uint64_t weight : stack_weights) {
+		count += weight;
+	}
+	return count;
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() {
+	MutexLock lock(mutex);
+	LocalVector<String> lines;
+	lines.reserve(stacks.size());
+	for (uint32_t i = 0; i < stacks.size(); i++) {
+		lines.push_back(stacks[i] + " " + itos(stack_weights[i]));
+	}
+	lines.sort();
+
+	String result;
+	for (const String &line : lines) {
+		result += line + "\n";
+	}
+	return result;
+}
+
+String GDScriptSamplingProfiler::get_chrome_trace() {
+	MutexLock lock(mutex);
+
+	// Frames form a tree, a frame is identified by the stack leading to it.
+	Dictionary stack_frames;
+	HashMap<String, int> frame_ids;
+	LocalVector<int> leaf_frames;
+	leaf_frames.resize(stacks.size());
+	for (uint32_t i = 0; i < stacks.size(); i++) {
+		const Vector<String> frames = stacks[i].split(";");
+		String prefix;
+		int parent = -1;
+		for (const String &frame : frames) {
+			prefix = prefix.is_empty() ? frame : prefix + ";" + frame;
+			HashMap<String, int>::Iterator E = frame_ids.find(prefix);
+			if (E) {
+				parent = E->value;
+				continue;
+			}
+			const int id = frame_ids.size();
+			frame_ids.insert(prefix, id);
+
+			Dictionary stack_frame;
+			stack_frame["category"] = "GDScript";
+			stack_frame["name"] = frame;
+			if (parent >= 0) {
+				stack_frame["parent"] = itos(parent);
+			}
+			stack_frames[itos(id)] = stack_frame;
+			parent = id;
+		}
+		leaf_frames[i] = parent;
+	}
+
+	Array trace_events;
+	HashSet<uint64_t> threads;
+	Array trace_samples;
+	for (const Sample &sample : samples) {
+		if (!threads.has(sample.thread_id)) {
+			threads.insert(sample.thread_id);
+			Dictionary thread_name;
+			thread_name["name"] = "thread_name";
+			thread_name["ph"] = "M";
+			thread_name["pid"] = 1;
+			thread_name["tid"] = sample.thread_id;
+			Dictionary args;
+			args["name"] = sample.thread_id == Thread::get_main_id() ? String("Main Thread") : vformat("Thread %d", sample.thread_id);
+			thread_name["args"] = args;
+			trace_events.push_back(thread_name);
+		}
+
+		Dictionary trace_sample;
+		trace_sample["name"] = "GDScript";
+		trace_sample["ts"] = sample.timestamp;
+		trace_sample["pid"] = 1;
+		trace_sample["tid"] = sample.thread_id;
+		trace_sample["weight"] = sample.weight;
+		trace_sample["sf"] = itos(leaf_frames[sample.stack]);
+		trace_samples.push_back(trace_sample);
+	}
+
+	Dictionary trace;
+	trace["traceEvents"] = trace_events;
+	trace["stackFrames"] = stack_frames;
+	trace["samples"] = trace_samples;
+	trace["displayTimeUnit"] = "ms";
+	return JSON::stringify(trace, "", false);
+}
+
+Error GDScriptSamplingProfiler::save(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot save the GDScript sampling profile to '" + p_path + "'.");
+
+	if (p_path.get_extension().to_lower() == "json") {
+		f->store_string(get_chrome_trace());
+	} else {
+		f->store_string(get_collapsed_stacks());
+	}
+	return OK;
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+
+// Low overhead alternative to the instrumenting profiler. A background thread ticks at a fixed interval,
+// and each thread running GDScript notices the ticks when it enters, leaves or moves to another line in a
+// function, and charges them to its current call stack. Stacks are aggregated per function and line, and
+// can be exported as collapsed stacks (for flame graphs) or in the Chrome trace event format.
+class GDScriptSamplingProfiler {
+	struct Frame {
+		GDScriptFunction *function = nullptr;
+		int *line = nullptr;
+	};
+
+	struct Sample {
+		uint64_t timestamp = 0;
+		uint64_t thread_id = 0;
+		uint64_t weight = 0;
+		uint32_t stack = 0;
+	};
+
+	static SafeFlag active;
+	static SafeNumeric<uint64_t> tick;
+	static thread_local uint64_t thread_tick;
+	static thread_local LocalVector<Frame> thread_frames;
+
+	static Mutex mutex;
+	static Thread sampler_thread;
+	static SafeFlag sampler_exit;
+	static uint64_t interval_usec;
+	static uint64_t start_time;
+
+	// Stacks are interned, samples refer to them by index.
+	static HashMap<String, uint32_t> stack_indices;
+	static LocalVector<String> stacks;
+	static LocalVector<uint64_t> stack_weights;
+	static LocalVector<Sample> samples;
+
+	static void _sampler_thread_func(void *p_userdata);
+	static void _take_sample();
+
+public:
+	_FORCE_INLINE_ static bool is_active() { return active.is_set(); }
+
+	// Charges the ticks elapsed since the last poll to the current stack, must be called before it changes.
+	_FORCE_INLINE_ static void poll() {
+		if (unlikely(tick.get() != thread_tick)) {
+			_take_sample();
+		}
+	}
+
+	_FORCE_INLINE_ static void enter_function(GDScriptFunction *p_function, int *p_line) {
+		if (thread_frames.is_empty()) {
+			// Don't charge the time this thread spent outside of GDScript.
+			thread_tick = tick.get();
+		} else {
+			poll();
+		}
+		thread_frames.push_back({ p_function, p_line });
+	}
+
+	_FORCE_INLINE_ static void exit_function() {
+		poll();
+		thread_frames.resize(thread_frames.size() - 1);
+	}
+
+	static void start(uint64_t p_interval_usec);
+	static void stop();
+	static void clear();
+
+	static uint64_t get_sample_count();
+	static String get_collapsed_stacks();
+	static String get_chrome_trace();
+	static Error save(const String &p_path);
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
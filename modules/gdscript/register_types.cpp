@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -84,14 +85,17 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
+	bool script_bytecode_cache = false;
 
 protected:
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		script_bytecode_cache = false;
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			script_bytecode_cache = preset->is_script_bytecode_cache_enabled();
 		}
 	}
 
@@ -114,6 +118,22 @@ protected:
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (script_bytecode_cache) {
+			Error err = OK;
+			Ref<GDScript> script = GDScriptCache::get_full_script(p_path, err);
+			if (err != OK || script.is_null()) {
+				return;
+			}
+
+			String cache_error;
+			Vector<uint8_t> cache = GDScriptBytecodeCache::serialize(script, file, &cache_error);
+			if (cache.is_empty()) {
+				print_verbose(vformat(R"(GDScript: Not caching the bytecode of "%s": %s)", p_path, cache_error));
+				return;
+			}
+			add_file(GDScriptBytecodeCache::get_cache_path(p_path), cache, false);
+		}
 	}
 
 public:
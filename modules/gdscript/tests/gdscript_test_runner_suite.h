@@ -33,7 +33,17 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_sampling_profiler.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -70,6 +80,409 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+static Ref<GDScript> load_script_from_bytecode_cache(const Vector<uint8_t> &p_binary_tokens, const Vector<uint8_t> &p_cache) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_binary_tokens_source(p_binary_tokens);
+	gdscript->set_bytecode_cache_source(p_cache);
+	ERR_PRINT_OFF;
+	gdscript->reload();
+	ERR_PRINT_ON;
+	return gdscript;
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache") {
+	const String source = R"(
+extends RefCounted
+
+const SCALE = 3
+const NAMES: Array[String] = ["a", "b"]
+
+class Counter:
+	var count := 0
+
+	func add(amount: int) -> void:
+		count += amount
+
+static var instances := 0
+var values: Array[int] = [1, 2, 3]
+
+func _init():
+	instances += 1
+	var counter := Counter.new()
+	for value in values:
+		counter.add(value * SCALE)
+	var untyped = counter.count
+	untyped = untyped + 0.5
+	var doubled := values.map(func(v): return v * 2)
+	set_meta("result", [counter.count, untyped, doubled, NAMES.size(), str(Vector2(3, 4).length()), abs(-4), instances])
+)";
+	const Vector<uint8_t> binary_tokens = GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	REQUIRE(!binary_tokens.is_empty());
+
+	Ref<GDScript> compiled = memnew(GDScript);
+	compiled->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error error = compiled->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	String cache_error;
+	const Vector<uint8_t> cache = GDScriptBytecodeCache::serialize(compiled, binary_tokens, &cache_error);
+	REQUIRE_MESSAGE(!cache.is_empty(), vformat("The compiled script should be serialized (%s).", cache_error));
+
+	Ref<RefCounted> expected = memnew(RefCounted);
+	expected->set_script(compiled);
+	const Array expected_result = expected->get_meta("result");
+	REQUIRE(expected_result.size() == 7);
+	CHECK(int(expected_result[0]) == 18);
+	CHECK(double(expected_result[1]) == 18.5);
+	CHECK(Array(expected_result[2]).size() == 3);
+	CHECK(int(expected_result[3]) == 2);
+	CHECK(String(expected_result[4]) == "5");
+	CHECK(int(expected_result[5]) == 4);
+	CHECK(int(expected_result[6]) == 1);
+
+	SUBCASE("Restored script behaves like the compiled one") {
+		Ref<GDScript> restored = memnew(GDScript);
+		restored->set_binary_tokens_source(binary_tokens);
+		CHECK_MESSAGE(GDScriptBytecodeCache::load(restored.ptr(), cache) == OK, "The cache should be accepted for the tokens it was made from.");
+		CHECK(restored->is_valid());
+		CHECK(restored->get_member_functions().has("_init"));
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(restored);
+		CHECK(Array(ref_counted->get_meta("result")) == expected_result);
+	}
+
+	SUBCASE("Reloading consumes the cache") {
+		Ref<GDScript> restored = load_script_from_bytecode_cache(binary_tokens, cache);
+		REQUIRE(restored->is_valid());
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(restored);
+		CHECK(Array(ref_counted->get_meta("result")) == expected_result);
+	}
+
+	SUBCASE("Mismatching or damaged caches are rejected") {
+		const Vector<uint8_t> other_tokens = GDScriptTokenizerBuffer::parse_code_string(source + "\nvar extra = 1\n", GDScriptTokenizerBuffer::COMPRESS_NONE);
+		Ref<GDScript> other = memnew(GDScript);
+		other->set_binary_tokens_source(other_tokens);
+		CHECK(GDScriptBytecodeCache::load(other.ptr(), cache) != OK);
+
+		Vector<uint8_t> damaged = cache;
+		damaged.write[damaged.size() / 2] ^= 0xFF;
+		Ref<GDScript> restored = memnew(GDScript);
+		restored->set_binary_tokens_source(binary_tokens);
+		CHECK(GDScriptBytecodeCache::load(restored.ptr(), damaged) != OK);
+		CHECK(GDScriptBytecodeCache::load(restored.ptr(), damaged.slice(0, damaged.size() / 2)) != OK);
+
+		// Falls back to compiling the tokens.
+		restored = load_script_from_bytecode_cache(binary_tokens, damaged);
+		REQUIRE(restored->is_valid());
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(restored);
+		CHECK(Array(ref_counted->get_meta("result")) == expected_result);
+	}
+
+	SUBCASE("Exported scripts are loaded from the cache next to their binary tokens") {
+		// The cache is made from a script that doesn't behave like the tokens, to tell which one was loaded.
+		const Vector<uint8_t> exported_tokens = GDScriptTokenizerBuffer::parse_code_string(source.replace("const SCALE = 3", "const SCALE = 4"), GDScriptTokenizerBuffer::COMPRESS_NONE);
+		const String export_dir = TestUtils::get_temp_path("gdscript_bytecode_cache");
+		DirAccess::make_dir_recursive_absolute(export_dir);
+
+		const String cached_path = export_dir.path_join("cached.gdc");
+		Ref<FileAccess> f = FileAccess::open(cached_path, FileAccess::WRITE);
+		f->store_buffer(exported_tokens);
+		f = FileAccess::open(GDScriptBytecodeCache::get_cache_path(cached_path), FileAccess::WRITE);
+		f->store_buffer(GDScriptBytecodeCache::serialize(compiled, exported_tokens));
+
+		// A cache made for other tokens must be ignored.
+		const String stale_path = export_dir.path_join("stale.gdc");
+		f = FileAccess::open(stale_path, FileAccess::WRITE);
+		f->store_buffer(exported_tokens);
+		f = FileAccess::open(GDScriptBytecodeCache::get_cache_path(stale_path), FileAccess::WRITE);
+		f->store_buffer(cache);
+		f.unref();
+
+		Error err = OK;
+		ERR_PRINT_OFF;
+		Ref<GDScript> cached = GDScriptCache::get_full_script(cached_path, err);
+		ERR_PRINT_ON;
+		REQUIRE(err == OK);
+		REQUIRE(cached->is_valid());
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(cached);
+		CHECK_MESSAGE(int(Array(ref_counted->get_meta("result"))[0]) == 18, "The script should be restored from its bytecode cache.");
+
+		ERR_PRINT_OFF;
+		Ref<GDScript> stale = GDScriptCache::get_full_script(stale_path, err);
+		ERR_PRINT_ON;
+		REQUIRE(err == OK);
+		REQUIRE(stale->is_valid());
+		ref_counted = memnew(RefCounted);
+		ref_counted->set_script(stale);
+		CHECK_MESSAGE(int(Array(ref_counted->get_meta("result"))[0]) == 24, "The script should be compiled from its binary tokens.");
+
+		ref_counted.unref();
+		GDScriptCache::remove_script(cached_path);
+		GDScriptCache::remove_script(stale_path);
+		Ref<DirAccess> dir = DirAccess::open(export_dir);
+		if (dir.is_valid()) {
+			dir->erase_contents_recursive();
+		}
+	}
+
+	SUBCASE("Caches are rejected when a script they depend on changes") {
+		const String export_dir = TestUtils::get_temp_path("gdscript_bytecode_cache_dependencies");
+		DirAccess::make_dir_recursive_absolute(export_dir);
+		const String base_path = export_dir.path_join("base.gd");
+		const String derived_path = export_dir.path_join("derived.gd");
+
+		Ref<FileAccess> f = FileAccess::open(base_path, FileAccess::WRITE);
+		f->store_string("extends RefCounted\n\nvar a := 1\nvar b := 2\n");
+		const String derived_source = "extends \"base.gd\"\n\nfunc _init():\n\tset_meta(\"result\", b)\n";
+		f = FileAccess::open(derived_path, FileAccess::WRITE);
+		f->store_string(derived_source);
+		f.unref();
+
+		Error err = OK;
+		ERR_PRINT_OFF;
+		Ref<GDScript> derived = GDScriptCache::get_full_script(derived_path, err);
+		ERR_PRINT_ON;
+		REQUIRE(err == OK);
+		const Vector<uint8_t> derived_tokens = GDScriptTokenizerBuffer::parse_code_string(derived_source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+		const Vector<uint8_t> derived_cache = GDScriptBytecodeCache::serialize(derived, derived_tokens, &cache_error);
+		REQUIRE_MESSAGE(!derived_cache.is_empty(), vformat("The derived script should be serialized (%s).", cache_error));
+
+		Ref<GDScript> restored = memnew(GDScript);
+		restored->set_binary_tokens_source(derived_tokens);
+		CHECK_MESSAGE(GDScriptBytecodeCache::load(restored.ptr(), derived_cache) == OK, "The cache should be accepted while its base is unchanged.");
+
+		// A new member shifts the indices of the inherited ones the cached bytecode uses.
+		f = FileAccess::open(base_path, FileAccess::WRITE);
+		f->store_string("extends RefCounted\n\nvar c := 0\nvar a := 1\nvar b := 2\n");
+		f.unref();
+		GDScriptCache::remove_script(base_path);
+
+		restored = memnew(GDScript);
+		restored->set_binary_tokens_source(derived_tokens);
+		CHECK_MESSAGE(GDScriptBytecodeCache::load(restored.ptr(), derived_cache) == ERR_FILE_UNRECOGNIZED, "The cache should be rejected once its base changed.");
+
+		restored.unref();
+		derived.unref();
+		GDScriptCache::remove_script(derived_path);
+		GDScriptCache::remove_script(base_path);
+		Ref<DirAccess> dir = DirAccess::open(export_dir);
+		if (dir.is_valid()) {
+			dir->erase_contents_recursive();
+		}
+	}
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Bytecode cache loading time" * doctest::skip()) {
+	String large_source = "extends RefCounted\n";
+	for (int i = 0; i < 200; i++) {
+		large_source += vformat("\nfunc f%d(a: int, b):\n\tvar c := a * %d\n\tif b:\n\t\tc += len(str(b))\n\treturn [c, str(c), Vector2(c, a).normalized()]\n", i, i);
+	}
+	const Vector<uint8_t> large_tokens = GDScriptTokenizerBuffer::parse_code_string(large_source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+
+	Ref<GDScript> large = memnew(GDScript);
+	large->set_binary_tokens_source(large_tokens);
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	ERR_PRINT_OFF;
+	large->reload();
+	ERR_PRINT_ON;
+	const uint64_t compile_time = OS::get_singleton()->get_ticks_usec() - begin;
+	REQUIRE(large->is_valid());
+
+	const Vector<uint8_t> large_cache = GDScriptBytecodeCache::serialize(large, large_tokens);
+	REQUIRE(!large_cache.is_empty());
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Ref<GDScript> restored = load_script_from_bytecode_cache(large_tokens, large_cache);
+	const uint64_t cache_time = OS::get_singleton()->get_ticks_usec() - begin;
+	REQUIRE(restored->is_valid());
+
+	MESSAGE(vformat("Loading 200 functions: %d usec compiling binary tokens, %d usec from the bytecode cache.", compile_time, cache_time));
+}
+
+// Writes a project where `main.gd` preloads `p_groups` scripts, each preloading `p_scripts_per_group` other scripts.
+static String write_synthetic_script_project(const String &p_dir, int p_groups, int p_scripts_per_group) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+
+	String main_source = "extends RefCounted\n";
+	String main_total = "\nfunc total() -> int:\n\tvar result := 0\n";
+	for (int i = 0; i < p_groups; i++) {
+		String group_source = "extends RefCounted\n";
+		String group_total = "\nfunc total() -> int:\n\tvar result := 0\n";
+		for (int j = 0; j < p_scripts_per_group; j++) {
+			const int id = i * p_scripts_per_group + j;
+			const String leaf_source = vformat("extends RefCounted\n\nconst ID = %d\n\nfunc value(x: int) -> int:\n\tvar total := x\n\tfor n in ID %% 7:\n\t\ttotal += n * x\n\treturn total + ID\n", id);
+			Ref<FileAccess> f = FileAccess::open(p_dir.path_join(vformat("leaf_%d.gd", id)), FileAccess::WRITE);
+			f->store_string(leaf_source);
+
+			group_source += vformat("const Leaf%d = preload(\"leaf_%d.gd\")\n", j, id);
+			group_total += vformat("\tresult += Leaf%d.new().value(%d)\n", j, j);
+		}
+		Ref<FileAccess> f = FileAccess::open(p_dir.path_join(vformat("group_%d.gd", i)), FileAccess::WRITE);
+		f->store_string(group_source + group_total + "\treturn result\n");
+
+		main_source += vformat("const Group%d = preload(\"group_%d.gd\")\n", i, i);
+		main_total += vformat("\tresult += Group%d.new().total()\n", i);
+	}
+
+	const String main_path = p_dir.path_join("main.gd");
+	Ref<FileAccess> f = FileAccess::open(main_path, FileAccess::WRITE);
+	f->store_string(main_source + main_total + "\treturn result\n");
+	return main_path;
+}
+
+static int load_synthetic_script_project(const String &p_main_path, uint64_t &r_usec) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Error err = OK;
+	Ref<GDScript> main = GDScriptCache::get_full_script(p_main_path, err);
+	r_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	REQUIRE_MESSAGE(err == OK, "The synthetic project should load successfully.");
+	REQUIRE(main->is_valid());
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(main);
+	Callable::CallError call_error;
+	return instance->callp("total", nullptr, 0, call_error);
+}
+
+// Loads the same synthetic project with dependencies parsed serially then in parallel, and checks that both behave the same.
+static void compare_synthetic_script_project_loading(const String &p_name, int p_groups, int p_scripts_per_group, uint64_t &r_serial_usec, uint64_t &r_parallel_usec) {
+	const String project_dir = TestUtils::get_temp_path(p_name);
+	const String serial_main = write_synthetic_script_project(project_dir.path_join("serial"), p_groups, p_scripts_per_group);
+	const String parallel_main = write_synthetic_script_project(project_dir.path_join("parallel"), p_groups, p_scripts_per_group);
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	const bool was_enabled = language->is_threaded_dependency_parsing_enabled();
+
+	language->set_threaded_dependency_parsing_enabled(false);
+	const int serial_result = load_synthetic_script_project(serial_main, r_serial_usec);
+
+	language->set_threaded_dependency_parsing_enabled(true);
+	const int parallel_result = load_synthetic_script_project(parallel_main, r_parallel_usec);
+
+	language->set_threaded_dependency_parsing_enabled(was_enabled);
+
+	CHECK(serial_result > 0);
+	CHECK_MESSAGE(parallel_result == serial_result, "Scripts parsed ahead of the analyzer should behave the same.");
+
+	Ref<DirAccess> dir = DirAccess::open(project_dir);
+	if (dir.is_valid()) {
+		dir->erase_contents_recursive();
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Parallel dependency parsing") {
+	uint64_t serial_time = 0;
+	uint64_t parallel_time = 0;
+	compare_synthetic_script_project_loading("gdscript_parallel_loading", 3, 8, serial_time, parallel_time);
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Parallel dependency parsing of a large project" * doctest::skip()) {
+	// 9 groups of 110 scripts, plus the groups and the main script, make a project of 1000 scripts.
+	uint64_t serial_time = 0;
+	uint64_t parallel_time = 0;
+	compare_synthetic_script_project_loading("gdscript_parallel_loading_benchmark", 9, 110, serial_time, parallel_time);
+
+	MESSAGE(vformat("Loading 1000 scripts: %d usec parsing dependencies serially, %d usec in parallel.", serial_time, parallel_time));
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func busy(msec: int) -> int:
+	var total := 0
+	var end := Time.get_ticks_msec() + msec
+	while Time.get_ticks_msec() < end:
+		total += 1
+	return total
+
+func _init():
+	set_meta("total", busy(50))
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	GDScriptSamplingProfiler::clear();
+	GDScriptSamplingProfiler::start(100);
+	CHECK(GDScriptSamplingProfiler::is_active());
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	GDScriptSamplingProfiler::stop();
+	CHECK_FALSE(GDScriptSamplingProfiler::is_active());
+
+	CHECK(int(ref_counted->get_meta("total")) > 0);
+	CHECK_MESSAGE(GDScriptSamplingProfiler::get_sample_count() > 0, "Running the script for 50 msec should be sampled.");
+
+	const String collapsed = GDScriptSamplingProfiler::get_collapsed_stacks();
+	const Vector<String> lines = collapsed.strip_edges().split("\n");
+	REQUIRE(lines.size() > 0);
+	bool busy_sampled = false;
+	for (const String &line : lines) {
+		// The caller comes first, and every frame names a line.
+		CHECK(line.begins_with("_init ("));
+		CHECK(line.get_slice(" ", line.get_slice_count(" ") - 1).to_int() > 0);
+		busy_sampled = busy_sampled || line.contains(";busy (");
+	}
+	CHECK_MESSAGE(busy_sampled, "Most of the time is spent in the called function.");
+
+	JSON json;
+	REQUIRE(json.parse(GDScriptSamplingProfiler::get_chrome_trace()) == OK);
+	const Dictionary trace = json.get_data();
+	CHECK(Dictionary(trace["stackFrames"]).size() > 0);
+	CHECK(Array(trace["samples"]).size() > 0);
+
+	// Nothing is sampled once stopped.
+	const uint64_t sample_count = GDScriptSamplingProfiler::get_sample_count();
+	Ref<RefCounted> other = memnew(RefCounted);
+	other->set_script(gdscript);
+	CHECK(GDScriptSamplingProfiler::get_sample_count() == sample_count);
+
+	GDScriptSamplingProfiler::clear();
+	CHECK(GDScriptSamplingProfiler::get_collapsed_stacks().is_empty());
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+var value = 0
+
+func bump(obj):
+	obj.value = obj.value + 1
+
+func _init():
+	for i in 1000:
+		bump(self)
+	set_meta("value", value)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	GDScriptLanguage::get_singleton()->reset_inline_cache_statistics();
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	CHECK(int(ref_counted->get_meta("value")) == 1000);
+
+	// The call, get and set sites only miss the first time, as the receiver is always the same.
+	const GDScriptInlineCache::Statistics stats = GDScriptLanguage::get_singleton()->get_inline_cache_statistics();
+	CHECK(stats.hits >= 3 * 999);
+	CHECK(stats.misses < stats.hits / 100);
+	CHECK(stats.monomorphic >= 3);
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
@@ -0,0 +1,100 @@
+# Untyped accesses and calls go through per-site inline caches, which must behave
+# the same as the regular lookup whatever mix of receivers a site sees.
+
+class A:
+	var value = 1
+	func get_value():
+		return value
+
+class B:
+	var other = 0
+	var value = 2
+	func get_value():
+		return value * 10
+
+class C extends A:
+	func get_value():
+		return -value
+
+class WithSetter:
+	var value = 0:
+		set(new_value):
+			value = new_value * 2
+	func get_value():
+		return value
+
+class Typed:
+	var value: float = 0.0
+
+class Dynamic:
+	func _get(property):
+		if property == &"value":
+			return 42
+		return null
+
+class Named extends Resource:
+	pass
+
+func read(obj):
+	return obj.value
+
+func write(obj, new_value):
+	obj.value = new_value
+
+func call_get_value(obj):
+	return obj.get_value()
+
+func write_typed(obj, new_value):
+	obj.value = new_value
+
+func read_dynamic(obj):
+	return obj.value
+
+func read_x(vector):
+	return vector.x
+
+func with_x(vector, x):
+	vector.x = x
+	return vector
+
+func read_name(obj):
+	return obj.resource_name
+
+func write_name(obj, new_name):
+	obj.resource_name = new_name
+
+func call_get_name(obj):
+	return obj.get_name()
+
+func double(x):
+	return x * 2
+
+func test():
+	var objects = [A.new(), B.new(), C.new(), WithSetter.new()]
+	for step in 2:
+		for obj in objects:
+			write(obj, 3 + step)
+			print(read(obj), " ", call_get_value(obj))
+
+	# Values of another type are converted by the regular path.
+	var typed = Typed.new()
+	write_typed(typed, 1.5)
+	print(typed.value)
+	write_typed(typed, 2)
+	print(typed.value)
+
+	var dynamic = Dynamic.new()
+	for i in 2:
+		print(read_dynamic(dynamic) + i)
+
+	for vector in [Vector2(1, 2), Vector3(3, 4, 5), Vector2i(6, 7), Vector2(8, 9)]:
+		print(read_x(vector))
+		print(with_x(vector, 10))
+
+	for obj in [Resource.new(), Named.new()]:
+		for i in 2:
+			write_name(obj, "name %d" % i)
+			print(read_name(obj), " ", call_get_name(obj))
+
+	for i in 3:
+		print(double(i))
@@ -0,0 +1,51 @@
+# Hot functions get some typed instruction sequences fused into superinstructions
+# after `gdscript/runtime/superinstruction_call_threshold` calls (1000 by default).
+# Their results must not change once that happens.
+
+const CALLS = 1500
+
+func sum_while(n: int) -> int:
+	var i := 0
+	var total := 0
+	while i < n:
+		total += i * 3 + 1
+		i += 1
+	return total
+
+func count_outside(values: PackedFloat64Array, low: float, high: float) -> int:
+	var count := 0
+	for value in values:
+		if value < low or value > high:
+			count += 1
+	return count
+
+func lerp_steps(from: Vector2, to: Vector2, steps: int) -> Vector2:
+	var result := from
+	var step := 0
+	while not step >= steps:
+		result = result + (to - from) / float(steps)
+		step += 1
+	return result
+
+func test():
+	var values := PackedFloat64Array([-2.0, -0.5, 0.0, 0.5, 1.5, 3.0])
+	var first_sum := sum_while(50)
+	var first_count := count_outside(values, -1.0, 1.0)
+	var first_lerp := lerp_steps(Vector2(), Vector2(10, 20), 4)
+
+	var mismatches := 0
+	for _i in CALLS:
+		if sum_while(50) != first_sum:
+			mismatches += 1
+		if count_outside(values, -1.0, 1.0) != first_count:
+			mismatches += 1
+		if lerp_steps(Vector2(), Vector2(10, 20), 4) != first_lerp:
+			mismatches += 1
+
+	print(first_sum)
+	print(first_count)
+	print(first_lerp)
+	print(sum_while(50))
+	print(count_outside(values, -1.0, 1.0))
+	print(lerp_steps(Vector2(), Vector2(10, 20), 4))
+	print(mismatches)
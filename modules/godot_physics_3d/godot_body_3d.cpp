@@ -40,6 +40,17 @@ void GodotBody3D::_mass_properties_changed() {
 	}
 }
 
+void GodotBody3D::_broadphase_sleep_changed() {
+	if (get_space() && !broadphase_sleep_update_list.in_list()) {
+		get_space()->body_add_to_broadphase_sleep_update_list(&broadphase_sleep_update_list);
+	}
+}
+
+void GodotBody3D::update_broadphase_sleep() {
+	// Only rigid bodies are frozen out of the broadphase, kinematic bodies can be moved at any time.
+	_set_sleeping(!active && mode >= PhysicsServer3D::BODY_MODE_RIGID);
+}
+
 void GodotBody3D::_update_transform_dependent() {
 	center_of_mass = get_transform().basis.xform(center_of_mass_local);
 	principal_inertia_axes = get_transform().basis * principal_inertia_axes_local;
@@ -187,6 +198,8 @@ void GodotBody3D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	_broadphase_sleep_changed();
 }
 
 void GodotBody3D::set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value) {
@@ -336,6 +349,8 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 			set_active(true);
 		}
 	}
+
+	_broadphase_sleep_changed();
 }
 
 PhysicsServer3D::BodyMode GodotBody3D::get_mode() const {
@@ -448,12 +463,16 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 		if (direct_state_query_list.in_list()) {
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
 		}
+		if (broadphase_sleep_update_list.in_list()) {
+			get_space()->body_remove_from_broadphase_sleep_update_list(&broadphase_sleep_update_list);
+		}
 	}
 
 	_set_space(p_space);
 
 	if (get_space()) {
 		_mass_properties_changed();
+		_broadphase_sleep_changed();
 
 		if (active && !active_list.in_list()) {
 			get_space()->body_add_to_active_list(&active_list);
@@ -827,7 +846,8 @@ GodotBody3D::GodotBody3D() :
 		GodotCollisionObject3D(TYPE_BODY),
 		active_list(this),
 		mass_properties_update_list(this),
-		direct_state_query_list(this) {
+		direct_state_query_list(this),
+		broadphase_sleep_update_list(this) {
 	_set_static(false);
 }
 
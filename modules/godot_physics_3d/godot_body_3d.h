@@ -99,6 +99,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 	SelfList<GodotBody3D> active_list;
 	SelfList<GodotBody3D> mass_properties_update_list;
 	SelfList<GodotBody3D> direct_state_query_list;
+	SelfList<GodotBody3D> broadphase_sleep_update_list;
 
 	VSet<RID> exceptions;
 	bool omit_force_integration = false;
@@ -109,6 +110,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool first_time_kinematic = false;
 
 	void _mass_properties_changed();
+	void _broadphase_sleep_changed();
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
 
@@ -305,6 +307,7 @@ public:
 	void set_space(GodotSpace3D *p_space) override;
 
 	void update_mass_properties();
+	void update_broadphase_sleep();
 	void reset_mass_properties();
 
 	_FORCE_INLINE_ real_t get_inv_mass() const { return _inv_mass; }
@@ -59,22 +59,40 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.normal = (p_point_A - p_point_B).normalized();
 	contact.used = true;
 
-	// Attempt to determine if the contact will be reused.
+	// Attempt to determine if the contact will be reused, from the closest previous contact that hasn't been matched
+	// by another new contact yet.
 	real_t contact_recycle_radius = space->get_contact_recycle_radius();
+	real_t contact_recycle_radius2 = contact_recycle_radius * contact_recycle_radius;
 
+	int recycled = -1;
+	real_t recycled_distance = 0.0;
 	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
-				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			c = contact;
-			return;
+		const Contact &c = contacts[i];
+		if (c.used) {
+			continue;
+		}
+		real_t distance_A = c.local_A.distance_squared_to(local_A);
+		real_t distance_B = c.local_B.distance_squared_to(local_B);
+		if (distance_A < contact_recycle_radius2 && distance_B < contact_recycle_radius2) {
+			if (recycled == -1 || distance_A + distance_B < recycled_distance) {
+				recycled = i;
+				recycled_distance = distance_A + distance_B;
+			}
 		}
 	}
 
+	if (recycled != -1) {
+		Contact &c = contacts[recycled];
+		contact.acc_normal_impulse = c.acc_normal_impulse;
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		// Keep the friction impulse in the tangent plane of the new normal.
+		contact.acc_tangent_impulse = c.acc_tangent_impulse - contact.normal * contact.normal.dot(c.acc_tangent_impulse);
+		contact.reused = true;
+		c = contact;
+		return;
+	}
+
 	// Figure out if the contact amount must be reduced to fit the new contact.
 	if (new_index == MAX_CONTACTS) {
 		// Remove the contact with the minimum depth.
@@ -260,7 +278,8 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 	return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
-bool GodotBodyPair3D::setup(real_t p_step) {
+// Everything setup() does before the narrowphase. Returns false if the pair doesn't need it.
+bool GodotBodyPair3D::_setup_begin(Transform3D &r_xform_A, Transform3D &r_xform_B) {
 	check_ccd = false;
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
@@ -287,17 +306,17 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 
 	const Vector3 &offset_A = A->get_transform().get_origin();
 	Transform3D xform_Au = Transform3D(A->get_transform().basis, Vector3());
-	Transform3D xform_A = xform_Au * A->get_shape_transform(shape_A);
+	r_xform_A = xform_Au * A->get_shape_transform(shape_A);
 
 	Transform3D xform_Bu = B->get_transform();
 	xform_Bu.origin -= offset_A;
-	Transform3D xform_B = xform_Bu * B->get_shape_transform(shape_B);
-
-	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
-	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
+	r_xform_B = xform_Bu * B->get_shape_transform(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	return true;
+}
 
+// Everything setup() does after the narrowphase set `collided`.
+bool GodotBodyPair3D::_setup_end() {
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
 			check_ccd = true;
@@ -315,7 +334,45 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	return true;
 }
 
+bool GodotBodyPair3D::setup(real_t p_step) {
+	Transform3D xform_A;
+	Transform3D xform_B;
+	if (!_setup_begin(xform_A, xform_B)) {
+		return false;
+	}
+
+	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
+	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
+
+	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+
+	return _setup_end();
+}
+
+GodotCollisionSolver3D::BatchType GodotBodyPair3D::get_setup_batch_type() const {
+	return GodotCollisionSolver3D::get_batch_type(A->get_shape(shape_A)->get_type(), B->get_shape(shape_B)->get_type());
+}
+
+bool GodotBodyPair3D::setup_batch_begin(real_t p_step, GodotCollisionSolver3D::BatchPair &r_pair) {
+	Transform3D xform_A;
+	Transform3D xform_B;
+	if (!_setup_begin(xform_A, xform_B)) {
+		return false;
+	}
+
+	GodotCollisionSolver3D::make_batch_pair(r_pair, A->get_shape(shape_A), xform_A, B->get_shape(shape_B), xform_B, _contact_added_callback, this);
+	return true;
+}
+
+void GodotBodyPair3D::setup_batch_end(real_t p_step, const GodotCollisionSolver3D::BatchPair &p_pair) {
+	collided = p_pair.collided;
+	_setup_end();
+}
+
 bool GodotBodyPair3D::pre_solve(real_t p_step) {
+	active_contact_count = 0;
+	reused_contact_count = 0;
+
 	if (!collided) {
 		if (check_ccd) {
 			const Vector3 &offset_A = A->get_transform().get_origin();
@@ -434,6 +491,11 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		c.active = true;
 		do_process = true;
 
+		active_contact_count++;
+		if (c.reused) {
+			reused_contact_count++;
+		}
+
 		if (collide_A) {
 			A->apply_impulse(-j_vec, c.rA + A->get_center_of_mass());
 		}
@@ -453,7 +515,27 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	return do_process;
 }
 
+bool GodotBodyPair3D::is_pre_solve_thread_safe() const {
+#ifdef DEBUG_ENABLED
+	if (space->is_debugging_contacts()) {
+		return false;
+	}
+#endif
+
+	// Static bodies are shared between islands, so contacts can't be reported to them concurrently.
+	if (A->get_mode() == PhysicsServer3D::BODY_MODE_STATIC && A->can_report_contacts()) {
+		return false;
+	}
+	if (B->get_mode() == PhysicsServer3D::BODY_MODE_STATIC && B->can_report_contacts()) {
+		return false;
+	}
+
+	return true;
+}
+
 void GodotBodyPair3D::solve(real_t p_step) {
+	solve_impulse = 0.0;
+
 	if (!collided) {
 		return;
 	}
@@ -544,6 +626,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 				B->apply_impulse(j, c.rB + B->get_center_of_mass());
 			}
 			c.acc_impulse -= j;
+			solve_impulse += Math::abs(c.acc_normal_impulse - jnOld);
 
 			c.active = true;
 		}
@@ -591,6 +674,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 				B->apply_impulse(jt, c.rB + B->get_center_of_mass());
 			}
 			c.acc_impulse -= jt;
+			solve_impulse += jt.length();
 
 			c.active = true;
 		}
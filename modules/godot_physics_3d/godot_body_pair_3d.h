@@ -56,6 +56,7 @@ protected:
 		real_t depth = 0.0;
 		bool active = false;
 		bool used = false;
+		bool reused = false; // Kept from the previous step with its accumulated impulses.
 		Vector3 rA, rB; // Offset in world orientation with respect to center of mass
 	};
 
@@ -63,11 +64,22 @@ protected:
 	bool collided = false;
 	bool check_ccd = false;
 
+	uint32_t active_contact_count = 0;
+	uint32_t reused_contact_count = 0;
+	real_t solve_impulse = 0.0;
+
 	GodotSpace3D *space = nullptr;
 
 	GodotBodyContact3D(GodotBody3D **p_body_ptr = nullptr, int p_body_count = 0) :
 			GodotConstraint3D(p_body_ptr, p_body_count) {
 	}
+
+public:
+	virtual void accumulate_contact_counts(uint32_t &r_active_count, uint32_t &r_reused_count) const override {
+		r_active_count += active_contact_count;
+		r_reused_count += reused_contact_count;
+	}
+	virtual real_t get_solve_impulse() const override { return solve_impulse; }
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
@@ -102,12 +114,18 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
+	bool _setup_begin(Transform3D &r_xform_A, Transform3D &r_xform_B);
+	bool _setup_end();
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
 	virtual bool setup(real_t p_step) override;
+	virtual GodotCollisionSolver3D::BatchType get_setup_batch_type() const override;
+	virtual bool setup_batch_begin(real_t p_step, GodotCollisionSolver3D::BatchPair &r_pair) override;
+	virtual void setup_batch_end(real_t p_step, const GodotCollisionSolver3D::BatchPair &p_pair) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
+	virtual bool is_pre_solve_thread_safe() const override;
 
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
@@ -33,6 +33,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/math_funcs.h"
+#include "core/templates/local_vector.h"
 
 class GodotCollisionObject3D;
 
@@ -44,6 +45,9 @@ public:
 
 	typedef uint32_t ID;
 
+	// Per thread scratch space for the concurrent cull functions.
+	typedef LocalVector<uint32_t, uint32_t, true> CullScratch;
+
 	typedef void *(*PairCallback)(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_userdata);
 	typedef void (*UnpairCallback)(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_userdata);
 
@@ -51,6 +55,8 @@ public:
 	virtual ID create(GodotCollisionObject3D *p_object_, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) = 0;
 	virtual void move(ID p_id, const AABB &p_aabb) = 0;
 	virtual void set_static(ID p_id, bool p_static) = 0;
+	// Sleeping objects only pair with static and awake objects.
+	virtual void set_sleeping(ID p_id, bool p_sleeping) = 0;
 	virtual void remove(ID p_id) = 0;
 
 	virtual GodotCollisionObject3D *get_object(ID p_id) const = 0;
@@ -61,11 +67,21 @@ public:
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 
+	// Can be called from several threads at once, as long as the broadphase is not modified meanwhile.
+	virtual int cull_segment_concurrent(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, CullScratch &r_scratch, int *p_result_indices = nullptr) = 0;
+	virtual int cull_aabb_concurrent(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, CullScratch &r_scratch, int *p_result_indices = nullptr) = 0;
+
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
 	virtual void update() = 0;
 
+	// Counters accumulated since the last call to reset_counters().
+	virtual uint32_t get_move_count() const = 0;
+	virtual uint32_t get_pair_test_count() const = 0;
+	virtual uint32_t get_pair_create_count() const = 0;
+	virtual void reset_counters() = 0;
+
 	virtual ~GodotBroadPhase3D();
 };
 
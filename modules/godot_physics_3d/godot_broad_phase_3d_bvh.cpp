@@ -34,7 +34,7 @@
 
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? (TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING);
 	ID oid = bvh.create(p_object, true, tree_id, tree_collision_mask, p_aabb, p_subindex); // Pair everything, don't care?
 	return oid + 1;
 }
@@ -42,15 +42,26 @@ GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_
 void GodotBroadPhase3DBVH::move(ID p_id, const AABB &p_aabb) {
 	ERR_FAIL_COND(!p_id);
 	bvh.move(p_id - 1, p_aabb);
+	move_count++;
 }
 
 void GodotBroadPhase3DBVH::set_static(ID p_id, bool p_static) {
 	ERR_FAIL_COND(!p_id);
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? (TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING);
 	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
 }
 
+void GodotBroadPhase3DBVH::set_sleeping(ID p_id, bool p_sleeping) {
+	ERR_FAIL_COND(!p_id);
+	ERR_FAIL_COND(bvh.get_tree_id(p_id - 1) == TREE_STATIC);
+	uint32_t tree_id = p_sleeping ? TREE_SLEEPING : TREE_DYNAMIC;
+	// Sleeping objects keep colliding with each other, so the pairs of a resting pile
+	// survive (warm starting, and waking the whole island through its constraints).
+	// The pair check forced by the tree change finds the existing pairs again and creates none.
+	bvh.set_tree(p_id - 1, tree_id, TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING, false);
+}
+
 void GodotBroadPhase3DBVH::remove(ID p_id) {
 	ERR_FAIL_COND(!p_id);
 	bvh.erase(p_id - 1);
@@ -86,8 +97,17 @@ int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D *
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+int GodotBroadPhase3DBVH::cull_segment_concurrent(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, CullScratch &r_scratch, int *p_result_indices) {
+	return bvh.cull_segment_concurrent(p_from, p_to, p_results, p_max_results, r_scratch, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
+int GodotBroadPhase3DBVH::cull_aabb_concurrent(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, CullScratch &r_scratch, int *p_result_indices) {
+	return bvh.cull_aabb_concurrent(p_aabb, p_results, p_max_results, r_scratch, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
 void *GodotBroadPhase3DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject3D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject3D *p_object_B, int subindex_B) {
 	GodotBroadPhase3DBVH *bpo = static_cast<GodotBroadPhase3DBVH *>(self);
+	bpo->pair_create_count++;
 	if (!bpo->pair_callback) {
 		return nullptr;
 	}
@@ -118,6 +138,12 @@ void GodotBroadPhase3DBVH::update() {
 	bvh.update();
 }
 
+void GodotBroadPhase3DBVH::reset_counters() {
+	move_count = 0;
+	pair_create_count = 0;
+	bvh.reset_pair_test_count();
+}
+
 GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 	return memnew(GodotBroadPhase3DBVH);
 }
@@ -138,6 +138,28 @@ void GodotCollisionObject3D::_set_static(bool p_static) {
 		const Shape &s = shapes[i];
 		if (s.bpid > 0) {
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (!_static && _sleeping) {
+				space->get_broadphase()->set_sleeping(s.bpid, true);
+			}
+		}
+	}
+}
+
+void GodotCollisionObject3D::_set_sleeping(bool p_sleeping) {
+	if (_sleeping == p_sleeping) {
+		return;
+	}
+
+	_sleeping = p_sleeping;
+
+	if (!space || _static) {
+		return;
+	}
+
+	for (int i = 0; i < get_shape_count(); i++) {
+		const Shape &s = shapes[i];
+		if (s.bpid > 0) {
+			space->get_broadphase()->set_sleeping(s.bpid, _sleeping);
 		}
 	}
 }
@@ -176,6 +198,9 @@ void GodotCollisionObject3D::_update_shapes() {
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (!_static && _sleeping) {
+				space->get_broadphase()->set_sleeping(s.bpid, true);
+			}
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
@@ -203,6 +228,9 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (!_static && _sleeping) {
+				space->get_broadphase()->set_sleeping(s.bpid, true);
+			}
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
@@ -35,6 +35,8 @@
 
 #include "gjk_epa.h"
 
+#include "core/math/geometry_3d.h"
+
 #define collision_solver sat_calculate_penetration
 //#define collision_solver gjk_epa_calculate_penetration
 
@@ -358,6 +360,213 @@ bool GodotCollisionSolver3D::solve_concave(const GodotShape3D *p_shape_A, const
 	return cinfo.collided;
 }
 
+GodotCollisionSolver3D::BatchType GodotCollisionSolver3D::get_batch_type(PhysicsServer3D::ShapeType p_type_A, PhysicsServer3D::ShapeType p_type_B) {
+	if (p_type_A > p_type_B) {
+		SWAP(p_type_A, p_type_B);
+	}
+
+	if (p_type_A == PhysicsServer3D::SHAPE_SPHERE) {
+		switch (p_type_B) {
+			case PhysicsServer3D::SHAPE_SPHERE:
+				return BATCH_SPHERE_SPHERE;
+			case PhysicsServer3D::SHAPE_BOX:
+				return BATCH_SPHERE_BOX;
+			case PhysicsServer3D::SHAPE_CAPSULE:
+				return BATCH_SPHERE_CAPSULE;
+			default:
+				break;
+		}
+	} else if (p_type_A == PhysicsServer3D::SHAPE_CAPSULE && p_type_B == PhysicsServer3D::SHAPE_CAPSULE) {
+		return BATCH_CAPSULE_CAPSULE;
+	}
+
+	return BATCH_TYPE_MAX;
+}
+
+void GodotCollisionSolver3D::make_batch_pair(BatchPair &r_pair, const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata) {
+	r_pair.swap = p_shape_A->get_type() > p_shape_B->get_type();
+	if (r_pair.swap) {
+		r_pair.shape_A = p_shape_B;
+		r_pair.shape_B = p_shape_A;
+		r_pair.transform_A = p_transform_B;
+		r_pair.transform_B = p_transform_A;
+	} else {
+		r_pair.shape_A = p_shape_A;
+		r_pair.shape_B = p_shape_B;
+		r_pair.transform_A = p_transform_A;
+		r_pair.transform_B = p_transform_B;
+	}
+	r_pair.result_callback = p_result_callback;
+	r_pair.userdata = p_userdata;
+	r_pair.collided = false;
+}
+
+// Number of pairs solved together. The shape data is gathered into arrays of this size so the distance
+// tests run as plain loops over all of them, which the compiler can vectorize.
+#define BATCH_WIDTH 8
+
+// Reports a contact like the SAT solver does, with the normal pointing towards B and the shapes in their original order.
+static _FORCE_INLINE_ void _report_batch_contact(const GodotCollisionSolver3D::BatchPair &p_pair, const Vector3 &p_point_A, const Vector3 &p_point_B, Vector3 p_normal) {
+	if (p_normal.dot(p_point_B - p_point_A) < 0) {
+		p_normal = -p_normal;
+	}
+	if (p_pair.swap) {
+		p_pair.result_callback(p_point_B, 0, p_point_A, 0, -p_normal, p_pair.userdata);
+	} else {
+		p_pair.result_callback(p_point_A, 0, p_point_B, 0, p_normal, p_pair.userdata);
+	}
+}
+
+// Spheres and capsules collide like the spheres around the closest points of their cores (see analytic_sphere_collision()).
+static void _solve_sphere_batch(GodotCollisionSolver3D::BatchType p_type, GodotCollisionSolver3D::BatchPair *p_pairs, uint32_t p_count) {
+	Vector3 origin_A[BATCH_WIDTH];
+	Vector3 origin_B[BATCH_WIDTH];
+	real_t radius_A[BATCH_WIDTH];
+	real_t radius_B[BATCH_WIDTH];
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		const GodotCollisionSolver3D::BatchPair &pair = p_pairs[i];
+		const Transform3D &transform_A = pair.transform_A;
+		const Transform3D &transform_B = pair.transform_B;
+
+		switch (p_type) {
+			case GodotCollisionSolver3D::BATCH_SPHERE_SPHERE: {
+				origin_A[i] = transform_A.origin;
+				origin_B[i] = transform_B.origin;
+				radius_A[i] = static_cast<const GodotSphereShape3D *>(pair.shape_A)->get_radius() * transform_A.basis[0].length();
+				radius_B[i] = static_cast<const GodotSphereShape3D *>(pair.shape_B)->get_radius() * transform_B.basis[0].length();
+			} break;
+			case GodotCollisionSolver3D::BATCH_SPHERE_CAPSULE: {
+				const GodotCapsuleShape3D *capsule_B = static_cast<const GodotCapsuleShape3D *>(pair.shape_B);
+				Vector3 capsule_axis = transform_B.basis.get_column(1) * (capsule_B->get_height() * 0.5 - capsule_B->get_radius());
+				Vector3 capsule_segment[2] = { transform_B.origin + capsule_axis, transform_B.origin - capsule_axis };
+				origin_A[i] = transform_A.origin;
+				origin_B[i] = Geometry3D::get_closest_point_to_segment(transform_A.origin, capsule_segment);
+				radius_A[i] = static_cast<const GodotSphereShape3D *>(pair.shape_A)->get_radius() * transform_A.basis[0].length();
+				radius_B[i] = capsule_B->get_radius() * transform_B.basis[0].length();
+			} break;
+			case GodotCollisionSolver3D::BATCH_CAPSULE_CAPSULE: {
+				const GodotCapsuleShape3D *capsule_A = static_cast<const GodotCapsuleShape3D *>(pair.shape_A);
+				const GodotCapsuleShape3D *capsule_B = static_cast<const GodotCapsuleShape3D *>(pair.shape_B);
+				Vector3 capsule_A_axis = transform_A.basis.get_column(1) * (capsule_A->get_height() * 0.5 - capsule_A->get_radius());
+				Vector3 capsule_B_axis = transform_B.basis.get_column(1) * (capsule_B->get_height() * 0.5 - capsule_B->get_radius());
+				Geometry3D::get_closest_points_between_segments(
+						transform_A.origin + capsule_A_axis,
+						transform_A.origin - capsule_A_axis,
+						transform_B.origin + capsule_B_axis,
+						transform_B.origin - capsule_B_axis,
+						origin_A[i],
+						origin_B[i]);
+				radius_A[i] = capsule_A->get_radius() * transform_A.basis[0].length();
+				radius_B[i] = capsule_B->get_radius() * transform_B.basis[0].length();
+			} break;
+			default: {
+				ERR_FAIL();
+			}
+		}
+	}
+
+	real_t b_to_a_x[BATCH_WIDTH];
+	real_t b_to_a_y[BATCH_WIDTH];
+	real_t b_to_a_z[BATCH_WIDTH];
+	real_t b_to_a_length[BATCH_WIDTH];
+	real_t overlap[BATCH_WIDTH];
+	for (uint32_t i = 0; i < p_count; i++) {
+		b_to_a_x[i] = origin_A[i].x - origin_B[i].x;
+		b_to_a_y[i] = origin_A[i].y - origin_B[i].y;
+		b_to_a_z[i] = origin_A[i].z - origin_B[i].z;
+		b_to_a_length[i] = Math::sqrt(b_to_a_x[i] * b_to_a_x[i] + b_to_a_y[i] * b_to_a_y[i] + b_to_a_z[i] * b_to_a_z[i]);
+		overlap[i] = radius_A[i] + radius_B[i] - b_to_a_length[i];
+	}
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (overlap[i] < 0) {
+			continue;
+		}
+		GodotCollisionSolver3D::BatchPair &pair = p_pairs[i];
+		pair.collided = true;
+		if (!pair.result_callback) {
+			continue;
+		}
+
+		Vector3 b_to_a(b_to_a_x[i], b_to_a_y[i], b_to_a_z[i]);
+		if (b_to_a_length[i] < CMP_EPSILON) {
+			b_to_a = Vector3(0, 1, 0); // Spheres coincident, use arbitrary direction.
+		} else {
+			b_to_a /= b_to_a_length[i];
+		}
+
+		// Starts from the smaller sphere to limit precision errors, like analytic_sphere_collision().
+		if (radius_A[i] < radius_B[i]) {
+			Vector3 point_A = origin_A[i] - b_to_a * radius_A[i];
+			_report_batch_contact(pair, point_A, point_A + b_to_a * overlap[i], b_to_a);
+		} else {
+			Vector3 point_B = origin_B[i] + b_to_a * radius_B[i];
+			_report_batch_contact(pair, point_B - b_to_a * overlap[i], point_B, b_to_a);
+		}
+	}
+}
+
+static void _solve_sphere_box_batch(GodotCollisionSolver3D::BatchPair *p_pairs, uint32_t p_count) {
+	Vector3 nearest[BATCH_WIDTH];
+	real_t radius[BATCH_WIDTH];
+
+	// Point of the box nearest to the center of the sphere.
+	for (uint32_t i = 0; i < p_count; i++) {
+		const GodotCollisionSolver3D::BatchPair &pair = p_pairs[i];
+		Vector3 center = pair.transform_B.affine_inverse().xform(pair.transform_A.origin);
+		Vector3 extents = static_cast<const GodotBoxShape3D *>(pair.shape_B)->get_half_extents();
+		nearest[i] = pair.transform_B.xform(Vector3(MIN(MAX(center.x, -extents.x), extents.x),
+				MIN(MAX(center.y, -extents.y), extents.y),
+				MIN(MAX(center.z, -extents.z), extents.z)));
+		radius[i] = static_cast<const GodotSphereShape3D *>(pair.shape_A)->get_radius() * pair.transform_A.basis[0].length();
+	}
+
+	real_t delta_x[BATCH_WIDTH];
+	real_t delta_y[BATCH_WIDTH];
+	real_t delta_z[BATCH_WIDTH];
+	real_t length[BATCH_WIDTH];
+	for (uint32_t i = 0; i < p_count; i++) {
+		delta_x[i] = nearest[i].x - p_pairs[i].transform_A.origin.x;
+		delta_y[i] = nearest[i].y - p_pairs[i].transform_A.origin.y;
+		delta_z[i] = nearest[i].z - p_pairs[i].transform_A.origin.z;
+		length[i] = Math::sqrt(delta_x[i] * delta_x[i] + delta_y[i] * delta_y[i] + delta_z[i] * delta_z[i]);
+	}
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (length[i] > radius[i]) {
+			continue;
+		}
+		GodotCollisionSolver3D::BatchPair &pair = p_pairs[i];
+		pair.collided = true;
+		if (!pair.result_callback) {
+			continue;
+		}
+
+		Vector3 axis;
+		if (length[i] == 0) {
+			// The box passes through the sphere center. Select an axis based on the box's center.
+			axis = (pair.transform_B.origin - nearest[i]).normalized();
+		} else {
+			axis = Vector3(delta_x[i], delta_y[i], delta_z[i]) / length[i];
+		}
+		_report_batch_contact(pair, pair.transform_A.origin + radius[i] * axis, nearest[i], axis);
+	}
+}
+
+void GodotCollisionSolver3D::solve_static_batch(BatchType p_type, BatchPair *p_pairs, uint32_t p_count) {
+	ERR_FAIL_INDEX(p_type, BATCH_TYPE_MAX);
+
+	for (uint32_t first = 0; first < p_count; first += BATCH_WIDTH) {
+		const uint32_t count = MIN(p_count - first, (uint32_t)BATCH_WIDTH);
+		if (p_type == BATCH_SPHERE_BOX) {
+			_solve_sphere_box_batch(p_pairs + first, count);
+		} else {
+			_solve_sphere_batch(p_type, p_pairs + first, count);
+		}
+	}
+}
+
 bool GodotCollisionSolver3D::solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis, real_t p_margin_A, real_t p_margin_B) {
 	PhysicsServer3D::ShapeType type_A = p_shape_A->get_type();
 	PhysicsServer3D::ShapeType type_B = p_shape_B->get_type();
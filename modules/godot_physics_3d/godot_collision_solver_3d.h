@@ -50,6 +50,31 @@ private:
 	static bool solve_distance_world_boundary(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B);
 
 public:
+	// Pairs of primitive shapes whose narrowphase can run in batches, see solve_static_batch().
+	enum BatchType {
+		BATCH_SPHERE_SPHERE,
+		BATCH_SPHERE_BOX,
+		BATCH_SPHERE_CAPSULE,
+		BATCH_CAPSULE_CAPSULE,
+		BATCH_TYPE_MAX, // Not batched, solved with solve_static().
+	};
+
+	struct BatchPair {
+		const GodotShape3D *shape_A = nullptr;
+		const GodotShape3D *shape_B = nullptr;
+		Transform3D transform_A;
+		Transform3D transform_B;
+		CallbackResult result_callback = nullptr;
+		void *userdata = nullptr;
+		bool swap = false; // The shapes are sorted by type, results are swapped back when reported.
+		bool collided = false;
+	};
+
+	static BatchType get_batch_type(PhysicsServer3D::ShapeType p_type_A, PhysicsServer3D::ShapeType p_type_B);
+	static void make_batch_pair(BatchPair &r_pair, const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata);
+	// Same results as solve_static() without margins, for pairs that are all of the given type.
+	static void solve_static_batch(BatchType p_type, BatchPair *p_pairs, uint32_t p_count);
+
 	static bool solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis = nullptr, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis = nullptr);
 };
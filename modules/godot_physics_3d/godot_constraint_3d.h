@@ -31,6 +31,8 @@
 #ifndef GODOT_CONSTRAINT_3D_H
 #define GODOT_CONSTRAINT_3D_H
 
+#include "godot_collision_solver_3d.h"
+
 class GodotBody3D;
 class GodotSoftBody3D;
 
@@ -72,9 +74,27 @@ public:
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
 	virtual bool setup(real_t p_step) = 0;
+
+	// Collision pairs between primitive shapes can run their narrowphase in batches with other pairs of the same
+	// type (see GodotCollisionSolver3D::solve_static_batch()). setup() is then replaced by setup_batch_begin(),
+	// which returns false if the pair doesn't need the narrowphase, and setup_batch_end() once it was solved.
+	virtual GodotCollisionSolver3D::BatchType get_setup_batch_type() const { return GodotCollisionSolver3D::BATCH_TYPE_MAX; }
+	virtual bool setup_batch_begin(real_t p_step, GodotCollisionSolver3D::BatchPair &r_pair) { return false; }
+	virtual void setup_batch_end(real_t p_step, const GodotCollisionSolver3D::BatchPair &p_pair) {}
+
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// Adds the number of contacts solved in the current step, and how many of them were kept from the previous step
+	// to warm start the solver. Only valid after pre_solve().
+	virtual void accumulate_contact_counts(uint32_t &r_active_count, uint32_t &r_reused_count) const {}
+	// Magnitude of the contact impulses applied by the last call to solve(), used to measure solver convergence.
+	virtual real_t get_solve_impulse() const { return 0.0; }
+
+	// Whether pre_solve() only writes to the constraint and to bodies of its own island, so that it can run on a
+	// separate thread from other islands. Only valid after setup().
+	virtual bool is_pre_solve_thread_safe() const { return false; }
+
 	virtual ~GodotConstraint3D() {}
 };
 
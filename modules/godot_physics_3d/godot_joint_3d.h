@@ -75,6 +75,7 @@ protected:
 public:
 	virtual bool setup(real_t p_step) override { return false; }
 	virtual bool pre_solve(real_t p_step) override { return true; }
+	virtual bool is_pre_solve_thread_safe() const override { return true; }
 	virtual void solve(real_t p_step) override {}
 
 	void copy_settings_from(GodotJoint3D *p_joint) {
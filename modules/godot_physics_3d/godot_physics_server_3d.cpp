@@ -1638,11 +1638,23 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	contact_count = 0;
+	reused_contact_count = 0;
+	solver_iterations_to_converge = 0;
+	broadphase_move_count = 0;
+	broadphase_pair_test_count = 0;
+	broadphase_pair_create_count = 0;
 	for (const GodotSpace3D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		contact_count += E->get_contact_count();
+		reused_contact_count += E->get_reused_contact_count();
+		solver_iterations_to_converge = MAX(solver_iterations_to_converge, E->get_solver_iterations_to_converge());
+		broadphase_move_count += E->get_broadphase_move_count();
+		broadphase_pair_test_count += E->get_broadphase_pair_test_count();
+		broadphase_pair_create_count += E->get_broadphase_pair_create_count();
 	}
 }
 
@@ -1719,6 +1731,24 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_CONTACT_COUNT: {
+			return contact_count;
+		} break;
+		case INFO_REUSED_CONTACT_COUNT: {
+			return reused_contact_count;
+		} break;
+		case INFO_SOLVER_ITERATIONS_TO_CONVERGE: {
+			return solver_iterations_to_converge;
+		} break;
+		case INFO_BROADPHASE_MOVES: {
+			return broadphase_move_count;
+		} break;
+		case INFO_BROADPHASE_PAIR_TESTS: {
+			return broadphase_pair_test_count;
+		} break;
+		case INFO_BROADPHASE_PAIRS_CREATED: {
+			return broadphase_pair_create_count;
+		} break;
 	}
 
 	return 0;
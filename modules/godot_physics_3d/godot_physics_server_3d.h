@@ -48,6 +48,12 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int contact_count = 0;
+	int reused_contact_count = 0;
+	int solver_iterations_to_converge = 0;
+	int broadphase_move_count = 0;
+	int broadphase_pair_test_count = 0;
+	int broadphase_pair_create_count = 0;
 
 	bool using_threads = false;
 	bool doing_sync = false;
@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -108,13 +109,26 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, nullptr);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, QueryBuffers *p_buffers) {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	GodotCollisionObject3D **query_results = space->intersection_query_results;
+	int *query_subindex_results = space->intersection_query_subindex_results;
+	int amount = 0;
+	if (p_buffers) {
+		query_results = p_buffers->results.ptr();
+		query_subindex_results = p_buffers->subindex_results.ptr();
+		amount = space->broadphase->cull_segment_concurrent(begin, end, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, p_buffers->cull_scratch, query_subindex_results);
+	} else {
+		amount = space->broadphase->cull_segment(begin, end, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, query_subindex_results);
+	}
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -126,21 +140,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(query_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(query_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = query_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = query_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -205,6 +219,57 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+uint32_t GodotPhysicsDirectSpaceState3D::_prepare_batch(uint32_t p_count, uint32_t &r_task_size) {
+	uint32_t thread_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+	uint32_t task_count = CLAMP(p_count / BATCH_QUERIES_PER_TASK_MIN, 1u, thread_count);
+	r_task_size = (p_count + task_count - 1) / task_count;
+
+	if (batch_buffers.size() < task_count) {
+		uint32_t old_size = batch_buffers.size();
+		batch_buffers.resize(task_count);
+		for (uint32_t i = old_size; i < task_count; i++) {
+			batch_buffers[i].results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+			batch_buffers[i].subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+		}
+	}
+
+	return task_count;
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_task(uint32_t p_task_index, RayBatch *p_batch) {
+	QueryBuffers *buffers = &batch_buffers[p_task_index];
+	uint32_t begin = p_task_index * p_batch->task_size;
+	uint32_t end = MIN(begin + p_batch->task_size, p_batch->count);
+	for (uint32_t i = begin; i < end; i++) {
+		p_batch->collided[i] = _intersect_ray(*p_batch->parameters, p_batch->from[i], p_batch->to[i], p_batch->results[i], buffers);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.collided = r_collided;
+	batch.count = p_count;
+
+	// The space can't change until the batch is done, so the broadphase can be culled without locking.
+	uint32_t task_count = _prepare_batch(p_count, batch.task_size);
+	if (task_count == 1) {
+		_intersect_ray_batch_task(0, &batch);
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_task, &batch, task_count, -1, true, SNAME("Physics3DIntersectRayBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -264,51 +329,64 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	return _cast_motion(p_parameters, shape, p_parameters.transform, p_parameters.motion, p_closest_safe, p_closest_unsafe, r_info, nullptr);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_cast_motion(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, QueryBuffers *p_buffers) {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	GodotCollisionObject3D **query_results = space->intersection_query_results;
+	int *query_subindex_results = space->intersection_query_subindex_results;
+	int amount = 0;
+	if (p_buffers) {
+		query_results = p_buffers->results.ptr();
+		query_subindex_results = p_buffers->subindex_results.ptr();
+		amount = space->broadphase->cull_aabb_concurrent(aabb, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, p_buffers->cull_scratch, query_subindex_results);
+	} else {
+		amount = space->broadphase->cull_aabb(aabb, query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, query_subindex_results);
+	}
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
-	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+	mshape.shape = p_shape;
+	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
-	Vector3 motion_normal = p_parameters.motion.normalized();
+	Vector3 motion_normal = p_motion.normalized();
 
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(query_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = query_results[i];
+		int shape_idx = query_subindex_results[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -319,11 +397,11 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 		for (int j = 0; j < 8; j++) { //steps should be customizable..
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
-			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+			mshape.motion = xform_inv.basis.xform(p_motion * fraction);
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -379,6 +457,49 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	return true;
 }
 
+void GodotPhysicsDirectSpaceState3D::_cast_motion_batch_task(uint32_t p_task_index, MotionBatch *p_batch) {
+	QueryBuffers *buffers = &batch_buffers[p_task_index];
+	Transform3D transform = p_batch->parameters->transform;
+	uint32_t begin = p_task_index * p_batch->task_size;
+	uint32_t end = MIN(begin + p_batch->task_size, p_batch->count);
+	for (uint32_t i = begin; i < end; i++) {
+		transform.origin = p_batch->origins[i];
+		_cast_motion(*p_batch->parameters, p_batch->shape, transform, p_batch->motions[i], p_batch->closest_safe[i], p_batch->closest_unsafe[i], nullptr, buffers);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::cast_motion_batch(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	MotionBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	batch.count = p_count;
+
+	uint32_t task_count = _prepare_batch(p_count, batch.task_size);
+	if (task_count == 1) {
+		_cast_motion_batch_task(0, &batch);
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_cast_motion_batch_task, &batch, task_count, -1, true, SNAME("Physics3DCastMotionBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -1128,6 +1249,14 @@ void GodotSpace3D::body_remove_from_state_query_list(SelfList<GodotBody3D> *p_bo
 	state_query_list.remove(p_body);
 }
 
+void GodotSpace3D::body_add_to_broadphase_sleep_update_list(SelfList<GodotBody3D> *p_body) {
+	broadphase_sleep_update_list.add(p_body);
+}
+
+void GodotSpace3D::body_remove_from_broadphase_sleep_update_list(SelfList<GodotBody3D> *p_body) {
+	broadphase_sleep_update_list.remove(p_body);
+}
+
 void GodotSpace3D::area_add_to_monitor_query_list(SelfList<GodotArea3D> *p_area) {
 	monitor_query_list.add(p_area);
 }
@@ -1183,6 +1312,14 @@ void GodotSpace3D::setup() {
 }
 
 void GodotSpace3D::update() {
+	// Islands that fell asleep or woke up since the last update are moved between
+	// broadphase trees all at once, before pairs are checked again.
+	while (broadphase_sleep_update_list.first()) {
+		GodotBody3D *body = broadphase_sleep_update_list.first()->self();
+		broadphase_sleep_update_list.remove(broadphase_sleep_update_list.first());
+		body->update_broadphase_sleep();
+	}
+
 	broadphase->update();
 }
 
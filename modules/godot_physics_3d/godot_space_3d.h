@@ -41,18 +41,63 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		BATCH_QUERIES_PER_TASK_MIN = 32,
+	};
+
+	// Broadphase results of one task of a batched query, so that tasks don't share the space buffers.
+	struct QueryBuffers {
+		LocalVector<GodotCollisionObject3D *> results;
+		LocalVector<int> subindex_results;
+		GodotBroadPhase3D::CullScratch cull_scratch;
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *results = nullptr;
+		bool *collided = nullptr;
+		uint32_t count = 0;
+		uint32_t task_size = 0;
+	};
+
+	struct MotionBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape3D *shape = nullptr;
+		const Vector3 *origins = nullptr;
+		const Vector3 *motions = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+		uint32_t count = 0;
+		uint32_t task_size = 0;
+	};
+
+	LocalVector<QueryBuffers> batch_buffers;
+
+	uint32_t _prepare_batch(uint32_t p_count, uint32_t &r_task_size);
+
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, QueryBuffers *p_buffers);
+	bool _cast_motion(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, QueryBuffers *p_buffers);
+
+	void _intersect_ray_batch_task(uint32_t p_task_index, RayBatch *p_batch);
+	void _cast_motion_batch_task(uint32_t p_task_index, MotionBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
+	virtual void cast_motion_batch(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
@@ -82,6 +127,7 @@ private:
 	SelfList<GodotBody3D>::List active_list;
 	SelfList<GodotBody3D>::List mass_properties_update_list;
 	SelfList<GodotBody3D>::List state_query_list;
+	SelfList<GodotBody3D>::List broadphase_sleep_update_list;
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
@@ -118,6 +164,12 @@ private:
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int contact_count = 0;
+	int reused_contact_count = 0;
+	int solver_iterations_to_converge = 0;
+	int broadphase_move_count = 0;
+	int broadphase_pair_test_count = 0;
+	int broadphase_pair_create_count = 0;
 
 	RID static_global_body;
 
@@ -144,6 +196,9 @@ public:
 	void body_add_to_state_query_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_state_query_list(SelfList<GodotBody3D> *p_body);
 
+	void body_add_to_broadphase_sleep_update_list(SelfList<GodotBody3D> *p_body);
+	void body_remove_from_broadphase_sleep_update_list(SelfList<GodotBody3D> *p_body);
+
 	void area_add_to_monitor_query_list(SelfList<GodotArea3D> *p_area);
 	void area_remove_from_monitor_query_list(SelfList<GodotArea3D> *p_area);
 	void area_add_to_moved_list(SelfList<GodotArea3D> *p_area);
@@ -191,6 +246,24 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	void set_contact_count(int p_contact_count) { contact_count = p_contact_count; }
+	int get_contact_count() const { return contact_count; }
+
+	void set_reused_contact_count(int p_reused_contact_count) { reused_contact_count = p_reused_contact_count; }
+	int get_reused_contact_count() const { return reused_contact_count; }
+
+	void set_solver_iterations_to_converge(int p_iterations) { solver_iterations_to_converge = p_iterations; }
+	int get_solver_iterations_to_converge() const { return solver_iterations_to_converge; }
+
+	void set_broadphase_move_count(int p_move_count) { broadphase_move_count = p_move_count; }
+	int get_broadphase_move_count() const { return broadphase_move_count; }
+
+	void set_broadphase_pair_test_count(int p_pair_test_count) { broadphase_pair_test_count = p_pair_test_count; }
+	int get_broadphase_pair_test_count() const { return broadphase_pair_test_count; }
+
+	void set_broadphase_pair_create_count(int p_pair_create_count) { broadphase_pair_create_count = p_pair_create_count; }
+	int get_broadphase_pair_create_count() const { return broadphase_pair_create_count; }
+
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
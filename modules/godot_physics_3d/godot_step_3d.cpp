@@ -40,6 +40,10 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define SETUP_BATCH_SIZE_MAX 64
+
+// Ratio of the first iteration's contact impulses under which an island is considered converged.
+#define SOLVER_CONVERGENCE_RATIO 0.01
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,22 +116,91 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
-	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
-	constraint->setup(delta);
+void GodotStep3D::_sort_setup_constraints() {
+	uint32_t constraint_count = all_constraints.size();
+	setup_batch_types.resize(constraint_count);
+
+	uint32_t type_counts[GodotCollisionSolver3D::BATCH_TYPE_MAX + 1] = {};
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotCollisionSolver3D::BatchType type = all_constraints[constraint_index]->get_setup_batch_type();
+		setup_batch_types[constraint_index] = type;
+		type_counts[type]++;
+	}
+
+	uint32_t offset = 0;
+	for (int type = 0; type <= GodotCollisionSolver3D::BATCH_TYPE_MAX; type++) {
+		setup_batch_type_offsets[type] = offset;
+		offset += type_counts[type];
+	}
+	setup_batch_type_offsets[GodotCollisionSolver3D::BATCH_TYPE_MAX + 1] = offset;
+
+	uint32_t next_indices[GodotCollisionSolver3D::BATCH_TYPE_MAX + 1];
+	memcpy(next_indices, setup_batch_type_offsets, sizeof(next_indices));
+	setup_constraints.resize(constraint_count);
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		setup_constraints[next_indices[setup_batch_types[constraint_index]]++] = all_constraints[constraint_index];
+	}
+}
+
+void GodotStep3D::_setup_constraint_batch(uint32_t p_batch_index, void *p_userdata) {
+	const uint32_t begin = p_batch_index * setup_batch_size;
+	const uint32_t end = MIN(begin + setup_batch_size, setup_constraints.size());
+
+	GodotCollisionSolver3D::BatchPair pairs[SETUP_BATCH_SIZE_MAX];
+	GodotConstraint3D *pair_constraints[SETUP_BATCH_SIZE_MAX];
+
+	for (int type = 0; type <= GodotCollisionSolver3D::BATCH_TYPE_MAX; type++) {
+		const uint32_t type_begin = MAX(begin, setup_batch_type_offsets[type]);
+		const uint32_t type_end = MIN(end, setup_batch_type_offsets[type + 1]);
+		if (type_begin >= type_end) {
+			continue;
+		}
+
+		if (type == GodotCollisionSolver3D::BATCH_TYPE_MAX) {
+			for (uint32_t constraint_index = type_begin; constraint_index < type_end; ++constraint_index) {
+				setup_constraints[constraint_index]->setup(delta);
+			}
+			continue;
+		}
+
+		// The narrowphase of all the pairs of this type runs at once, between the two halves of their setup.
+		uint32_t pair_count = 0;
+		for (uint32_t constraint_index = type_begin; constraint_index < type_end; ++constraint_index) {
+			GodotConstraint3D *constraint = setup_constraints[constraint_index];
+			if (constraint->setup_batch_begin(delta, pairs[pair_count])) {
+				pair_constraints[pair_count++] = constraint;
+			}
+		}
+		GodotCollisionSolver3D::solve_static_batch((GodotCollisionSolver3D::BatchType)type, pairs, pair_count);
+		for (uint32_t pair_index = 0; pair_index < pair_count; ++pair_index) {
+			pair_constraints[pair_index]->setup_batch_end(delta, pairs[pair_index]);
+		}
+	}
 }
 
-void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
+	uint32_t island_active_contact_count = 0;
+	uint32_t island_reused_contact_count = 0;
 	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
 		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
 		if (p_constraint_island[constraint_index]->pre_solve(delta)) {
 			// Keep this constraint for solving.
 			p_constraint_island[valid_constraint_count++] = constraint;
+			constraint->accumulate_contact_counts(island_active_contact_count, island_reused_contact_count);
 		}
 	}
 	p_constraint_island.resize(valid_constraint_count);
+
+	if (island_active_contact_count > 0) {
+		active_contact_count.add(island_active_contact_count);
+		reused_contact_count.add(island_reused_contact_count);
+	}
+}
+
+void GodotStep3D::_pre_solve_concurrent_island(uint32_t p_index, void *p_userdata) {
+	_pre_solve_island(constraint_islands[concurrent_pre_solve_islands[p_index]]);
 }
 
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
@@ -135,12 +208,28 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 
 	int current_priority = 1;
 
+	// Number of iterations after which the contact impulses became negligible compared to the first iteration.
+	uint32_t converged_iterations = 0;
+	real_t first_iteration_impulse = 0.0;
+
 	uint32_t constraint_count = constraint_island.size();
 	while (constraint_count > 0) {
 		for (int i = 0; i < iterations; i++) {
 			// Go through all iterations.
+			real_t iteration_impulse = 0.0;
 			for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-				constraint_island[constraint_index]->solve(delta);
+				GodotConstraint3D *constraint = constraint_island[constraint_index];
+				constraint->solve(delta);
+				iteration_impulse += constraint->get_solve_impulse();
+			}
+
+			if (current_priority == 1 && converged_iterations == 0) {
+				if (i == 0) {
+					first_iteration_impulse = iteration_impulse;
+				}
+				if (iteration_impulse <= first_iteration_impulse * SOLVER_CONVERGENCE_RATIO) {
+					converged_iterations = i + 1;
+				}
 			}
 		}
 
@@ -156,6 +245,8 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 		}
 		constraint_count = priority_constraint_count;
 	}
+
+	island_solver_iterations[p_island_index] = converged_iterations > 0 ? converged_iterations : iterations;
 }
 
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
@@ -343,8 +434,15 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
-	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	// Constraints are set up in batches to reduce the per-task overhead of the many cheap collision pairs,
+	// while keeping enough batches to spread them over all threads. Pairs of primitive shapes are sorted
+	// by type first, so that the batches can run their narrowphase together.
+	_sort_setup_constraints();
+	uint32_t total_constraint_count = setup_constraints.size();
+	uint32_t thread_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+	setup_batch_size = CLAMP(total_constraint_count / (thread_count * 4), 1u, (uint32_t)SETUP_BATCH_SIZE_MAX);
+	uint32_t setup_batch_count = (total_constraint_count + setup_batch_size - 1) / setup_batch_size;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint_batch, nullptr, setup_batch_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -355,18 +453,57 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
+	// Islands only share static bodies and the space, so they can be pre-solved on threads unless one of their
+	// constraints writes to those (contact reporting on static bodies, area monitoring, debug contacts).
+	// WARNING: The other islands don't run on threads, because they involve thread-unsafe processing.
+	active_contact_count.set(0);
+	reused_contact_count.set(0);
+
+	concurrent_pre_solve_islands.clear();
 	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		const LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_index];
+		bool thread_safe = true;
+		for (const GodotConstraint3D *constraint : constraint_island) {
+			if (!constraint->is_pre_solve_thread_safe()) {
+				thread_safe = false;
+				break;
+			}
+		}
+		if (thread_safe) {
+			concurrent_pre_solve_islands.push_back(island_index);
+		}
+	}
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_pre_solve_concurrent_island, nullptr, concurrent_pre_solve_islands.size(), -1, true, SNAME("Physics3DConstraintPreSolveIslands"));
+
+	uint32_t concurrent_index = 0;
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		if (concurrent_index < concurrent_pre_solve_islands.size() && concurrent_pre_solve_islands[concurrent_index] == island_index) {
+			++concurrent_index;
+			continue;
+		}
 		_pre_solve_island(constraint_islands[island_index]);
 	}
 
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	p_space->set_contact_count(active_contact_count.get());
+	p_space->set_reused_contact_count(reused_contact_count.get());
+
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
+	island_solver_iterations.resize(island_count);
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	uint32_t max_solver_iterations = 0;
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		max_solver_iterations = MAX(max_solver_iterations, island_solver_iterations[island_index]);
+	}
+	p_space->set_solver_iterations_to_converge((int)max_solver_iterations);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -403,6 +540,16 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	setup_constraints.clear();
+
+	/* BROADPHASE STATISTICS */
+
+	// Counted since the end of the previous step, so changes made by the user between steps are included.
+	GodotBroadPhase3D *broadphase = p_space->get_broadphase();
+	p_space->set_broadphase_move_count(broadphase->get_move_count());
+	p_space->set_broadphase_pair_test_count(broadphase->get_pair_test_count());
+	p_space->set_broadphase_pair_create_count(broadphase->get_pair_create_count());
+	broadphase->reset_counters();
 
 	p_space->unlock();
 	_step++;
@@ -412,6 +559,9 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	setup_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	setup_batch_types.reserve(CONSTRAINT_COUNT_RESERVE);
+	concurrent_pre_solve_islands.reserve(ISLAND_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -34,6 +34,7 @@
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep3D {
 	uint64_t _step = 1;
@@ -44,11 +45,23 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	// Constraints sorted by the type of narrowphase batch they go in, with the index where each type begins.
+	LocalVector<GodotConstraint3D *> setup_constraints;
+	LocalVector<GodotCollisionSolver3D::BatchType> setup_batch_types;
+	uint32_t setup_batch_type_offsets[GodotCollisionSolver3D::BATCH_TYPE_MAX + 2] = {};
+	uint32_t setup_batch_size = 1;
+	LocalVector<uint32_t> concurrent_pre_solve_islands;
+	LocalVector<uint32_t> island_solver_iterations;
+
+	SafeNumeric<uint32_t> active_contact_count;
+	SafeNumeric<uint32_t> reused_contact_count;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
-	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _sort_setup_constraints();
+	void _setup_constraint_batch(uint32_t p_batch_index, void *p_userdata = nullptr);
+	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _pre_solve_concurrent_island(uint32_t p_index, void *p_userdata = nullptr);
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_godot_collision_solver_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_GODOT_COLLISION_SOLVER_3D_H
+#define TEST_GODOT_COLLISION_SOLVER_3D_H
+
+#include "../godot_collision_solver_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotCollisionSolver3D {
+
+struct Contacts {
+	LocalVector<Vector3> points_A;
+	LocalVector<Vector3> points_B;
+	LocalVector<Vector3> normals;
+
+	static void add(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+		Contacts *contacts = static_cast<Contacts *>(p_userdata);
+		contacts->points_A.push_back(p_point_A);
+		contacts->points_B.push_back(p_point_B);
+		contacts->normals.push_back(p_normal);
+	}
+};
+
+// Shapes placed close enough to each other that about half of the pairs collide.
+struct RandomPairs {
+	GodotSphereShape3D sphere;
+	GodotBoxShape3D box;
+	GodotCapsuleShape3D capsule;
+	RandomPCG rng;
+
+	GodotShape3D *get_shape(PhysicsServer3D::ShapeType p_type) {
+		switch (p_type) {
+			case PhysicsServer3D::SHAPE_SPHERE:
+				return &sphere;
+			case PhysicsServer3D::SHAPE_BOX:
+				return &box;
+			default:
+				return &capsule;
+		}
+	}
+
+	Transform3D random_transform() {
+		Basis basis = Basis::from_euler(Vector3(rng.random(-Math_PI, Math_PI), rng.random(-Math_PI, Math_PI), rng.random(-Math_PI, Math_PI)));
+		return Transform3D(basis, Vector3(rng.random(-1.5, 1.5), rng.random(-1.5, 1.5), rng.random(-1.5, 1.5)));
+	}
+
+	RandomPairs() :
+			rng(1234) {
+		sphere.set_data(0.5);
+		box.set_data(Vector3(0.5, 0.25, 0.75));
+		Dictionary capsule_data;
+		capsule_data["radius"] = 0.3;
+		capsule_data["height"] = 1.5;
+		capsule.set_data(capsule_data);
+	}
+};
+
+TEST_CASE("[GodotPhysics3D] Batched narrowphase matches the per-pair one") {
+	RandomPairs random_pairs;
+	const PhysicsServer3D::ShapeType types[] = { PhysicsServer3D::SHAPE_SPHERE, PhysicsServer3D::SHAPE_BOX, PhysicsServer3D::SHAPE_CAPSULE };
+
+	for (PhysicsServer3D::ShapeType type_A : types) {
+		for (PhysicsServer3D::ShapeType type_B : types) {
+			const GodotCollisionSolver3D::BatchType batch_type = GodotCollisionSolver3D::get_batch_type(type_A, type_B);
+			if (batch_type == GodotCollisionSolver3D::BATCH_TYPE_MAX) {
+				continue;
+			}
+			const GodotShape3D *shape_A = random_pairs.get_shape(type_A);
+			const GodotShape3D *shape_B = random_pairs.get_shape(type_B);
+
+			const int pair_count = 100;
+			Transform3D transforms_A[pair_count];
+			Transform3D transforms_B[pair_count];
+			Contacts contacts[pair_count];
+			GodotCollisionSolver3D::BatchPair pairs[pair_count];
+			for (int i = 0; i < pair_count; i++) {
+				transforms_A[i] = random_pairs.random_transform();
+				transforms_B[i] = random_pairs.random_transform();
+				GodotCollisionSolver3D::make_batch_pair(pairs[i], shape_A, transforms_A[i], shape_B, transforms_B[i], Contacts::add, &contacts[i]);
+			}
+			GodotCollisionSolver3D::solve_static_batch(batch_type, pairs, pair_count);
+
+			int collided_count = 0;
+			for (int i = 0; i < pair_count; i++) {
+				Contacts expected;
+				const bool collided = GodotCollisionSolver3D::solve_static(shape_A, transforms_A[i], shape_B, transforms_B[i], Contacts::add, &expected);
+				collided_count += collided;
+
+				CHECK(pairs[i].collided == collided);
+				REQUIRE(contacts[i].points_A.size() == expected.points_A.size());
+				for (uint32_t j = 0; j < expected.points_A.size(); j++) {
+					CHECK(contacts[i].points_A[j].is_equal_approx(expected.points_A[j]));
+					CHECK(contacts[i].points_B[j].is_equal_approx(expected.points_B[j]));
+					CHECK(contacts[i].normals[j].is_equal_approx(expected.normals[j]));
+				}
+			}
+			CHECK_MESSAGE(collided_count > 0, "Some of the random pairs should collide.");
+			CHECK_MESSAGE(collided_count < pair_count, "Some of the random pairs should be apart.");
+		}
+	}
+}
+
+TEST_CASE("[Benchmark][GodotPhysics3D] Batched narrowphase" * doctest::skip()) {
+	RandomPairs random_pairs;
+	const PhysicsServer3D::ShapeType type_pairs[][2] = {
+		{ PhysicsServer3D::SHAPE_SPHERE, PhysicsServer3D::SHAPE_SPHERE },
+		{ PhysicsServer3D::SHAPE_SPHERE, PhysicsServer3D::SHAPE_BOX },
+		{ PhysicsServer3D::SHAPE_SPHERE, PhysicsServer3D::SHAPE_CAPSULE },
+		{ PhysicsServer3D::SHAPE_CAPSULE, PhysicsServer3D::SHAPE_CAPSULE },
+	};
+	const char *type_pair_names[] = { "Sphere/sphere", "Sphere/box", "Sphere/capsule", "Capsule/capsule" };
+	const int pair_count = 4096;
+	const int repeat_count = 100;
+
+	for (int type_pair = 0; type_pair < 4; type_pair++) {
+		const PhysicsServer3D::ShapeType *types = type_pairs[type_pair];
+		const GodotShape3D *shape_A = random_pairs.get_shape(types[0]);
+		const GodotShape3D *shape_B = random_pairs.get_shape(types[1]);
+		LocalVector<Transform3D> transforms_A;
+		LocalVector<Transform3D> transforms_B;
+		for (int i = 0; i < pair_count; i++) {
+			transforms_A.push_back(random_pairs.random_transform());
+			transforms_B.push_back(random_pairs.random_transform());
+		}
+		Contacts contacts;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int repeat = 0; repeat < repeat_count; repeat++) {
+			contacts.points_A.clear();
+			contacts.points_B.clear();
+			contacts.normals.clear();
+			for (int i = 0; i < pair_count; i++) {
+				GodotCollisionSolver3D::solve_static(shape_A, transforms_A[i], shape_B, transforms_B[i], Contacts::add, &contacts);
+			}
+		}
+		const uint64_t per_pair_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		LocalVector<GodotCollisionSolver3D::BatchPair> pairs;
+		pairs.resize(pair_count);
+		const GodotCollisionSolver3D::BatchType batch_type = GodotCollisionSolver3D::get_batch_type(types[0], types[1]);
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int repeat = 0; repeat < repeat_count; repeat++) {
+			contacts.points_A.clear();
+			contacts.points_B.clear();
+			contacts.normals.clear();
+			for (int i = 0; i < pair_count; i++) {
+				GodotCollisionSolver3D::make_batch_pair(pairs[i], shape_A, transforms_A[i], shape_B, transforms_B[i], Contacts::add, &contacts);
+			}
+			GodotCollisionSolver3D::solve_static_batch(batch_type, pairs.ptr(), pair_count);
+		}
+		const uint64_t batched_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%s, %d pairs: %.3f ms one pair at a time, %.3f ms in batches.", type_pair_names[type_pair], pair_count, per_pair_usec / 1000.0 / repeat_count, batched_usec / 1000.0 / repeat_count));
+	}
+}
+
+} // namespace TestGodotCollisionSolver3D
+
+#endif // TEST_GODOT_COLLISION_SOLVER_3D_H
@@ -0,0 +1,247 @@
+/**************************************************************************/
+/*  test_godot_space_3d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_SPACE_3D_H
+#define TEST_GODOT_SPACE_3D_H
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotSpace3D {
+
+// A grid of static boxes, with gaps between them so that some queries miss.
+struct BoxGrid {
+	GodotPhysicsServer3D *physics_server = nullptr;
+	Object *collider = nullptr;
+	RID space;
+	RID box_shape;
+	RID sphere_shape;
+	LocalVector<RID> bodies;
+
+	BoxGrid(int p_size) {
+		physics_server = memnew(GodotPhysicsServer3D);
+		physics_server->init();
+		collider = memnew(Object);
+
+		space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+
+		box_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		sphere_shape = physics_server->sphere_shape_create();
+		physics_server->shape_set_data(sphere_shape, 0.25);
+
+		for (int x = 0; x < p_size; x++) {
+			for (int z = 0; z < p_size; z++) {
+				RID body = physics_server->body_create();
+				physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+				physics_server->body_add_shape(body, box_shape);
+				physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2.0, (x + z) % 3, z * 2.0)));
+				physics_server->body_attach_object_instance_id(body, collider->get_instance_id());
+				physics_server->body_set_space(body, space);
+				bodies.push_back(body);
+			}
+		}
+
+		physics_server->step(1.0 / 60.0);
+	}
+
+	PhysicsDirectSpaceState3D *get_direct_state() {
+		return physics_server->space_get_direct_state(space);
+	}
+
+	// Vertical rays and motions spread over the grid, some through the boxes and some through the gaps.
+	void make_queries(int p_count, PackedVector3Array &r_from, PackedVector3Array &r_to) {
+		r_from.resize(p_count);
+		r_to.resize(p_count);
+		const real_t extent = Math::sqrt((real_t)bodies.size()) * 2.0;
+		for (int i = 0; i < p_count; i++) {
+			const Vector3 position = Vector3(Math::fmod(i * (real_t)0.37, extent), 5.0, Math::fmod(i * (real_t)0.61, extent));
+			r_from.write[i] = position;
+			r_to.write[i] = position - Vector3(0, 10, 0);
+		}
+	}
+
+	~BoxGrid() {
+		for (const RID &body : bodies) {
+			physics_server->free(body);
+		}
+		physics_server->free(sphere_shape);
+		physics_server->free(box_shape);
+		physics_server->free(space);
+		memdelete(collider);
+
+		physics_server->finish();
+		memdelete(physics_server);
+	}
+};
+
+static void check_ray_batch(BoxGrid &p_grid, int p_count) {
+	PackedVector3Array from;
+	PackedVector3Array to;
+	p_grid.make_queries(p_count, from, to);
+
+	PhysicsDirectSpaceState3D *state = p_grid.get_direct_state();
+	REQUIRE(state);
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(p_count);
+	LocalVector<bool> collided;
+	collided.resize(p_count);
+	state->intersect_ray_batch(parameters, from.ptr(), to.ptr(), p_count, results.ptr(), collided.ptr());
+
+	Ref<PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+	const Dictionary batch = state->call(SNAME("intersect_ray_batch"), ray_query, from, to);
+	const PackedVector3Array positions = batch["position"];
+	const PackedInt64Array collider_ids = batch["collider_id"];
+	const Array colliders = batch["collider"];
+	const Array rids = batch["rid"];
+	REQUIRE(positions.size() == p_count);
+	REQUIRE(collider_ids.size() == p_count);
+	REQUIRE(colliders.size() == p_count);
+	REQUIRE(rids.size() == p_count);
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult expected;
+		const bool expected_collided = state->intersect_ray(parameters, expected);
+
+		CHECK(collided[i] == expected_collided);
+		if (!expected_collided || !collided[i]) {
+			CHECK(collider_ids[i] == 0);
+			CHECK(colliders[i].get_type() == Variant::NIL);
+			CHECK_FALSE(RID(rids[i]).is_valid());
+			continue;
+		}
+		hit_count++;
+		CHECK(results[i].position == expected.position);
+		CHECK(results[i].normal == expected.normal);
+		CHECK(results[i].rid == expected.rid);
+		CHECK(results[i].collider_id == expected.collider_id);
+		CHECK(results[i].shape == expected.shape);
+		CHECK(results[i].face_index == expected.face_index);
+
+		CHECK(positions[i] == expected.position);
+		CHECK(ObjectID(uint64_t(collider_ids[i])) == expected.collider_id);
+		CHECK(Object::cast_to<Object>(colliders[i]) == p_grid.collider);
+		CHECK(RID(rids[i]) == expected.rid);
+	}
+	CHECK_MESSAGE(hit_count > 0, "Some rays should hit the boxes.");
+	CHECK_MESSAGE(hit_count < p_count, "Some rays should go through the gaps.");
+}
+
+static void check_motion_batch(BoxGrid &p_grid, int p_count) {
+	PackedVector3Array origins;
+	PackedVector3Array ends;
+	p_grid.make_queries(p_count, origins, ends);
+	PackedVector3Array motions;
+	motions.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		motions.write[i] = ends[i] - origins[i];
+	}
+
+	PhysicsDirectSpaceState3D *state = p_grid.get_direct_state();
+	REQUIRE(state);
+
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	parameters.shape_rid = p_grid.sphere_shape;
+	LocalVector<real_t> closest_safe;
+	closest_safe.resize(p_count);
+	LocalVector<real_t> closest_unsafe;
+	closest_unsafe.resize(p_count);
+	state->cast_motion_batch(parameters, origins.ptr(), motions.ptr(), p_count, closest_safe.ptr(), closest_unsafe.ptr());
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.origin = origins[i];
+		parameters.motion = motions[i];
+		real_t expected_safe = 1.0;
+		real_t expected_unsafe = 1.0;
+		state->cast_motion(parameters, expected_safe, expected_unsafe);
+
+		CHECK(closest_safe[i] == expected_safe);
+		CHECK(closest_unsafe[i] == expected_unsafe);
+		if (expected_unsafe < 1.0) {
+			hit_count++;
+		}
+	}
+	CHECK_MESSAGE(hit_count > 0, "Some motions should hit the boxes.");
+	CHECK_MESSAGE(hit_count < p_count, "Some motions should go through the gaps.");
+}
+
+TEST_CASE("[GodotPhysics3D] Batched queries match individual queries") {
+	BoxGrid grid(8);
+
+	SUBCASE("Small batches are processed in a single task") {
+		check_ray_batch(grid, 20);
+		check_motion_batch(grid, 20);
+	}
+
+	SUBCASE("Large batches are split over several tasks") {
+		// Well above 32 queries per task, the minimum before a batch is split, for every thread.
+		const int count = 32 * 3 * MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) + 7;
+		check_ray_batch(grid, count);
+		check_motion_batch(grid, count);
+	}
+
+	SUBCASE("Arrays of different sizes are rejected") {
+		PackedVector3Array from;
+		PackedVector3Array to;
+		grid.make_queries(8, from, to);
+		to.resize(7);
+
+		PhysicsDirectSpaceState3D *state = grid.get_direct_state();
+		REQUIRE(state);
+
+		Ref<PhysicsRayQueryParameters3D> ray_query;
+		ray_query.instantiate();
+		Ref<PhysicsShapeQueryParameters3D> shape_query;
+		shape_query.instantiate();
+		shape_query->set_shape_rid(grid.sphere_shape);
+
+		ERR_PRINT_OFF;
+		const Dictionary ray_batch = state->call(SNAME("intersect_ray_batch"), ray_query, from, to);
+		const PackedFloat32Array motion_batch = state->call(SNAME("cast_motion_batch"), shape_query, from, to);
+		ERR_PRINT_ON;
+		CHECK(ray_batch.is_empty());
+		CHECK(motion_batch.is_empty());
+	}
+}
+
+} // namespace TestGodotSpace3D
+
+#endif // TEST_GODOT_SPACE_3D_H
@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  test_godot_step_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_STEP_3D_H
+#define TEST_GODOT_STEP_3D_H
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotStep3D {
+
+// A space with separate piles of boxes on a static ground, each pile forming its own island.
+struct BoxPiles {
+	GodotPhysicsServer3D *physics_server = nullptr;
+	RID space;
+	RID box_shape;
+	RID ground_shape;
+	RID ground;
+	LocalVector<RID> bodies;
+
+	BoxPiles(int p_pile_count, int p_boxes_per_pile) {
+		physics_server = memnew(GodotPhysicsServer3D);
+		physics_server->init();
+
+		space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+
+		box_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+		ground_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(ground_shape, Vector3(1000, 1, 1000));
+
+		ground = physics_server->body_create();
+		physics_server->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(ground, ground_shape);
+		physics_server->body_set_state(ground, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+		physics_server->body_set_space(ground, space);
+
+		const int row_size = (int)Math::ceil(Math::sqrt((real_t)p_pile_count));
+		for (int pile = 0; pile < p_pile_count; pile++) {
+			const Vector3 pile_origin = Vector3((pile % row_size) * 4.0, 0.0, (pile / row_size) * 4.0);
+			for (int i = 0; i < p_boxes_per_pile; i++) {
+				RID body = physics_server->body_create();
+				physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+				physics_server->body_add_shape(body, box_shape);
+				physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), pile_origin + Vector3(0, 0.5 + i * 1.01, 0)));
+				physics_server->body_set_space(body, space);
+				bodies.push_back(body);
+			}
+		}
+	}
+
+	void step() {
+		physics_server->step(1.0 / 60.0);
+	}
+
+	~BoxPiles() {
+		for (const RID &body : bodies) {
+			physics_server->free(body);
+		}
+		physics_server->free(ground);
+		physics_server->free(ground_shape);
+		physics_server->free(box_shape);
+		physics_server->free(space);
+
+		physics_server->finish();
+		memdelete(physics_server);
+	}
+};
+
+TEST_CASE("[GodotPhysics3D] Resting contacts are kept across steps to warm start the solver") {
+	BoxPiles piles(1, 3);
+
+	// Let the boxes settle on each other, the bodies fall asleep later.
+	for (int i = 0; i < 20; i++) {
+		piles.step();
+	}
+
+	const int contact_count = piles.physics_server->get_process_info(PhysicsServer3D::INFO_CONTACT_COUNT);
+	const int reused_contact_count = piles.physics_server->get_process_info(PhysicsServer3D::INFO_REUSED_CONTACT_COUNT);
+	const int solver_iterations = piles.physics_server->space_get_param(piles.space, PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS);
+
+	CHECK_MESSAGE(contact_count > 0, "The boxes should rest on each other.");
+	CHECK_MESSAGE(reused_contact_count > 0, "Resting contacts should be reused from the previous step.");
+	CHECK(reused_contact_count <= contact_count);
+	CHECK(piles.physics_server->get_process_info(PhysicsServer3D::INFO_SOLVER_ITERATIONS_TO_CONVERGE) > 0);
+	CHECK(piles.physics_server->get_process_info(PhysicsServer3D::INFO_SOLVER_ITERATIONS_TO_CONVERGE) <= solver_iterations);
+}
+
+TEST_CASE("[GodotPhysics3D] Sleeping bodies are frozen out of the broadphase") {
+	BoxPiles piles(1, 3);
+
+	for (int i = 0; i < 10; i++) {
+		piles.step();
+	}
+	const int awake_collision_pairs = piles.physics_server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS);
+
+	for (const RID &body : piles.bodies) {
+		piles.physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_SLEEPING, true);
+	}
+	piles.step();
+	piles.step();
+
+	CHECK(piles.physics_server->get_process_info(PhysicsServer3D::INFO_BROADPHASE_MOVES) == 0);
+	CHECK(piles.physics_server->get_process_info(PhysicsServer3D::INFO_BROADPHASE_PAIR_TESTS) == 0);
+	CHECK(piles.physics_server->get_process_info(PhysicsServer3D::INFO_BROADPHASE_PAIRS_CREATED) == 0);
+	CHECK_MESSAGE(piles.physics_server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS) == awake_collision_pairs, "Sleeping boxes should stay paired with each other.");
+
+	// Pushing the bottom box wakes up the whole pile through the pairs kept while sleeping.
+	piles.physics_server->body_set_state(piles.bodies[0], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(1, 0, 0));
+	piles.step();
+
+	CHECK(piles.physics_server->get_process_info(PhysicsServer3D::INFO_BROADPHASE_MOVES) > 0);
+	CHECK(piles.physics_server->get_process_info(PhysicsServer3D::INFO_BROADPHASE_PAIRS_CREATED) == 0);
+	for (const RID &body : piles.bodies) {
+		CHECK_FALSE(bool(piles.physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_SLEEPING)));
+	}
+}
+
+static void benchmark_piles(int p_pile_count, int p_boxes_per_pile, int p_steps) {
+	BoxPiles piles(p_pile_count, p_boxes_per_pile);
+
+	int max_island_count = 0;
+	int max_solver_iterations = 0;
+	int64_t contact_count = 0;
+	int64_t reused_contact_count = 0;
+	const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_steps; i++) {
+		piles.step();
+		max_island_count = MAX(max_island_count, piles.physics_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT));
+		max_solver_iterations = MAX(max_solver_iterations, piles.physics_server->get_process_info(PhysicsServer3D::INFO_SOLVER_ITERATIONS_TO_CONVERGE));
+		contact_count += piles.physics_server->get_process_info(PhysicsServer3D::INFO_CONTACT_COUNT);
+		reused_contact_count += piles.physics_server->get_process_info(PhysicsServer3D::INFO_REUSED_CONTACT_COUNT);
+	}
+	const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	MESSAGE(vformat("%d piles of %d boxes: %d islands, %.3f ms per step, %.1f%% contacts reused, up to %d iterations to converge.", p_pile_count, p_boxes_per_pile, max_island_count, elapsed_usec / 1000.0 / p_steps, contact_count > 0 ? 100.0 * reused_contact_count / contact_count : 0.0, max_solver_iterations));
+}
+
+TEST_CASE("[Benchmark][GodotPhysics3D] Step with many independent islands" * doctest::skip()) {
+	benchmark_piles(16, 8, 300);
+	benchmark_piles(64, 8, 300);
+	benchmark_piles(256, 8, 300);
+}
+
+} // namespace TestGodotStep3D
+
+#endif // TEST_GODOT_STEP_3D_H
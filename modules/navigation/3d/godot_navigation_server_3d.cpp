@@ -30,6 +30,7 @@
 
 #include "godot_navigation_server_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/mutex.h"
 #include "scene/main/node.h"
 
@@ -1368,6 +1369,7 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 }
 
 void GodotNavigationServer3D::init() {
+	path_queries_use_multiple_threads = GLOBAL_GET("navigation/pathfinding/thread_model/path_queries_use_multiple_threads");
 #ifndef _3D_DISABLED
 	navmesh_generator_3d = memnew(NavMeshGenerator3D);
 #endif // _3D_DISABLED
@@ -1466,6 +1468,30 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 	return r_query_result;
 }
 
+void GodotNavigationServer3D::_query_paths(const PathQueryParameters *p_parameters, PathQueryResult *r_results, uint32_t p_count) const {
+	if (p_count == 0) {
+		return;
+	}
+
+	PathQueryBatch batch;
+	batch.parameters = p_parameters;
+	batch.results = r_results;
+
+	// Queries only read the synced map data, so they can all run at the same time.
+	if (path_queries_use_multiple_threads && p_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_query_path_batch_item, &batch, p_count, -1, true, SNAME("NavigationServerPathQueries"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			_query_path_batch_item(i, &batch);
+		}
+	}
+}
+
+void GodotNavigationServer3D::_query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch) const {
+	p_batch->results[p_index] = _query_path(p_batch->parameters[p_index]);
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
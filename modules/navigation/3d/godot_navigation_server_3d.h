@@ -79,6 +79,7 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	mutable RID_Owner<NavObstacle> obstacle_owner;
 
 	bool active = true;
+	bool path_queries_use_multiple_threads = true;
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_iteration_id;
 
@@ -289,12 +290,19 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void _query_paths(const NavigationUtilities::PathQueryParameters *p_parameters, NavigationUtilities::PathQueryResult *r_results, uint32_t p_count) const override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	struct PathQueryBatch {
+		const NavigationUtilities::PathQueryParameters *parameters = nullptr;
+		NavigationUtilities::PathQueryResult *results = nullptr;
+	};
+	void _query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch) const;
 };
 
 #undef COMMAND_1
@@ -49,6 +49,12 @@
 		r_path_owners->push_back(poly->owner->get_owner_id()); \
 	}
 
+// A* working memory, kept per thread so that path queries don't reallocate it every time,
+// including when several queries run in parallel.
+static thread_local LocalVector<gd::NavigationPoly> path_query_navigation_polys;
+static thread_local gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> path_query_traversable_polys;
+static thread_local LocalVector<uint8_t> path_query_corridor;
+
 Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly) {
 	const LocalVector<gd::Polygon> &region_polygons = p_polygons;
 
@@ -127,7 +133,7 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygo
 	}
 }
 
-Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size) {
+Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonBVH &p_polygons_bvh, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size, const gd::ClusterGraph *p_cluster_graph) {
 	// Clear metadata outputs.
 	if (r_path_types) {
 		r_path_types->clear();
@@ -144,35 +150,16 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : p_polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
 
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
+	// Only consider the polygons in a region with compatible layers.
+	const uint32_t begin_poly_index = p_polygons_bvh.get_closest_polygon(p_polygons, p_origin, true, p_navigation_layers, begin_point);
+	if (begin_poly_index != UINT32_MAX) {
+		begin_poly = &p_polygons[begin_poly_index];
+	}
+	const uint32_t end_poly_index = p_polygons_bvh.get_closest_polygon(p_polygons, p_destination, true, p_navigation_layers, end_point);
+	if (end_poly_index != UINT32_MAX) {
+		end_poly = &p_polygons[end_poly_index];
 	}
 
 	// Check for trivial cases
@@ -205,8 +192,15 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		return path;
 	}
 
+	// Heap of polygons to travel next.
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> &traversable_polys = path_query_traversable_polys;
+	// It may still point to polygons of the previous query on this thread, so clear it before they get reset.
+	traversable_polys.clear();
+	traversable_polys.reserve(p_polygons.size() * 0.25);
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
+	LocalVector<gd::NavigationPoly> &navigation_polys = path_query_navigation_polys;
+	navigation_polys.clear();
 	navigation_polys.resize(p_polygons.size() + p_link_polygons_size);
 
 	// Initialize the matching navigation polygon.
@@ -216,10 +210,12 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
 
-	// Heap of polygons to travel next.
-	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer>
-			traversable_polys;
-	traversable_polys.reserve(p_polygons.size() * 0.25);
+	// When the map has a cluster graph, first find the clusters leading to the end polygon
+	// and only expand the polygons inside of them.
+	const LocalVector<uint8_t> *corridor = nullptr;
+	if (p_cluster_graph && !p_cluster_graph->is_empty() && p_cluster_graph->find_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, path_query_corridor)) {
+		corridor = &path_query_corridor;
+	}
 
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = begin_poly->id;
@@ -242,6 +238,10 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 					continue;
 				}
 
+				if (corridor && !(*corridor)[p_cluster_graph->get_polygon_cluster(connection.polygon->id)]) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -297,6 +297,25 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
+			if (corridor) {
+				// The corridor is only an estimate, the polygons of its clusters may not connect
+				// with the allowed layers. Search the whole map instead.
+				corridor = nullptr;
+
+				for (gd::NavigationPoly &nav_poly : navigation_polys) {
+					nav_poly.poly = nullptr;
+				}
+				navigation_polys[begin_poly->id].poly = begin_poly;
+
+				least_cost_id = begin_poly->id;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				distance_to_reachable_end = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -678,6 +697,21 @@ RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<gd::Pol
 	return cp.owner;
 }
 
+Vector3 NavMeshQueries3D::polygons_get_closest_point_to_segment(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonBVH &p_polygons_bvh, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
+	return p_polygons_bvh.get_closest_point_to_segment(p_polygons, p_from, p_to, p_use_collision);
+}
+
+gd::ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const gd::PolygonBVH &p_polygons_bvh, const Vector3 &p_point) {
+	gd::ClosestPointQueryResult result;
+
+	const uint32_t polygon_index = p_polygons_bvh.get_closest_polygon(p_polygons, p_point, false, 0, result.point, &result.normal);
+	if (polygon_index != UINT32_MAX) {
+		result.owner = p_polygons[polygon_index].owner->get_self();
+	}
+
+	return result;
+}
+
 void NavMeshQueries3D::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up) {
 	Vector3 from = path[path.size() - 1];
 
@@ -0,0 +1,292 @@
+/**************************************************************************/
+/*  nav_cluster_graph.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_cluster_graph.h"
+
+#include "nav_base.h"
+
+#include "core/templates/hash_map.h"
+
+struct ClusterPortalKey {
+	uint32_t from_cluster = 0;
+	uint32_t to_cluster = 0;
+	const NavBase *from_owner = nullptr;
+	const NavBase *to_owner = nullptr;
+
+	static uint32_t hash(const ClusterPortalKey &p_key) {
+		uint32_t h = hash_murmur3_one_32(p_key.from_cluster);
+		h = hash_murmur3_one_32(p_key.to_cluster, h);
+		h = hash_murmur3_one_64((uint64_t)p_key.from_owner, h);
+		h = hash_murmur3_one_64((uint64_t)p_key.to_owner, h);
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const ClusterPortalKey &p_key) const {
+		return from_cluster == p_key.from_cluster && to_cluster == p_key.to_cluster && from_owner == p_key.from_owner && to_owner == p_key.to_owner;
+	}
+};
+
+struct ClusterPortalAccumulator {
+	Vector3 position_sum;
+	uint32_t connection_count = 0;
+};
+
+struct ClusterQueryEntry {
+	uint32_t cluster = 0;
+	real_t traveled_distance = 0.0;
+	real_t total_travel_cost = 0.0;
+};
+
+struct ClusterQueryEntryGreaterCost {
+	bool operator()(const ClusterQueryEntry &p_left, const ClusterQueryEntry &p_right) const {
+		return p_left.total_travel_cost > p_right.total_travel_cost;
+	}
+};
+
+// Working memory of the corridor searches, kept per thread like the one of the polygon searches.
+static thread_local LocalVector<real_t> cluster_query_traveled_distances;
+static thread_local LocalVector<Vector3> cluster_query_entries;
+static thread_local LocalVector<uint32_t> cluster_query_previous;
+static thread_local gd::Heap<ClusterQueryEntry, ClusterQueryEntryGreaterCost> cluster_query_heap;
+
+static _FORCE_INLINE_ Vector3 _get_polygon_center(const gd::Polygon &p_polygon) {
+	Vector3 center;
+	for (const gd::Point &point : p_polygon.points) {
+		center += point.pos;
+	}
+	return p_polygon.points.is_empty() ? center : center / p_polygon.points.size();
+}
+
+void gd::ClusterGraph::build(const LocalVector<Polygon> &p_polygons, const PolygonBVH &p_polygons_bvh, const Polygon *p_link_polygons, uint32_t p_link_polygon_count, uint32_t p_cluster_size) {
+	clear();
+
+	const uint32_t polygon_count = p_polygons.size();
+	if (polygon_count == 0) {
+		return;
+	}
+
+	// Start from groups of spatially close polygons, then split them in sets of polygons that connect
+	// to each other, so that any polygon of a cluster can be reached from any other one.
+	LocalVector<uint32_t> polygon_groups;
+	p_polygons_bvh.get_polygon_groups(p_cluster_size, polygon_groups);
+	ERR_FAIL_COND(polygon_groups.size() != polygon_count);
+
+	polygon_clusters.resize(polygon_count + p_link_polygon_count);
+	for (uint32_t &cluster : polygon_clusters) {
+		cluster = UINT32_MAX;
+	}
+
+	LocalVector<uint32_t> stack;
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		if (polygon_clusters[i] != UINT32_MAX) {
+			continue;
+		}
+
+		const uint32_t cluster_index = clusters.size();
+		Vector3 center_sum;
+		uint32_t cluster_polygon_count = 0;
+
+		polygon_clusters[i] = cluster_index;
+		stack.push_back(i);
+		while (!stack.is_empty()) {
+			const uint32_t polygon_index = stack[stack.size() - 1];
+			stack.remove_at(stack.size() - 1);
+
+			const Polygon &polygon = p_polygons[polygon_index];
+			center_sum += _get_polygon_center(polygon);
+			cluster_polygon_count++;
+
+			for (const Edge &edge : polygon.edges) {
+				for (const Edge::Connection &connection : edge.connections) {
+					const uint32_t other_index = connection.polygon->id;
+					if (other_index >= polygon_count || polygon_clusters[other_index] != UINT32_MAX || polygon_groups[other_index] != polygon_groups[polygon_index]) {
+						continue;
+					}
+					polygon_clusters[other_index] = cluster_index;
+					stack.push_back(other_index);
+				}
+			}
+		}
+
+		Cluster cluster;
+		cluster.center = center_sum / cluster_polygon_count;
+		clusters.push_back(cluster);
+	}
+
+	for (uint32_t i = 0; i < p_link_polygon_count; i++) {
+		const Polygon &link_polygon = p_link_polygons[i];
+		ERR_CONTINUE(link_polygon.id >= polygon_clusters.size());
+
+		Cluster cluster;
+		cluster.center = _get_polygon_center(link_polygon);
+		polygon_clusters[link_polygon.id] = clusters.size();
+		clusters.push_back(cluster);
+	}
+
+	// Merge all the connections between two clusters, keeping different owners apart as they may not share layers.
+	HashMap<ClusterPortalKey, ClusterPortalAccumulator, ClusterPortalKey> portal_map;
+	LocalVector<uint32_t> cluster_portal_counts;
+	cluster_portal_counts.resize(clusters.size());
+	for (uint32_t &count : cluster_portal_counts) {
+		count = 0;
+	}
+
+	for (uint32_t i = 0; i < polygon_count + p_link_polygon_count; i++) {
+		const Polygon &polygon = i < polygon_count ? p_polygons[i] : p_link_polygons[i - polygon_count];
+		const uint32_t from_cluster = polygon_clusters[polygon.id];
+
+		for (const Edge &edge : polygon.edges) {
+			for (const Edge::Connection &connection : edge.connections) {
+				const uint32_t to_cluster = polygon_clusters[connection.polygon->id];
+				if (to_cluster == from_cluster) {
+					continue;
+				}
+
+				ClusterPortalKey key;
+				key.from_cluster = from_cluster;
+				key.to_cluster = to_cluster;
+				key.from_owner = polygon.owner;
+				key.to_owner = connection.polygon->owner;
+
+				HashMap<ClusterPortalKey, ClusterPortalAccumulator, ClusterPortalKey>::Iterator portal_it = portal_map.find(key);
+				if (!portal_it) {
+					portal_it = portal_map.insert(key, ClusterPortalAccumulator());
+					cluster_portal_counts[from_cluster]++;
+				}
+				portal_it->value.position_sum += (connection.pathway_start + connection.pathway_end) * 0.5;
+				portal_it->value.connection_count++;
+			}
+		}
+	}
+
+	// Store the portals of each cluster contiguously.
+	uint32_t portal_offset = 0;
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		clusters[i].portals_begin = portal_offset;
+		clusters[i].portals_end = portal_offset;
+		portal_offset += cluster_portal_counts[i];
+	}
+
+	portals.resize(portal_offset);
+	for (const KeyValue<ClusterPortalKey, ClusterPortalAccumulator> &E : portal_map) {
+		Portal &portal = portals[clusters[E.key.from_cluster].portals_end++];
+		portal.to_cluster = E.key.to_cluster;
+		portal.from_owner = E.key.from_owner;
+		portal.to_owner = E.key.to_owner;
+		portal.position = E.value.position_sum / E.value.connection_count;
+	}
+}
+
+void gd::ClusterGraph::clear() {
+	polygon_clusters.clear();
+	clusters.clear();
+	portals.clear();
+}
+
+bool gd::ClusterGraph::find_corridor(const Polygon *p_begin_polygon, const Vector3 &p_begin_point, const Polygon *p_end_polygon, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const {
+	ERR_FAIL_NULL_V(p_begin_polygon, false);
+	ERR_FAIL_NULL_V(p_end_polygon, false);
+	ERR_FAIL_UNSIGNED_INDEX_V(p_begin_polygon->id, polygon_clusters.size(), false);
+	ERR_FAIL_UNSIGNED_INDEX_V(p_end_polygon->id, polygon_clusters.size(), false);
+
+	const uint32_t cluster_count = clusters.size();
+	const uint32_t begin_cluster = polygon_clusters[p_begin_polygon->id];
+	const uint32_t end_cluster = polygon_clusters[p_end_polygon->id];
+
+	r_corridor.resize(cluster_count);
+	for (uint8_t &in_corridor : r_corridor) {
+		in_corridor = 0;
+	}
+	if (begin_cluster == end_cluster) {
+		r_corridor[begin_cluster] = 1;
+		return true;
+	}
+
+	// A* over the clusters, entering each of them at the portal it was reached from.
+	LocalVector<real_t> &traveled_distances = cluster_query_traveled_distances;
+	LocalVector<Vector3> &entries = cluster_query_entries;
+	LocalVector<uint32_t> &previous = cluster_query_previous;
+	Heap<ClusterQueryEntry, ClusterQueryEntryGreaterCost> &heap = cluster_query_heap;
+
+	traveled_distances.resize(cluster_count);
+	entries.resize(cluster_count);
+	previous.resize(cluster_count);
+	for (uint32_t i = 0; i < cluster_count; i++) {
+		traveled_distances[i] = FLT_MAX;
+		previous[i] = UINT32_MAX;
+	}
+	heap.clear();
+
+	traveled_distances[begin_cluster] = 0.0;
+	entries[begin_cluster] = p_begin_point;
+	heap.push({ begin_cluster, 0.0, p_begin_point.distance_to(p_end_point) });
+
+	bool found = false;
+	while (!heap.is_empty()) {
+		const ClusterQueryEntry current = heap.pop();
+		if (current.traveled_distance > traveled_distances[current.cluster]) {
+			// Stale entry, the cluster was reached through a shorter way since it was pushed.
+			continue;
+		}
+		if (current.cluster == end_cluster) {
+			found = true;
+			break;
+		}
+
+		const Cluster &cluster = clusters[current.cluster];
+		const Vector3 &entry = entries[current.cluster];
+		for (uint32_t i = cluster.portals_begin; i < cluster.portals_end; i++) {
+			const Portal &portal = portals[i];
+			if ((p_navigation_layers & portal.from_owner->get_navigation_layers()) == 0 || (p_navigation_layers & portal.to_owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			const real_t traveled_distance = current.traveled_distance + entry.distance_to(portal.position) * portal.from_owner->get_travel_cost();
+			if (traveled_distance >= traveled_distances[portal.to_cluster]) {
+				continue;
+			}
+
+			traveled_distances[portal.to_cluster] = traveled_distance;
+			entries[portal.to_cluster] = portal.position;
+			previous[portal.to_cluster] = current.cluster;
+			heap.push({ portal.to_cluster, traveled_distance, traveled_distance + portal.position.distance_to(p_end_point) * portal.to_owner->get_travel_cost() });
+		}
+	}
+	heap.clear();
+
+	if (!found) {
+		return false;
+	}
+
+	for (uint32_t cluster = end_cluster; cluster != UINT32_MAX; cluster = previous[cluster]) {
+		r_corridor[cluster] = 1;
+	}
+	return true;
+}
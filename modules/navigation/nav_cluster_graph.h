@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  nav_cluster_graph.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_CLUSTER_GRAPH_H
+#define NAV_CLUSTER_GRAPH_H
+
+#include "nav_polygon_bvh.h"
+
+namespace gd {
+
+/**
+ * Coarse graph over clusters of connected polygons, used to speed up path queries on large maps.
+ *
+ * Clusters are built from spatially close polygons that connect to each other, and every link
+ * polygon gets a cluster of its own. All the connections going from one cluster to another are
+ * summarized as portals. A path query first searches this much smaller graph, then only needs
+ * to refine the path on the polygons of the clusters it went through.
+ */
+class ClusterGraph {
+	struct Cluster {
+		Vector3 center;
+		uint32_t portals_begin = 0;
+		uint32_t portals_end = 0;
+	};
+
+	struct Portal {
+		uint32_t to_cluster = 0;
+		/// Owners are kept so that layers and costs are checked when querying, as they can change without a map sync.
+		const NavBase *from_owner = nullptr;
+		const NavBase *to_owner = nullptr;
+		Vector3 position;
+	};
+
+	LocalVector<uint32_t> polygon_clusters;
+	LocalVector<Cluster> clusters;
+	LocalVector<Portal> portals;
+
+public:
+	/// Only the first `p_link_polygon_count` link polygons are used, `p_polygons_bvh` must have been built from `p_polygons`.
+	void build(const LocalVector<Polygon> &p_polygons, const PolygonBVH &p_polygons_bvh, const Polygon *p_link_polygons, uint32_t p_link_polygon_count, uint32_t p_cluster_size);
+	void clear();
+	bool is_empty() const { return clusters.is_empty(); }
+	uint32_t get_cluster_count() const { return clusters.size(); }
+	uint32_t get_portal_count() const { return portals.size(); }
+	uint32_t get_polygon_cluster(uint32_t p_polygon_id) const { return polygon_clusters[p_polygon_id]; }
+
+	/// Searches the clusters leading from `p_begin_polygon` to `p_end_polygon`, using only polygons with compatible layers.
+	/// On success `r_corridor` is set to 1 for the clusters on the way, and to 0 for all the others.
+	/// Returns false if the clusters don't connect, in which case the polygons can't either.
+	bool find_corridor(const Polygon *p_begin_polygon, const Vector3 &p_begin_point, const Polygon *p_end_polygon, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const;
+};
+
+} // namespace gd
+
+#endif // NAV_CLUSTER_GRAPH_H
@@ -92,6 +92,7 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 	}
 	use_edge_connections = p_enabled;
 	regenerate_links = true;
+	reconnect_all_regions = true;
 }
 
 void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
@@ -100,6 +101,7 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	}
 	edge_connection_margin = p_edge_connection_margin;
 	regenerate_links = true;
+	reconnect_all_regions = true;
 }
 
 void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
@@ -131,8 +133,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	return NavMeshQueries3D::polygons_get_path(
-			polygons, p_origin, p_destination, p_optimize, p_navigation_layers,
-			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size());
+			polygons, polygons_bvh, p_origin, p_destination, p_optimize, p_navigation_layers,
+			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size(), &cluster_graph);
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -142,7 +144,7 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, p_from, p_to, p_use_collision);
+	return NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, polygons_bvh, p_from, p_to, p_use_collision);
 }
 
 Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
@@ -152,7 +154,7 @@ Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, polygons_bvh, p_point).point;
 }
 
 Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
@@ -162,7 +164,7 @@ Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_normal(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, polygons_bvh, p_point).normal;
 }
 
 RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
@@ -172,13 +174,13 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 		return RID();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_owner(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, polygons_bvh, p_point).owner;
 }
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	RWLockRead read_lock(map_rwlock);
 
-	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, polygons_bvh, p_point);
 }
 
 void NavMap::add_region(NavRegion *p_region) {
@@ -192,6 +194,14 @@ void NavMap::remove_region(NavRegion *p_region) {
 		regions.remove_at_unordered(region_index);
 		regenerate_links = true;
 	}
+
+	HashMap<NavRegion *, RegionConnections>::Iterator connections = region_connections.find(p_region);
+	if (connections) {
+		if (connections->value.has_polygons) {
+			removed_region_bounds.push_back(connections->value.bounds);
+		}
+		region_connections.remove(connections);
+	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
@@ -373,11 +383,13 @@ void NavMap::sync() {
 			region->scratch_polygons();
 		}
 		regenerate_links = true;
+		reconnect_all_regions = true;
 	}
 
 	for (NavRegion *region : regions) {
 		if (region->sync()) {
 			regenerate_links = true;
+			region_connections[region].dirty = true;
 		}
 	}
 
@@ -394,18 +406,16 @@ void NavMap::sync() {
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
 
-		// Remove regions connections.
-		region_external_connections.clear();
-		for (NavRegion *region : regions) {
-			region_external_connections[region] = LocalVector<gd::Edge::Connection>();
-		}
+		// Only reconnect the regions that changed, and the ones close enough to them.
+		_update_region_connections();
 
 		// Resize the polygon count.
 		int polygon_count = 0;
-		for (const NavRegion *region : regions) {
+		for (NavRegion *region : regions) {
 			if (!region->get_enabled()) {
 				continue;
 			}
+			region_connections[region].polygon_offset = polygon_count;
 			polygon_count += region->get_polygons().size();
 		}
 		polygons.resize(polygon_count);
@@ -426,133 +436,55 @@ void NavMap::sync() {
 
 		_new_pm_polygon_count = polygon_count;
 
-		// Group all edges per key.
-		connection_pairs_map.clear();
-		connection_pairs_map.reserve(polygons.size());
-		int free_edges_count = 0; // How many ConnectionPairs have only one Connection.
-
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				const int next_point = (p + 1) % poly.points.size();
-				const gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey>::Iterator pair_it = connection_pairs_map.find(ek);
-				if (!pair_it) {
-					pair_it = connection_pairs_map.insert(ek, ConnectionPair());
-					_new_pm_edge_count += 1;
-					++free_edges_count;
-				}
-				ConnectionPair &pair = pair_it->value;
-				if (pair.size < 2) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-
-					pair.connections[pair.size] = new_connection;
-					++pair.size;
-					if (pair.size == 2) {
-						--free_edges_count;
-					}
+		// Index the polygons so that point and segment queries don't need to visit all of them.
+		polygons_bvh.build(polygons);
 
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
-				}
+		// Connect the polygons from the region connections.
+		int merged_edge_count = 0;
+		int free_edge_count = 0;
+		for (NavRegion *region : regions) {
+			if (!region->get_enabled()) {
+				continue;
 			}
-		}
-
-		free_edges.clear();
-		free_edges.reserve(free_edges_count);
 
-		for (const KeyValue<gd::EdgeKey, ConnectionPair> &pair_it : connection_pairs_map) {
-			const ConnectionPair &pair = pair_it.value;
-			if (pair.size == 2) {
-				// Connect edge that are shared in different polygons.
-				const gd::Edge::Connection &c1 = pair.connections[0];
-				const gd::Edge::Connection &c2 = pair.connections[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(pair.size != 1, vformat("Number of connection != 1. Found: %d", pair.size));
-				if (use_edge_connections && pair.connections[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(pair.connections[0]);
-				}
+			const RegionConnections &connections = region_connections.get(region);
+			gd::Polygon *region_polygons = polygons.ptr() + connections.polygon_offset;
+
+			for (const gd::RegionEdgeConnection &internal_connection : region->get_internal_connections()) {
+				gd::Polygon &other_polygon = region_polygons[internal_connection.other_polygon];
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &other_polygon;
+				new_connection.edge = internal_connection.other_edge;
+				new_connection.pathway_start = other_polygon.points[internal_connection.other_edge].pos;
+				new_connection.pathway_end = other_polygon.points[(internal_connection.other_edge + 1) % other_polygon.points.size()].pos;
+				region_polygons[internal_connection.polygon].edges[internal_connection.edge].connections.push_back(new_connection);
 			}
-		}
-
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
-
-		const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
-
-		for (uint32_t i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
-
-			for (uint32_t j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
-
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
-
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
-
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_squared_to(self1) > edge_connection_margin_squared) {
-					continue;
-				}
+			_new_pm_edge_merge_count += region->get_internal_connections().size() / 2;
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_squared_to(self2) > edge_connection_margin_squared) {
-					continue;
+			for (const LocalVector<RegionExternalConnection> *external_connections : { &connections.merged_connections, &connections.margin_connections }) {
+				for (const RegionExternalConnection &external_connection : *external_connections) {
+					gd::Edge::Connection new_connection;
+					new_connection.polygon = &polygons[region_connections.get(external_connection.other_region).polygon_offset + external_connection.other_polygon];
+					new_connection.edge = external_connection.other_edge;
+					new_connection.pathway_start = external_connection.pathway_start;
+					new_connection.pathway_end = external_connection.pathway_end;
+					region_polygons[external_connection.polygon].edges[external_connection.edge].connections.push_back(new_connection);
 				}
+			}
+			merged_edge_count += connections.merged_connections.size();
+			_new_pm_edge_connection_count += connections.margin_connections.size();
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
-
-				// Add the connection to the region_connection map.
-				region_external_connections[(NavRegion *)free_edge.polygon->owner].push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+			const int region_free_edge_count = region->get_free_edges().size() - connections.merged_connections.size();
+			free_edge_count += region_free_edge_count;
+			if (use_edge_connections && region->get_use_edge_connections()) {
+				_new_pm_edge_free_count += region_free_edge_count;
 			}
 		}
 
+		// Edges merged between regions are counted from both sides.
+		_new_pm_edge_merge_count += merged_edge_count / 2;
+		_new_pm_edge_count = _new_pm_edge_merge_count + free_edge_count;
+
 		uint32_t link_poly_idx = 0;
 		link_polygons.resize(links.size());
 
@@ -565,47 +497,23 @@ void NavMap::sync() {
 			const Vector3 end = link->get_end_position();
 
 			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_sqr_dist = link_connection_radius * link_connection_radius;
 			Vector3 closest_start_point;
 
 			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_sqr_dist = link_connection_radius * link_connection_radius;
 			Vector3 closest_end_point;
 
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t sqr_dist = start_point.distance_squared_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (sqr_dist < closest_start_sqr_dist) {
-						closest_start_sqr_dist = sqr_dist;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
+			const real_t link_connection_radius_squared = link_connection_radius * link_connection_radius;
+
+			// Pick the polygon that is within our radius and is the closest to the start point.
+			const uint32_t closest_start_index = polygons_bvh.get_closest_polygon(polygons, start, false, 0, closest_start_point, nullptr, link_connection_radius_squared);
+			if (closest_start_index != UINT32_MAX) {
+				closest_start_polygon = &polygons[closest_start_index];
 			}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t sqr_dist = end_point.distance_squared_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (sqr_dist < closest_end_sqr_dist) {
-						closest_end_sqr_dist = sqr_dist;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+			// Same for the end point.
+			const uint32_t closest_end_index = polygons_bvh.get_closest_polygon(polygons, end, false, 0, closest_end_point, nullptr, link_connection_radius_squared);
+			if (closest_end_index != UINT32_MAX) {
+				closest_end_polygon = &polygons[closest_end_index];
 			}
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
@@ -661,6 +569,12 @@ void NavMap::sync() {
 			}
 		}
 
+		if (use_hierarchical_pathfinding) {
+			cluster_graph.build(polygons, polygons_bvh, link_polygons.ptr(), link_poly_idx, hierarchical_pathfinding_cluster_size);
+		} else {
+			cluster_graph.clear();
+		}
+
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
 		iteration_id = iteration_id % UINT32_MAX + 1;
 	}
@@ -872,12 +786,229 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 	merge_rasterizer_cell_height = cell_height * merge_rasterizer_cell_scale;
 }
 
+static bool _get_edge_connection_pathway(const Vector3 &p_edge_p1, const Vector3 &p_edge_p2, const Vector3 &p_other_edge_p1, const Vector3 &p_other_edge_p2, real_t p_edge_connection_margin_squared, Vector3 &r_pathway_start, Vector3 &r_pathway_end) {
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = p_edge_p2 - p_edge_p1;
+	real_t projected_p1_ratio = edge_vector.dot(p_other_edge_p1 - p_edge_p1) / (edge_vector.length_squared());
+	real_t projected_p2_ratio = edge_vector.dot(p_other_edge_p2 - p_edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return false;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + p_edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = p_other_edge_p1;
+	} else {
+		other1 = p_other_edge_p1.lerp(p_other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_squared_to(self1) > p_edge_connection_margin_squared) {
+		return false;
+	}
+
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + p_edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = p_other_edge_p2;
+	} else {
+		other2 = p_other_edge_p1.lerp(p_other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_squared_to(self2) > p_edge_connection_margin_squared) {
+		return false;
+	}
+
+	r_pathway_start = (self1 + other1) / 2.0;
+	r_pathway_end = (self2 + other2) / 2.0;
+	return true;
+}
+
+void NavMap::_update_region_connections() {
+	// Edges with the same point keys can be up to a rasterizer cell apart, and close edges are searched within the margin.
+	const real_t search_margin = MAX(use_edge_connections ? edge_connection_margin : real_t(0.0), MAX(merge_rasterizer_cell_size, merge_rasterizer_cell_height));
+
+	// Collect the areas where the connections may have changed.
+	LocalVector<AABB> changed_bounds = removed_region_bounds;
+	removed_region_bounds.clear();
+
+	for (NavRegion *region : regions) {
+		RegionConnections &connections = region_connections[region];
+		if (!connections.dirty && !reconnect_all_regions) {
+			continue;
+		}
+		if (connections.has_polygons) {
+			changed_bounds.push_back(connections.bounds);
+		}
+		connections.has_polygons = region->get_enabled() && !region->get_polygons().is_empty();
+		connections.bounds = region->get_bounds();
+		if (connections.has_polygons) {
+			changed_bounds.push_back(connections.bounds);
+		}
+	}
+
+	// Reset the connections of the regions in those areas.
+	LocalVector<NavRegion *> updated_regions;
+	for (NavRegion *region : regions) {
+		RegionConnections &connections = region_connections.get(region);
+		bool update = connections.dirty || reconnect_all_regions;
+		connections.dirty = false;
+
+		if (!update && connections.has_polygons) {
+			const AABB search_bounds = connections.bounds.grow(search_margin);
+			for (const AABB &bounds : changed_bounds) {
+				if (search_bounds.intersects(bounds)) {
+					update = true;
+					break;
+				}
+			}
+		}
+		if (!update) {
+			continue;
+		}
+
+		connections.merged_connections.clear();
+		connections.margin_connections.clear();
+		connections.free_edges_merged.resize(connections.has_polygons ? region->get_free_edges().size() : 0);
+		for (uint8_t &merged : connections.free_edges_merged) {
+			merged = 0;
+		}
+
+		if (connections.has_polygons) {
+			updated_regions.push_back(region);
+		}
+	}
+	reconnect_all_regions = false;
+
+	// Only regions close to each other can connect.
+	LocalVector<LocalVector<NavRegion *>> region_neighbors;
+	region_neighbors.resize(updated_regions.size());
+	for (uint32_t i = 0; i < updated_regions.size(); i++) {
+		const AABB search_bounds = region_connections.get(updated_regions[i]).bounds.grow(search_margin);
+		for (NavRegion *other_region : regions) {
+			if (other_region == updated_regions[i]) {
+				continue;
+			}
+			const RegionConnections &other_connections = region_connections.get(other_region);
+			if (other_connections.has_polygons && search_bounds.intersects(other_connections.bounds)) {
+				region_neighbors[i].push_back(other_region);
+			}
+		}
+	}
+
+	// Merge the free edges shared with other regions.
+	HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> free_edge_indices;
+	for (uint32_t i = 0; i < updated_regions.size(); i++) {
+		NavRegion *region = updated_regions[i];
+		RegionConnections &connections = region_connections.get(region);
+		const LocalVector<gd::RegionFreeEdge> &free_edges = region->get_free_edges();
+
+		free_edge_indices.clear();
+		for (uint32_t free_edge_index = 0; free_edge_index < free_edges.size(); free_edge_index++) {
+			free_edge_indices.insert(free_edges[free_edge_index].key, free_edge_index);
+		}
+
+		for (NavRegion *neighbor : region_neighbors[i]) {
+			const LocalVector<gd::Polygon> &neighbor_polygons = neighbor->get_polygons();
+			for (const gd::RegionFreeEdge &neighbor_edge : neighbor->get_free_edges()) {
+				HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey>::ConstIterator found_edge = free_edge_indices.find(neighbor_edge.key);
+				if (!found_edge) {
+					continue;
+				}
+				if (connections.free_edges_merged[found_edge->value]) {
+					// The edge is already connected with another edge, skip.
+					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+					continue;
+				}
+				connections.free_edges_merged[found_edge->value] = 1;
+
+				const gd::Polygon &neighbor_polygon = neighbor_polygons[neighbor_edge.polygon];
+				RegionExternalConnection new_connection;
+				new_connection.polygon = free_edges[found_edge->value].polygon;
+				new_connection.edge = free_edges[found_edge->value].edge;
+				new_connection.other_region = neighbor;
+				new_connection.other_polygon = neighbor_edge.polygon;
+				new_connection.other_edge = neighbor_edge.edge;
+				// Note: The pathway_start/end are full for those connection and do not need to be modified.
+				new_connection.pathway_start = neighbor_polygon.points[neighbor_edge.edge].pos;
+				new_connection.pathway_end = neighbor_polygon.points[(neighbor_edge.edge + 1) % neighbor_polygon.points.size()].pos;
+				connections.merged_connections.push_back(new_connection);
+			}
+		}
+	}
+
+	if (!use_edge_connections) {
+		return;
+	}
+
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
+
+	for (uint32_t i = 0; i < updated_regions.size(); i++) {
+		NavRegion *region = updated_regions[i];
+		if (!region->get_use_edge_connections()) {
+			continue;
+		}
+
+		RegionConnections &connections = region_connections.get(region);
+		const LocalVector<gd::Polygon> &region_polygons = region->get_polygons();
+		const LocalVector<gd::RegionFreeEdge> &free_edges = region->get_free_edges();
+
+		for (NavRegion *neighbor : region_neighbors[i]) {
+			if (!neighbor->get_use_edge_connections()) {
+				continue;
+			}
+
+			const RegionConnections &neighbor_connections = region_connections.get(neighbor);
+			const LocalVector<gd::Polygon> &neighbor_polygons = neighbor->get_polygons();
+			const LocalVector<gd::RegionFreeEdge> &neighbor_free_edges = neighbor->get_free_edges();
+
+			for (uint32_t free_edge_index = 0; free_edge_index < free_edges.size(); free_edge_index++) {
+				if (connections.free_edges_merged[free_edge_index]) {
+					continue;
+				}
+				const gd::RegionFreeEdge &free_edge = free_edges[free_edge_index];
+				const gd::Polygon &polygon = region_polygons[free_edge.polygon];
+				const Vector3 &edge_p1 = polygon.points[free_edge.edge].pos;
+				const Vector3 &edge_p2 = polygon.points[(free_edge.edge + 1) % polygon.points.size()].pos;
+
+				for (uint32_t other_edge_index = 0; other_edge_index < neighbor_free_edges.size(); other_edge_index++) {
+					if (neighbor_connections.free_edges_merged[other_edge_index]) {
+						continue;
+					}
+					const gd::RegionFreeEdge &other_edge = neighbor_free_edges[other_edge_index];
+					const gd::Polygon &other_polygon = neighbor_polygons[other_edge.polygon];
+					const Vector3 &other_edge_p1 = other_polygon.points[other_edge.edge].pos;
+					const Vector3 &other_edge_p2 = other_polygon.points[(other_edge.edge + 1) % other_polygon.points.size()].pos;
+
+					// The edges can now be connected.
+					RegionExternalConnection new_connection;
+					if (!_get_edge_connection_pathway(edge_p1, edge_p2, other_edge_p1, other_edge_p2, edge_connection_margin_squared, new_connection.pathway_start, new_connection.pathway_end)) {
+						continue;
+					}
+					new_connection.polygon = free_edge.polygon;
+					new_connection.edge = free_edge.edge;
+					new_connection.other_region = neighbor;
+					new_connection.other_polygon = other_edge.polygon;
+					new_connection.other_edge = other_edge.edge;
+					connections.margin_connections.push_back(new_connection);
+				}
+			}
+		}
+	}
+}
+
 int NavMap::get_region_connections_count(NavRegion *p_region) const {
 	ERR_FAIL_NULL_V(p_region, 0);
 
-	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>>::ConstIterator found_connections = region_external_connections.find(p_region);
+	HashMap<NavRegion *, RegionConnections>::ConstIterator found_connections = region_connections.find(p_region);
 	if (found_connections) {
-		return found_connections->value.size();
+		return found_connections->value.margin_connections.size();
 	}
 	return 0;
 }
@@ -885,10 +1016,10 @@ int NavMap::get_region_connections_count(NavRegion *p_region) const {
 Vector3 NavMap::get_region_connection_pathway_start(NavRegion *p_region, int p_connection_id) const {
 	ERR_FAIL_NULL_V(p_region, Vector3());
 
-	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>>::ConstIterator found_connections = region_external_connections.find(p_region);
+	HashMap<NavRegion *, RegionConnections>::ConstIterator found_connections = region_connections.find(p_region);
 	if (found_connections) {
-		ERR_FAIL_INDEX_V(p_connection_id, int(found_connections->value.size()), Vector3());
-		return found_connections->value[p_connection_id].pathway_start;
+		ERR_FAIL_INDEX_V(p_connection_id, int(found_connections->value.margin_connections.size()), Vector3());
+		return found_connections->value.margin_connections[p_connection_id].pathway_start;
 	}
 
 	return Vector3();
@@ -897,10 +1028,10 @@ Vector3 NavMap::get_region_connection_pathway_start(NavRegion *p_region, int p_c
 Vector3 NavMap::get_region_connection_pathway_end(NavRegion *p_region, int p_connection_id) const {
 	ERR_FAIL_NULL_V(p_region, Vector3());
 
-	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>>::ConstIterator found_connections = region_external_connections.find(p_region);
+	HashMap<NavRegion *, RegionConnections>::ConstIterator found_connections = region_connections.find(p_region);
 	if (found_connections) {
-		ERR_FAIL_INDEX_V(p_connection_id, int(found_connections->value.size()), Vector3());
-		return found_connections->value[p_connection_id].pathway_end;
+		ERR_FAIL_INDEX_V(p_connection_id, int(found_connections->value.margin_connections.size()), Vector3());
+		return found_connections->value.margin_connections[p_connection_id].pathway_end;
 	}
 
 	return Vector3();
@@ -909,6 +1040,8 @@ Vector3 NavMap::get_region_connection_pathway_end(NavRegion *p_region, int p_con
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
+	hierarchical_pathfinding_cluster_size = MAX(int(GLOBAL_GET("navigation/pathfinding/hierarchical_pathfinding_cluster_size")), 1);
 }
 
 NavMap::~NavMap() {
@@ -31,6 +31,8 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_cluster_graph.h"
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -85,6 +87,14 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Spatial index over the map polygons, rebuilt together with them.
+	gd::PolygonBVH polygons_bvh;
+
+	/// Coarse graph over clusters of polygons for hierarchical path queries, empty when disabled.
+	gd::ClusterGraph cluster_graph;
+	bool use_hierarchical_pathfinding = false;
+	uint32_t hierarchical_pathfinding_cluster_size = 64;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -126,15 +136,42 @@ class NavMap : public NavRid {
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
 
-	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>> region_external_connections;
+	struct RegionExternalConnection {
+		/// Polygon and edge of the region, using region polygon indices.
+		uint32_t polygon = 0;
+		uint32_t edge = 0;
+
+		NavRegion *other_region = nullptr;
+		uint32_t other_polygon = 0;
+		uint32_t other_edge = 0;
+
+		Vector3 pathway_start;
+		Vector3 pathway_end;
+	};
+
+	struct RegionConnections {
+		/// Bounds of the region polygons when its connections were last updated.
+		AABB bounds;
+		bool has_polygons = false;
+
+		/// The region polygons changed since the last sync.
+		bool dirty = true;
+
+		/// Index of the first region polygon in the map polygons.
+		uint32_t polygon_offset = 0;
 
-	struct ConnectionPair {
-		gd::Edge::Connection connections[2];
-		int size = 0;
+		/// Whether each free edge of the region is merged with an edge of another region.
+		LocalVector<uint8_t> free_edges_merged;
+		LocalVector<RegionExternalConnection> merged_connections;
+		/// Connections to the edges of other regions within the edge connection margin.
+		LocalVector<RegionExternalConnection> margin_connections;
 	};
 
-	HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey> connection_pairs_map;
-	LocalVector<gd::Edge::Connection> free_edges;
+	/// Kept between syncs, so that only the regions that changed and their neighbors get reconnected.
+	HashMap<NavRegion *, RegionConnections> region_connections;
+	/// Bounds of the regions removed since the last sync, their neighbors need to be reconnected.
+	LocalVector<AABB> removed_region_bounds;
+	bool reconnect_all_regions = true;
 
 public:
 	NavMap();
@@ -246,6 +283,7 @@ private:
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+	void _update_region_connections();
 };
 
 #endif // NAV_MAP_H
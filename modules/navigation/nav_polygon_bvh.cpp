@@ -0,0 +1,364 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "nav_base.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+// Traversal stacks only need to be as deep as the tree, which is balanced.
+#define POLYGON_BVH_STACK_SIZE 64
+
+struct PolygonBVHStackEntry {
+	uint32_t node = 0;
+	real_t distance_squared = 0.0;
+};
+
+static _FORCE_INLINE_ real_t _point_to_aabb_distance_squared(const Vector3 &p_point, const AABB &p_aabb) {
+	const Vector3 end = p_aabb.position + p_aabb.size;
+	const Vector3 delta = (p_aabb.position - p_point).max(Vector3()) + (p_point - end).max(Vector3());
+	return delta.length_squared();
+}
+
+static _FORCE_INLINE_ real_t _aabb_to_aabb_distance_squared(const AABB &p_a, const AABB &p_b) {
+	const Vector3 delta = (p_b.position - (p_a.position + p_a.size)).max(Vector3()) + (p_a.position - (p_b.position + p_b.size)).max(Vector3());
+	return delta.length_squared();
+}
+
+uint32_t gd::PolygonBVH::_create_node(PolygonCenter *p_polygons, uint32_t p_count) {
+	if (p_count == 1) {
+		return Node::LEAF_BIT | p_polygons[0].index;
+	}
+
+	uint32_t index = nodes.size();
+	{
+		Node node;
+		node.polygon_count = p_count;
+		node.bounds = polygon_bounds[p_polygons[0].index];
+		for (uint32_t i = 1; i < p_count; i++) {
+			node.bounds.merge_with(polygon_bounds[p_polygons[i].index]);
+		}
+		nodes.push_back(node);
+	}
+
+	uint32_t middle = p_count / 2;
+
+	SortArray<PolygonCenter, PolygonCenterSort> sorter;
+	sorter.compare.axis = nodes[index].bounds.get_longest_axis_index();
+	sorter.nth_element(0, p_count, middle, p_polygons);
+
+	uint32_t left = _create_node(p_polygons, middle);
+	uint32_t right = _create_node(p_polygons + middle, p_count - middle);
+
+	nodes[index].children[0] = left;
+	nodes[index].children[1] = right;
+
+	return index;
+}
+
+void gd::PolygonBVH::build(const LocalVector<Polygon> &p_polygons) {
+	clear();
+
+	if (p_polygons.is_empty()) {
+		return;
+	}
+
+	polygon_bounds.resize(p_polygons.size());
+
+	LocalVector<PolygonCenter> centers;
+	centers.resize(p_polygons.size());
+
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const Polygon &polygon = p_polygons[i];
+
+		AABB bounds;
+		if (!polygon.points.is_empty()) {
+			bounds.position = polygon.points[0].pos;
+			for (uint32_t j = 1; j < polygon.points.size(); j++) {
+				bounds.expand_to(polygon.points[j].pos);
+			}
+		}
+
+		// Navigation meshes are mostly flat, grow the bounds a bit so segment tests against them stay inclusive.
+		const Vector3 extents = bounds.position.abs().max((bounds.position + bounds.size).abs());
+		polygon_bounds[i] = bounds.grow(CMP_EPSILON * (1.0 + extents[extents.max_axis_index()]));
+
+		centers[i].center = bounds.get_center();
+		centers[i].index = i;
+	}
+
+	nodes.reserve(p_polygons.size());
+	root = _create_node(centers.ptr(), centers.size());
+}
+
+void gd::PolygonBVH::_assign_groups(uint32_t p_node, uint32_t p_max_group_size, uint32_t p_group, uint32_t &r_group_count, LocalVector<uint32_t> &r_polygon_groups) const {
+	if (p_node & Node::LEAF_BIT) {
+		r_polygon_groups[p_node & Node::LEAF_MASK] = p_group == UINT32_MAX ? r_group_count++ : p_group;
+		return;
+	}
+
+	const Node &node = nodes[p_node];
+	if (p_group == UINT32_MAX && node.polygon_count <= p_max_group_size) {
+		// The whole subtree fits in a group.
+		p_group = r_group_count++;
+	}
+	_assign_groups(node.children[0], p_max_group_size, p_group, r_group_count, r_polygon_groups);
+	_assign_groups(node.children[1], p_max_group_size, p_group, r_group_count, r_polygon_groups);
+}
+
+uint32_t gd::PolygonBVH::get_polygon_groups(uint32_t p_max_group_size, LocalVector<uint32_t> &r_polygon_groups) const {
+	r_polygon_groups.resize(polygon_bounds.size());
+	if (is_empty()) {
+		return 0;
+	}
+
+	uint32_t group_count = 0;
+	_assign_groups(root, MAX(p_max_group_size, 1U), UINT32_MAX, group_count, r_polygon_groups);
+	return group_count;
+}
+
+void gd::PolygonBVH::clear() {
+	nodes.clear();
+	polygon_bounds.clear();
+	root = Node::LEAF_BIT;
+}
+
+uint32_t gd::PolygonBVH::get_closest_polygon(const LocalVector<Polygon> &p_polygons, const Vector3 &p_point, bool p_filter_layers, uint32_t p_navigation_layers, Vector3 &r_point, Vector3 *r_normal, real_t p_max_distance_squared) const {
+	if (is_empty()) {
+		return UINT32_MAX;
+	}
+	ERR_FAIL_COND_V(p_polygons.size() != polygon_bounds.size(), UINT32_MAX);
+
+	uint32_t closest_index = UINT32_MAX;
+	real_t closest_distance_squared = p_max_distance_squared;
+
+	PolygonBVHStackEntry stack[POLYGON_BVH_STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { root, _point_to_aabb_distance_squared(p_point, _get_bounds(root)) };
+
+	while (stack_size > 0) {
+		const PolygonBVHStackEntry entry = stack[--stack_size];
+
+		// Nodes at the same distance may still hold a polygon with a lower index, so only skip the farther ones.
+		if (entry.distance_squared > closest_distance_squared) {
+			continue;
+		}
+
+		if (entry.node & Node::LEAF_BIT) {
+			const uint32_t polygon_index = entry.node & Node::LEAF_MASK;
+			const Polygon &polygon = p_polygons[polygon_index];
+
+			if (p_filter_layers && (p_navigation_layers & polygon.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+				const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+				const Vector3 point = face.get_closest_point_to(p_point);
+				const real_t distance_squared = point.distance_squared_to(p_point);
+
+				if (distance_squared < closest_distance_squared || (distance_squared == closest_distance_squared && closest_index != UINT32_MAX && polygon_index < closest_index)) {
+					closest_distance_squared = distance_squared;
+					closest_index = polygon_index;
+					r_point = point;
+					if (r_normal) {
+						*r_normal = face.get_plane().normal;
+					}
+				}
+			}
+			continue;
+		}
+
+		const Node &node = nodes[entry.node];
+		PolygonBVHStackEntry children[2] = {
+			{ node.children[0], _point_to_aabb_distance_squared(p_point, _get_bounds(node.children[0])) },
+			{ node.children[1], _point_to_aabb_distance_squared(p_point, _get_bounds(node.children[1])) },
+		};
+		// Push the farthest child first so the closest one is visited first and tightens the search early.
+		if (children[0].distance_squared < children[1].distance_squared) {
+			SWAP(children[0], children[1]);
+		}
+		for (const PolygonBVHStackEntry &child : children) {
+			if (child.distance_squared <= closest_distance_squared) {
+				ERR_FAIL_COND_V(stack_size >= POLYGON_BVH_STACK_SIZE, closest_index);
+				stack[stack_size++] = child;
+			}
+		}
+	}
+
+	return closest_index;
+}
+
+Vector3 gd::PolygonBVH::get_closest_point_to_segment(const LocalVector<Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, bool p_use_collision) const {
+	Vector3 closest_point;
+	if (is_empty()) {
+		return closest_point;
+	}
+	ERR_FAIL_COND_V(p_polygons.size() != polygon_bounds.size(), closest_point);
+
+	PolygonBVHStackEntry stack[POLYGON_BVH_STACK_SIZE];
+	uint32_t stack_size = 0;
+
+	real_t closest_point_distance = FLT_MAX;
+	uint32_t closest_index = UINT32_MAX;
+
+	// Look for the intersection closest to the segment start, only visiting the nodes crossed by the segment.
+	if (_get_bounds(root).intersects_segment(p_from, p_to)) {
+		stack[stack_size++] = { root, _point_to_aabb_distance_squared(p_from, _get_bounds(root)) };
+	}
+
+	while (stack_size > 0) {
+		const PolygonBVHStackEntry entry = stack[--stack_size];
+
+		if (closest_index != UINT32_MAX && entry.distance_squared > closest_point_distance * closest_point_distance) {
+			continue;
+		}
+
+		if (entry.node & Node::LEAF_BIT) {
+			const uint32_t polygon_index = entry.node & Node::LEAF_MASK;
+			const Polygon &polygon = p_polygons[polygon_index];
+
+			for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+				const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+				Vector3 intersection_point;
+				if (face.intersects_segment(p_from, p_to, &intersection_point)) {
+					const real_t d = p_from.distance_to(intersection_point);
+					if (closest_index == UINT32_MAX || d < closest_point_distance || (d == closest_point_distance && polygon_index < closest_index)) {
+						closest_point = intersection_point;
+						closest_point_distance = d;
+						closest_index = polygon_index;
+					}
+				}
+			}
+			continue;
+		}
+
+		const Node &node = nodes[entry.node];
+		PolygonBVHStackEntry children[2] = {
+			{ node.children[0], _point_to_aabb_distance_squared(p_from, _get_bounds(node.children[0])) },
+			{ node.children[1], _point_to_aabb_distance_squared(p_from, _get_bounds(node.children[1])) },
+		};
+		if (children[0].distance_squared < children[1].distance_squared) {
+			SWAP(children[0], children[1]);
+		}
+		for (const PolygonBVHStackEntry &child : children) {
+			if (_get_bounds(child.node).intersects_segment(p_from, p_to)) {
+				ERR_FAIL_COND_V(stack_size >= POLYGON_BVH_STACK_SIZE, closest_point);
+				stack[stack_size++] = child;
+			}
+		}
+	}
+
+	if (closest_index != UINT32_MAX || p_use_collision) {
+		return closest_point;
+	}
+
+	// The segment doesn't intersect the polygons, look for the closest point between the polygons and the segment.
+	// The distance between the segment bounds and a node bounds is a lower bound of any distance found within that node.
+	AABB segment_bounds(p_from, Vector3());
+	segment_bounds.expand_to(p_to);
+
+	stack[stack_size++] = { root, _aabb_to_aabb_distance_squared(segment_bounds, _get_bounds(root)) };
+
+	while (stack_size > 0) {
+		const PolygonBVHStackEntry entry = stack[--stack_size];
+
+		if (closest_index != UINT32_MAX && entry.distance_squared > closest_point_distance * closest_point_distance) {
+			continue;
+		}
+
+		if (entry.node & Node::LEAF_BIT) {
+			const uint32_t polygon_index = entry.node & Node::LEAF_MASK;
+			const Polygon &polygon = p_polygons[polygon_index];
+
+			// For each face check the distance from the segment's endpoints.
+			for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+				const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+
+				const Vector3 p_from_closest = face.get_closest_point_to(p_from);
+				const real_t d_p_from = p_from.distance_to(p_from_closest);
+				if (d_p_from < closest_point_distance || (d_p_from == closest_point_distance && polygon_index < closest_index)) {
+					closest_point = p_from_closest;
+					closest_point_distance = d_p_from;
+					closest_index = polygon_index;
+				}
+
+				const Vector3 p_to_closest = face.get_closest_point_to(p_to);
+				const real_t d_p_to = p_to.distance_to(p_to_closest);
+				if (d_p_to < closest_point_distance || (d_p_to == closest_point_distance && polygon_index < closest_index)) {
+					closest_point = p_to_closest;
+					closest_point_distance = d_p_to;
+					closest_index = polygon_index;
+				}
+			}
+
+			// Then check for the shortest distance between the polygon edges and the segment.
+			for (uint32_t point_id = 0; point_id < polygon.points.size(); point_id++) {
+				Vector3 a, b;
+
+				Geometry3D::get_closest_points_between_segments(
+						p_from,
+						p_to,
+						polygon.points[point_id].pos,
+						polygon.points[(point_id + 1) % polygon.points.size()].pos,
+						a,
+						b);
+
+				const real_t d = a.distance_to(b);
+				if (d < closest_point_distance || (d == closest_point_distance && polygon_index < closest_index)) {
+					closest_point = b;
+					closest_point_distance = d;
+					closest_index = polygon_index;
+				}
+			}
+			continue;
+		}
+
+		const Node &node = nodes[entry.node];
+		PolygonBVHStackEntry children[2] = {
+			{ node.children[0], _aabb_to_aabb_distance_squared(segment_bounds, _get_bounds(node.children[0])) },
+			{ node.children[1], _aabb_to_aabb_distance_squared(segment_bounds, _get_bounds(node.children[1])) },
+		};
+		if (children[0].distance_squared < children[1].distance_squared) {
+			SWAP(children[0], children[1]);
+		}
+		for (const PolygonBVHStackEntry &child : children) {
+			if (closest_index == UINT32_MAX || child.distance_squared <= closest_point_distance * closest_point_distance) {
+				ERR_FAIL_COND_V(stack_size >= POLYGON_BVH_STACK_SIZE, closest_point);
+				stack[stack_size++] = child;
+			}
+		}
+	}
+
+	return closest_point;
+}
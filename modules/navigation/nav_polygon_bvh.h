@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+
+namespace gd {
+
+/**
+ * Static bounding volume hierarchy over the polygons of a map.
+ *
+ * It is rebuilt by the map every time the polygons are regenerated, and only
+ * stores indices into the polygon array it was built from. All queries must be
+ * made with that same array, and are read-only so they can run concurrently.
+ */
+class PolygonBVH {
+	struct Node {
+		enum : uint32_t {
+			LEAF_BIT = 1U << 31,
+			LEAF_MASK = LEAF_BIT - 1,
+		};
+
+		AABB bounds;
+		uint32_t children[2] = { 0, 0 };
+		uint32_t polygon_count = 0;
+	};
+
+	struct PolygonCenter {
+		Vector3 center;
+		uint32_t index = 0;
+	};
+
+	struct PolygonCenterSort {
+		int axis = 0;
+		bool operator()(const PolygonCenter &p_left, const PolygonCenter &p_right) const {
+			return p_left.center[axis] < p_right.center[axis];
+		}
+	};
+
+	LocalVector<Node> nodes;
+	LocalVector<AABB> polygon_bounds;
+	uint32_t root = Node::LEAF_BIT;
+
+	uint32_t _create_node(PolygonCenter *p_polygons, uint32_t p_count);
+	void _assign_groups(uint32_t p_node, uint32_t p_max_group_size, uint32_t p_group, uint32_t &r_group_count, LocalVector<uint32_t> &r_polygon_groups) const;
+	_FORCE_INLINE_ const AABB &_get_bounds(uint32_t p_node) const {
+		return (p_node & Node::LEAF_BIT) ? polygon_bounds[p_node & Node::LEAF_MASK] : nodes[p_node].bounds;
+	}
+
+public:
+	void build(const LocalVector<Polygon> &p_polygons);
+	void clear();
+	bool is_empty() const { return polygon_bounds.is_empty(); }
+	uint32_t get_node_count() const { return nodes.size(); }
+
+	/// Returns the index of the polygon closest to `p_point`, or `UINT32_MAX` if none is closer than `p_max_distance_squared`.
+	/// When `p_filter_layers` is set, polygons whose owner shares no layer with `p_navigation_layers` are ignored.
+	/// Ties are resolved in favor of the polygon with the lowest index, like a linear scan would.
+	uint32_t get_closest_polygon(const LocalVector<Polygon> &p_polygons, const Vector3 &p_point, bool p_filter_layers, uint32_t p_navigation_layers, Vector3 &r_point, Vector3 *r_normal = nullptr, real_t p_max_distance_squared = FLT_MAX) const;
+	Vector3 get_closest_point_to_segment(const LocalVector<Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, bool p_use_collision) const;
+
+	/// Splits the polygons in spatially coherent groups of at most `p_max_group_size` polygons, using the tree subdivision.
+	/// Returns the number of groups, `r_polygon_groups` holds the group of each polygon.
+	uint32_t get_polygon_groups(uint32_t p_max_group_size, LocalVector<uint32_t> &r_polygon_groups) const;
+};
+
+} // namespace gd
+
+#endif // NAV_POLYGON_BVH_H
@@ -134,6 +134,9 @@ bool NavRegion::sync() {
 	bool something_changed = polygons_dirty /* || something_dirty? */;
 
 	update_polygons();
+	if (something_changed) {
+		update_edges();
+	}
 
 	return something_changed;
 }
@@ -220,3 +223,56 @@ void NavRegion::update_polygons() {
 
 	surface_area = _new_region_surface_area;
 }
+
+void NavRegion::update_edges() {
+	internal_connections.clear();
+	free_edges.clear();
+	bounds = AABB();
+
+	struct EdgeUse {
+		gd::RegionFreeEdge edge;
+		uint32_t count = 0;
+	};
+
+	// Merge the edges within the region once, the map only has to connect the free ones with other regions.
+	HashMap<gd::EdgeKey, EdgeUse, gd::EdgeKey> edge_uses;
+	bool has_bounds = false;
+
+	for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = polygons[polygon_index];
+		for (uint32_t p = 0; p < polygon.points.size(); p++) {
+			if (has_bounds) {
+				bounds.expand_to(polygon.points[p].pos);
+			} else {
+				bounds.position = polygon.points[p].pos;
+				has_bounds = true;
+			}
+
+			const int next_point = (p + 1) % polygon.points.size();
+			const gd::EdgeKey ek(polygon.points[p].key, polygon.points[next_point].key);
+
+			HashMap<gd::EdgeKey, EdgeUse, gd::EdgeKey>::Iterator use_it = edge_uses.find(ek);
+			if (!use_it) {
+				use_it = edge_uses.insert(ek, EdgeUse());
+				use_it->value.edge.polygon = polygon_index;
+				use_it->value.edge.edge = p;
+				use_it->value.edge.key = ek;
+			} else if (use_it->value.count == 1) {
+				const gd::RegionFreeEdge &other = use_it->value.edge;
+				internal_connections.push_back({ polygon_index, p, other.polygon, other.edge });
+				internal_connections.push_back({ other.polygon, other.edge, polygon_index, p });
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+				continue;
+			}
+			use_it->value.count++;
+		}
+	}
+
+	for (const KeyValue<gd::EdgeKey, EdgeUse> &E : edge_uses) {
+		if (E.value.count == 1) {
+			free_edges.push_back(E.value.edge);
+		}
+	}
+}
@@ -50,6 +50,11 @@ class NavRegion : public NavBase {
 
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
+	AABB bounds;
+
+	/// Edges merged between the region polygons, in both directions, and the ones left to connect with other regions.
+	LocalVector<gd::RegionEdgeConnection> internal_connections;
+	LocalVector<gd::RegionFreeEdge> free_edges;
 
 	real_t surface_area = 0.0;
 
@@ -90,6 +95,10 @@ public:
 		return polygons;
 	}
 
+	const AABB &get_bounds() const { return bounds; }
+	const LocalVector<gd::RegionEdgeConnection> &get_internal_connections() const { return internal_connections; }
+	const LocalVector<gd::RegionFreeEdge> &get_free_edges() const { return free_edges; }
+
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, bool p_use_collision) const;
 	gd::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
@@ -100,6 +109,7 @@ public:
 
 private:
 	void update_polygons();
+	void update_edges();
 };
 
 #endif // NAV_REGION_H
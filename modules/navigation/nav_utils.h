@@ -113,6 +113,22 @@ struct Polygon {
 	real_t surface_area = 0.0;
 };
 
+/// Edge of a region polygon that isn't shared with another polygon of the same region.
+struct RegionFreeEdge {
+	/// Index of the polygon in the region.
+	uint32_t polygon = 0;
+	uint32_t edge = 0;
+	EdgeKey key;
+};
+
+/// Edge shared by two polygons of the same region, using region polygon indices.
+struct RegionEdgeConnection {
+	uint32_t polygon = 0;
+	uint32_t edge = 0;
+	uint32_t other_polygon = 0;
+	uint32_t other_edge = 0;
+};
+
 struct NavigationPoly {
 	/// This poly.
 	const Polygon *poly = nullptr;
@@ -0,0 +1,211 @@
+/**************************************************************************/
+/*  test_nav_cluster_graph.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_CLUSTER_GRAPH_H
+#define TEST_NAV_CLUSTER_GRAPH_H
+
+#ifndef _3D_DISABLED
+
+#include "../3d/nav_mesh_queries_3d.h"
+#include "../nav_base.h"
+#include "../nav_cluster_graph.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavClusterGraph {
+
+static void connect_polygons(gd::Polygon &p_from, int p_from_edge, gd::Polygon &p_to, int p_to_edge) {
+	gd::Edge::Connection connection;
+	connection.polygon = &p_to;
+	connection.edge = p_to_edge;
+	connection.pathway_start = p_to.points[p_to_edge].pos;
+	connection.pathway_end = p_to.points[(p_to_edge + 1) % p_to.points.size()].pos;
+	p_from.edges[p_from_edge].connections.push_back(connection);
+}
+
+// Builds a connected grid of `p_size` x `p_size` quads, with a wall along `p_wall_x` that can only be crossed at `p_gap_z`.
+// A negative `p_gap_z` makes the wall close the whole grid.
+static void build_connected_grid(LocalVector<gd::Polygon> &r_polygons, int p_size, const NavBase *p_owner, int p_wall_x, int p_gap_z) {
+	r_polygons.resize(p_size * p_size);
+	for (int x = 0; x < p_size; x++) {
+		for (int z = 0; z < p_size; z++) {
+			gd::Polygon &polygon = r_polygons[x * p_size + z];
+			polygon.id = x * p_size + z;
+			polygon.owner = p_owner;
+			polygon.points.push_back({ Vector3(x, 0, z) });
+			polygon.points.push_back({ Vector3(x, 0, z + 1) });
+			polygon.points.push_back({ Vector3(x + 1, 0, z + 1) });
+			polygon.points.push_back({ Vector3(x + 1, 0, z) });
+			polygon.edges.resize(4);
+		}
+	}
+
+	for (int x = 0; x < p_size; x++) {
+		for (int z = 0; z < p_size; z++) {
+			gd::Polygon &polygon = r_polygons[x * p_size + z];
+			if (x + 1 < p_size && (x + 1 != p_wall_x || z == p_gap_z)) {
+				gd::Polygon &other = r_polygons[(x + 1) * p_size + z];
+				connect_polygons(polygon, 2, other, 0);
+				connect_polygons(other, 0, polygon, 2);
+			}
+			if (z + 1 < p_size) {
+				gd::Polygon &other = r_polygons[x * p_size + z + 1];
+				connect_polygons(polygon, 1, other, 3);
+				connect_polygons(other, 3, polygon, 1);
+			}
+		}
+	}
+}
+
+static real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+TEST_CASE("[Navigation][ClusterGraph] Clusters should only contain connected polygons") {
+	NavBase owner;
+	LocalVector<gd::Polygon> polygons;
+	build_connected_grid(polygons, 16, &owner, 8, -1);
+
+	gd::PolygonBVH bvh;
+	bvh.build(polygons);
+
+	gd::ClusterGraph graph;
+	graph.build(polygons, bvh, nullptr, 0, 16);
+	CHECK_FALSE(graph.is_empty());
+	CHECK_GE(graph.get_cluster_count(), 16u);
+	CHECK_LT(graph.get_cluster_count(), polygons.size());
+
+	// No cluster spans the wall.
+	for (int z = 0; z < 16; z++) {
+		for (int other_z = 0; other_z < 16; other_z++) {
+			CHECK_NE(graph.get_polygon_cluster(7 * 16 + z), graph.get_polygon_cluster(8 * 16 + other_z));
+		}
+	}
+
+	// The clusters on each side of the wall don't connect.
+	LocalVector<uint8_t> corridor;
+	CHECK_FALSE(graph.find_corridor(&polygons[0], Vector3(0.5, 0, 0.5), &polygons[15 * 16], Vector3(15.5, 0, 0.5), 1, corridor));
+	CHECK(graph.find_corridor(&polygons[0], Vector3(0.5, 0, 0.5), &polygons[7 * 16 + 15], Vector3(7.5, 0, 15.5), 1, corridor));
+	CHECK_EQ(corridor.size(), graph.get_cluster_count());
+	CHECK_EQ(corridor[graph.get_polygon_cluster(0)], 1);
+	CHECK_EQ(corridor[graph.get_polygon_cluster(7 * 16 + 15)], 1);
+}
+
+TEST_CASE("[Navigation][ClusterGraph] Hierarchical paths should be close to the shortest paths") {
+	NavBase owner;
+	LocalVector<gd::Polygon> polygons;
+	build_connected_grid(polygons, 32, &owner, 16, 29);
+
+	gd::PolygonBVH bvh;
+	bvh.build(polygons);
+
+	gd::ClusterGraph graph;
+	graph.build(polygons, bvh, nullptr, 0, 16);
+
+	for (int i = 0; i < 32; i++) {
+		const Vector3 from = Vector3((i * 7) % 32 + 0.5, 0, (i * 13) % 32 + 0.5);
+		const Vector3 to = Vector3((i * 11 + 17) % 32 + 0.25, 0, (i * 5 + 3) % 32 + 0.75);
+
+		const Vector<Vector3> flat_path = NavMeshQueries3D::polygons_get_path(polygons, bvh, from, to, true, 1, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0);
+		const Vector<Vector3> hierarchical_path = NavMeshQueries3D::polygons_get_path(polygons, bvh, from, to, true, 1, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0, &graph);
+		REQUIRE_FALSE(flat_path.is_empty());
+		REQUIRE_FALSE(hierarchical_path.is_empty());
+		CHECK(hierarchical_path[0].is_equal_approx(flat_path[0]));
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(flat_path[flat_path.size() - 1]));
+		CHECK_LE(get_path_length(hierarchical_path), get_path_length(flat_path) * 1.25 + CMP_EPSILON);
+	}
+
+}
+
+TEST_CASE("[Navigation][ClusterGraph] Unreachable destinations should give the same path as the flat search") {
+	NavBase owner;
+	LocalVector<gd::Polygon> polygons;
+	build_connected_grid(polygons, 16, &owner, 8, -1);
+
+	gd::PolygonBVH bvh;
+	bvh.build(polygons);
+
+	gd::ClusterGraph graph;
+	graph.build(polygons, bvh, nullptr, 0, 8);
+
+	const Vector3 from = Vector3(1.5, 0, 2.5);
+	const Vector3 to = Vector3(14.5, 0, 12.5);
+	const Vector<Vector3> flat_path = NavMeshQueries3D::polygons_get_path(polygons, bvh, from, to, true, 1, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0);
+	const Vector<Vector3> hierarchical_path = NavMeshQueries3D::polygons_get_path(polygons, bvh, from, to, true, 1, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0, &graph);
+	REQUIRE_FALSE(flat_path.is_empty());
+	CHECK_EQ(hierarchical_path, flat_path);
+}
+
+TEST_CASE("[Benchmark][Navigation][ClusterGraph] Path query cost versus polygon count" * doctest::skip()) {
+	NavBase owner;
+	const int query_count = 50;
+
+	for (int size : { 32, 128, 256 }) {
+		LocalVector<gd::Polygon> polygons;
+		build_connected_grid(polygons, size, &owner, size / 2, size - 3);
+
+		gd::PolygonBVH bvh;
+		bvh.build(polygons);
+
+		gd::ClusterGraph graph;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		graph.build(polygons, bvh, nullptr, 0, 64);
+		const uint64_t build_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		real_t flat_length = 0.0;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			flat_length += get_path_length(NavMeshQueries3D::polygons_get_path(polygons, bvh, Vector3(0.5, 0, (i * 7) % size + 0.5), Vector3(size - 0.5, 0, (i * 13) % size + 0.5), true, 1, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0));
+		}
+		const uint64_t flat_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		real_t hierarchical_length = 0.0;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			hierarchical_length += get_path_length(NavMeshQueries3D::polygons_get_path(polygons, bvh, Vector3(0.5, 0, (i * 7) % size + 0.5), Vector3(size - 0.5, 0, (i * 13) % size + 0.5), true, 1, nullptr, nullptr, nullptr, Vector3(0, 1, 0), 0, &graph));
+		}
+		const uint64_t hierarchical_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%d polygons, %d clusters: build %d usec, flat %.2f usec/query, hierarchical %.2f usec/query, %.2f%% longer paths.",
+				polygons.size(), graph.get_cluster_count(), build_usec, double(flat_usec) / query_count, double(hierarchical_usec) / query_count, (hierarchical_length / flat_length - 1.0) * 100.0));
+	}
+}
+
+} // namespace TestNavClusterGraph
+
+#endif // _3D_DISABLED
+
+#endif // TEST_NAV_CLUSTER_GRAPH_H
@@ -0,0 +1,205 @@
+/**************************************************************************/
+/*  test_nav_map_sync.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_MAP_SYNC_H
+#define TEST_NAV_MAP_SYNC_H
+
+#ifndef _3D_DISABLED
+
+#include "../nav_map.h"
+#include "../nav_region.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavMapSync {
+
+// Builds a square navigation mesh tile of `p_cells` x `p_cells` quads of size 1.
+static Ref<NavigationMesh> create_tile_mesh(int p_cells) {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+
+	Vector<Vector3> vertices;
+	for (int x = 0; x <= p_cells; x++) {
+		for (int z = 0; z <= p_cells; z++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+
+	for (int x = 0; x < p_cells; x++) {
+		for (int z = 0; z < p_cells; z++) {
+			Vector<int> polygon;
+			polygon.push_back(x * (p_cells + 1) + z);
+			polygon.push_back(x * (p_cells + 1) + z + 1);
+			polygon.push_back((x + 1) * (p_cells + 1) + z + 1);
+			polygon.push_back((x + 1) * (p_cells + 1) + z);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+// Tiles share their edges, except after the second column where they are separated by a gap
+// larger than a rasterizer cell, but within the edge connection margin.
+static Transform3D get_tile_transform(int p_x, int p_z, int p_cells) {
+	return Transform3D(Basis(), Vector3(p_x * p_cells + (p_x >= 2 ? 0.3 : 0.0), 0, p_z * p_cells));
+}
+
+static void create_tile_regions(NavMap *p_map, const Ref<NavigationMesh> &p_navigation_mesh, int p_size_x, int p_size_z, int p_cells, LocalVector<NavRegion *> &r_regions) {
+	for (int x = 0; x < p_size_x; x++) {
+		for (int z = 0; z < p_size_z; z++) {
+			NavRegion *region = memnew(NavRegion);
+			region->set_map(p_map);
+			region->set_transform(get_tile_transform(x, z, p_cells));
+			region->set_navigation_mesh(p_navigation_mesh);
+			r_regions.push_back(region);
+		}
+	}
+}
+
+static void free_tile_regions(LocalVector<NavRegion *> &r_regions) {
+	for (NavRegion *region : r_regions) {
+		if (region) {
+			region->set_map(nullptr);
+			memdelete(region);
+		}
+	}
+	r_regions.clear();
+}
+
+TEST_SUITE("[Navigation]") {
+	TEST_CASE("[NavMap] Incremental syncs should connect regions like a full sync") {
+		Ref<NavigationMesh> navigation_mesh = create_tile_mesh(2);
+
+		NavMap *map = memnew(NavMap);
+		map->set_edge_connection_margin(0.5);
+		LocalVector<NavRegion *> regions;
+		create_tile_regions(map, navigation_mesh, 4, 4, 2, regions);
+		map->sync();
+		CHECK_EQ(map->get_pm_polygon_count(), 64);
+		CHECK_GT(map->get_pm_edge_connection_count(), 0);
+
+		// Move a tile away and back, toggle another one, and remove a third one.
+		regions[1 * 4 + 1]->set_transform(Transform3D(Basis(), Vector3(0, 50, 0)));
+		map->sync();
+		regions[2 * 4 + 2]->set_enabled(false);
+		map->sync();
+		CHECK_EQ(map->get_pm_polygon_count(), 56);
+		regions[2 * 4 + 2]->set_enabled(true);
+		regions[1 * 4 + 1]->set_transform(get_tile_transform(1, 1, 2));
+		map->sync();
+		regions[3 * 4 + 3]->set_map(nullptr);
+		memdelete(regions[3 * 4 + 3]);
+		regions[3 * 4 + 3] = nullptr;
+		map->sync();
+
+		// Build the same layout from scratch.
+		NavMap *expected_map = memnew(NavMap);
+		expected_map->set_edge_connection_margin(0.5);
+		LocalVector<NavRegion *> expected_regions;
+		create_tile_regions(expected_map, navigation_mesh, 4, 4, 2, expected_regions);
+		expected_regions[3 * 4 + 3]->set_map(nullptr);
+		expected_map->sync();
+
+		CHECK_EQ(map->get_pm_polygon_count(), expected_map->get_pm_polygon_count());
+		CHECK_EQ(map->get_pm_edge_count(), expected_map->get_pm_edge_count());
+		CHECK_EQ(map->get_pm_edge_merge_count(), expected_map->get_pm_edge_merge_count());
+		CHECK_EQ(map->get_pm_edge_connection_count(), expected_map->get_pm_edge_connection_count());
+		CHECK_EQ(map->get_pm_edge_free_count(), expected_map->get_pm_edge_free_count());
+		for (uint32_t i = 0; i < regions.size(); i++) {
+			if (regions[i]) {
+				CHECK_EQ(map->get_region_connections_count(regions[i]), expected_map->get_region_connections_count(expected_regions[i]));
+			}
+		}
+
+		for (int i = 0; i < 16; i++) {
+			const Vector3 from = Vector3((i * 5) % 8 + 0.5, 0, (i * 3) % 8 + 0.5);
+			const Vector3 to = Vector3((i * 7 + 3) % 8 + 0.5, 0, (i * 11 + 1) % 8 + 0.5);
+			const Vector<Vector3> path = map->get_path(from, to, true, 1, nullptr, nullptr, nullptr);
+			const Vector<Vector3> expected_path = expected_map->get_path(from, to, true, 1, nullptr, nullptr, nullptr);
+			REQUIRE_EQ(path.size(), expected_path.size());
+			for (int j = 0; j < path.size(); j++) {
+				CHECK(path[j].is_equal_approx(expected_path[j]));
+			}
+		}
+
+		free_tile_regions(expected_regions);
+		memdelete(expected_map);
+		free_tile_regions(regions);
+		memdelete(map);
+	}
+
+	TEST_CASE("[NavMap][Benchmark] Sync time of single tile updates on a large map" * doctest::skip()) {
+		Ref<NavigationMesh> navigation_mesh = create_tile_mesh(4);
+		const int update_count = 20;
+
+		NavMap *map = memnew(NavMap);
+		map->set_edge_connection_margin(0.5);
+		LocalVector<NavRegion *> regions;
+		create_tile_regions(map, navigation_mesh, 40, 25, 4, regions);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		map->sync();
+		const uint64_t full_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		// Changing the margin reconnects all the regions, but doesn't need to merge their own edges again.
+		map->set_edge_connection_margin(map->get_edge_connection_margin() * 2.0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		map->sync();
+		const uint64_t reconnect_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		uint64_t update_usec = 0;
+		for (int i = 0; i < update_count; i++) {
+			const int x = (i * 7) % 40;
+			const int z = (i * 13) % 25;
+			NavRegion *region = regions[x * 25 + z];
+			region->set_transform(get_tile_transform(x, z, 4).translated(Vector3(0, 0.01, 0)));
+			begin = OS::get_singleton()->get_ticks_usec();
+			map->sync();
+			update_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			region->set_transform(get_tile_transform(x, z, 4));
+			map->sync();
+		}
+
+		MESSAGE(vformat("%d regions, %d polygons: first sync %d usec, reconnecting all regions %d usec, single tile update %.1f usec.",
+				regions.size(), map->get_pm_polygon_count(), full_usec, reconnect_usec, double(update_usec) / update_count));
+
+		free_tile_regions(regions);
+		memdelete(map);
+	}
+}
+
+} // namespace TestNavMapSync
+
+#endif // _3D_DISABLED
+
+#endif // TEST_NAV_MAP_SYNC_H
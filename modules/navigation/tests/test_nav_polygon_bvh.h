@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  test_nav_polygon_bvh.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_POLYGON_BVH_H
+#define TEST_NAV_POLYGON_BVH_H
+
+#ifndef _3D_DISABLED
+
+#include "../3d/nav_mesh_queries_3d.h"
+#include "../nav_base.h"
+#include "../nav_polygon_bvh.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavPolygonBVH {
+
+// Builds a grid of `p_size` x `p_size` quads with slightly varying heights, alternating between two owners.
+static void build_polygon_grid(LocalVector<gd::Polygon> &r_polygons, int p_size, const NavBase *p_owner_a, const NavBase *p_owner_b) {
+	const real_t cell = 100.0 / p_size;
+	r_polygons.resize(p_size * p_size);
+	for (int x = 0; x < p_size; x++) {
+		for (int z = 0; z < p_size; z++) {
+			gd::Polygon &polygon = r_polygons[x * p_size + z];
+			polygon.id = x * p_size + z;
+			polygon.owner = (x + z) % 3 == 0 ? p_owner_b : p_owner_a;
+			const real_t height = ((x * 7 + z * 3) % 5) * 0.1;
+			polygon.points.push_back({ Vector3(x * cell, height, z * cell) });
+			polygon.points.push_back({ Vector3(x * cell, height, (z + 1) * cell) });
+			polygon.points.push_back({ Vector3((x + 1) * cell, height, (z + 1) * cell) });
+			polygon.points.push_back({ Vector3((x + 1) * cell, height, z * cell) });
+		}
+	}
+}
+
+TEST_CASE("[Navigation][PolygonBVH] Empty BVH") {
+	LocalVector<gd::Polygon> polygons;
+	gd::PolygonBVH bvh;
+	bvh.build(polygons);
+	CHECK(bvh.is_empty());
+
+	Vector3 point;
+	CHECK_EQ(bvh.get_closest_polygon(polygons, Vector3(1, 2, 3), false, 0, point), UINT32_MAX);
+	CHECK_EQ(bvh.get_closest_point_to_segment(polygons, Vector3(0, 1, 0), Vector3(0, -1, 0), false), Vector3());
+}
+
+TEST_CASE("[Navigation][PolygonBVH] Queries should match a linear scan") {
+	NavBase owner_a;
+	NavBase owner_b;
+	owner_a.set_navigation_layers(1);
+	owner_b.set_navigation_layers(2);
+
+	for (int size : { 1, 2, 5, 16 }) {
+		LocalVector<gd::Polygon> polygons;
+		build_polygon_grid(polygons, size, &owner_a, &owner_b);
+
+		gd::PolygonBVH bvh;
+		bvh.build(polygons);
+		CHECK_FALSE(bvh.is_empty());
+
+		for (int i = 0; i < 64; i++) {
+			// Include points on polygon edges and corners, where several polygons are at the same distance.
+			const Vector3 point = Vector3((i * 37) % 110 - 5, (i % 4) * 0.25 - 0.5, (i * 53) % 110 - 5).snapped(Vector3(1, 0.25, 1) * (i % 2 ? 1.0 : 0.5));
+			const Vector3 other_point = Vector3((i * 71) % 110 - 5, (i % 3) - 1.0, (i * 29) % 110 - 5);
+
+			const gd::ClosestPointQueryResult expected = NavMeshQueries3D::polygons_get_closest_point_info(polygons, point);
+			const gd::ClosestPointQueryResult result = NavMeshQueries3D::polygons_get_closest_point_info(polygons, bvh, point);
+			CHECK_EQ(result.point, expected.point);
+			CHECK_EQ(result.normal, expected.normal);
+
+			CHECK_EQ(
+					NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, bvh, point, other_point, false),
+					NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, point, other_point, false));
+			CHECK_EQ(
+					NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, bvh, point, other_point, true),
+					NavMeshQueries3D::polygons_get_closest_point_to_segment(polygons, point, other_point, true));
+
+			Vector3 layer_point;
+			const uint32_t layer_polygon = bvh.get_closest_polygon(polygons, point, true, 2, layer_point);
+			REQUIRE_NE(layer_polygon, UINT32_MAX);
+			CHECK_EQ(polygons[layer_polygon].owner, &owner_b);
+			CHECK_EQ(bvh.get_closest_polygon(polygons, point, true, 4, layer_point), UINT32_MAX);
+		}
+	}
+}
+
+TEST_CASE("[Navigation][PolygonBVH] Closest polygon should respect the maximum distance") {
+	NavBase owner;
+	LocalVector<gd::Polygon> polygons;
+	build_polygon_grid(polygons, 4, &owner, &owner);
+
+	gd::PolygonBVH bvh;
+	bvh.build(polygons);
+
+	Vector3 point;
+	CHECK_EQ(bvh.get_closest_polygon(polygons, Vector3(50, 10, 50), false, 0, point, nullptr, 1.0), UINT32_MAX);
+	CHECK_NE(bvh.get_closest_polygon(polygons, Vector3(50, 0.5, 50), false, 0, point, nullptr, 1.0), UINT32_MAX);
+}
+
+TEST_CASE("[Benchmark][Navigation][PolygonBVH] Closest point query cost versus polygon count" * doctest::skip()) {
+	NavBase owner;
+	const int query_count = 200;
+
+	for (int size : { 16, 64, 256 }) {
+		LocalVector<gd::Polygon> polygons;
+		build_polygon_grid(polygons, size, &owner, &owner);
+
+		gd::PolygonBVH bvh;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		bvh.build(polygons);
+		const uint64_t build_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			NavMeshQueries3D::polygons_get_closest_point_info(polygons, Vector3((i * 37) % 100, 1, (i * 53) % 100));
+		}
+		const uint64_t linear_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			NavMeshQueries3D::polygons_get_closest_point_info(polygons, bvh, Vector3((i * 37) % 100, 1, (i * 53) % 100));
+		}
+		const uint64_t bvh_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%d polygons: build %d usec, linear scan %.2f usec/query, BVH %.2f usec/query.", polygons.size(), build_usec, double(linear_usec) / query_count, double(bvh_usec) / query_count));
+	}
+}
+
+} // namespace TestNavPolygonBVH
+
+#endif // _3D_DISABLED
+
+#endif // TEST_NAV_POLYGON_BVH_H
@@ -30,6 +30,9 @@
 
 #include "cpu_particles_2d.h"
 
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/resources/atlas_texture.h"
 #include "scene/resources/curve_texture.h"
@@ -245,6 +248,26 @@ bool CPUParticles2D::get_fractional_delta() const {
 	return fractional_delta;
 }
 
+void CPUParticles2D::set_use_fixed_seed(bool p_use_fixed_seed) {
+	if (use_fixed_seed == p_use_fixed_seed) {
+		return;
+	}
+	use_fixed_seed = p_use_fixed_seed;
+	notify_property_list_changed();
+}
+
+bool CPUParticles2D::get_use_fixed_seed() const {
+	return use_fixed_seed;
+}
+
+void CPUParticles2D::set_seed(uint32_t p_seed) {
+	seed = p_seed;
+}
+
+uint32_t CPUParticles2D::get_seed() const {
+	return seed;
+}
+
 PackedStringArray CPUParticles2D::get_configuration_warnings() const {
 	PackedStringArray warnings = Node2D::get_configuration_warnings();
 
@@ -510,6 +533,10 @@ void CPUParticles2D::_validate_property(PropertyInfo &p_property) const {
 		p_property.hint = one_shot ? PROPERTY_HINT_ONESHOT : PROPERTY_HINT_NONE;
 	}
 
+	if (p_property.name == "seed" && !use_fixed_seed) {
+		p_property.usage = PROPERTY_USAGE_NONE;
+	}
+
 	if (p_property.name == "emission_sphere_radius" && (emission_shape != EMISSION_SHAPE_SPHERE && emission_shape != EMISSION_SHAPE_SPHERE_SURFACE)) {
 		p_property.usage = PROPERTY_USAGE_NONE;
 	}
@@ -579,6 +606,8 @@ void CPUParticles2D::_update_internal() {
 	}
 	_set_do_redraw(true);
 
+	bool buffer_updated = false;
+
 	if (time == 0 && pre_process_time > 0.0) {
 		double frame_time;
 		if (fixed_fps > 0) {
@@ -608,20 +637,25 @@ void CPUParticles2D::_update_internal() {
 		double todo = frame_remainder + ldelta;
 
 		while (todo >= frame_time) {
-			_particles_process(frame_time);
 			todo -= decr;
+			// The last step fills the instance data as it goes.
+			buffer_updated = draw_order == DRAW_ORDER_INDEX && todo < frame_time;
+			_particles_process(frame_time, buffer_updated);
 		}
 
 		frame_remainder = todo;
 
 	} else {
-		_particles_process(delta);
+		buffer_updated = draw_order == DRAW_ORDER_INDEX;
+		_particles_process(delta, buffer_updated);
 	}
 
-	_update_particle_data_buffer();
+	if (!buffer_updated) {
+		_update_particle_data_buffer();
+	}
 }
 
-void CPUParticles2D::_particles_process(double p_delta) {
+void CPUParticles2D::_particles_process(double p_delta, bool p_update_buffer) {
 	p_delta *= speed_scale;
 
 	int pcount = particles.size();
@@ -629,6 +663,11 @@ void CPUParticles2D::_particles_process(double p_delta) {
 
 	Particle *parray = w;
 
+	if (time == 0 && cycle == 0) {
+		// The emission starts over.
+		process_seed = use_fixed_seed ? seed : Math::rand();
+	}
+
 	double prev_time = time;
 	time += p_delta;
 	if (time > lifetime) {
@@ -650,358 +689,455 @@ void CPUParticles2D::_particles_process(double p_delta) {
 
 	double system_phase = time / lifetime;
 
-	bool should_be_active = false;
-	for (int i = 0; i < pcount; i++) {
-		Particle &p = parray[i];
+	// Gradients sort their points when they are first read, which must not happen from several threads.
+	if (color_ramp.is_valid() && color_ramp->get_point_count() > 0) {
+		color_ramp->get_offset(0);
+	}
+	if (color_initial_ramp.is_valid() && color_initial_ramp->get_point_count() > 0) {
+		color_initial_ramp->get_offset(0);
+	}
+
+	ParticlesProcessData data;
+	data.particles = parray;
+	data.particle_count = pcount;
+	data.delta = p_delta;
+	data.prev_time = prev_time;
+	data.system_phase = system_phase;
+	data.emission_xform = emission_xform;
+	data.velocity_xform = velocity_xform;
+
+	if (p_update_buffer) {
+		update_mutex.lock();
+		data.buffer = particle_data.ptrw();
+	}
 
-		if (!emitting && !p.active) {
-			continue;
+	bool should_be_active = false;
+	const int chunk_count = (pcount + PROCESS_CHUNK_SIZE - 1) / PROCESS_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		// Particles are independent of each other, so they can be processed in any order.
+		data.chunk_active.resize(chunk_count);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_particles_process_chunk, &data, chunk_count, -1, true, SNAME("CPUParticles2DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		for (const bool chunk_active : data.chunk_active) {
+			should_be_active = should_be_active || chunk_active;
 		}
+	} else {
+		should_be_active = _particles_process_range(0, pcount, data);
+	}
+
+	if (p_update_buffer) {
+		update_mutex.unlock();
+	}
 
-		double local_delta = p_delta;
+	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
+		active = false;
+		emit_signal(SceneStringName(finished));
+	}
+}
 
-		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
-		// While we use time in tests later on, for randomness we use the phase as done in the
-		// original shader code, and we later multiply by lifetime to get the time.
-		double restart_phase = double(i) / double(pcount);
+void CPUParticles2D::_particles_process_chunk(uint32_t p_chunk, ParticlesProcessData *p_data) {
+	const int from = p_chunk * PROCESS_CHUNK_SIZE;
+	const int to = MIN(from + PROCESS_CHUNK_SIZE, p_data->particle_count);
+	p_data->chunk_active[p_chunk] = _particles_process_range(from, to, *p_data);
+}
 
-		if (randomness_ratio > 0.0) {
-			uint32_t seed = cycle;
-			if (restart_phase >= system_phase) {
-				seed -= uint32_t(1);
-			}
-			seed *= uint32_t(pcount);
-			seed += uint32_t(i);
-			double random = double(idhash(seed) % uint32_t(65536)) / 65536.0;
-			restart_phase += randomness_ratio * random * 1.0 / double(pcount);
+bool CPUParticles2D::_particles_process_range(int p_from, int p_to, const ParticlesProcessData &p_data) {
+	bool should_be_active = false;
+	for (int i = p_from; i < p_to; i++) {
+		if (_particle_process(p_data.particles[i], i, p_data)) {
+			should_be_active = true;
 		}
+		if (p_data.buffer) {
+			_write_particle_data(p_data.particles[i], p_data.buffer + i * 16);
+		}
+	}
+	return should_be_active;
+}
 
-		restart_phase *= (1.0 - explosiveness_ratio);
-		double restart_time = restart_phase * lifetime;
-		bool restart = false;
+// Return whether the particle is still active.
+bool CPUParticles2D::_particle_process(Particle &r_particle, int p_index, const ParticlesProcessData &p_data) {
+	Particle &p = r_particle;
 
-		if (time > prev_time) {
-			// restart_time >= prev_time is used so particles emit in the first frame they are processed
+	if (!emitting && !p.active) {
+		return false;
+	}
 
-			if (restart_time >= prev_time && restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
-			}
+	double local_delta = p_data.delta;
 
-		} else if (local_delta > 0.0) {
-			if (restart_time >= prev_time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = lifetime - restart_time + time;
-				}
+	// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
+	// While we use time in tests later on, for randomness we use the phase as done in the
+	// original shader code, and we later multiply by lifetime to get the time.
+	double restart_phase = double(p_index) / double(p_data.particle_count);
 
-			} else if (restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
-			}
+	if (randomness_ratio > 0.0) {
+		uint32_t phase_seed = cycle;
+		if (restart_phase >= p_data.system_phase) {
+			phase_seed -= uint32_t(1);
 		}
+		phase_seed *= uint32_t(p_data.particle_count);
+		phase_seed += uint32_t(p_index);
+		double random = double(idhash(phase_seed) % uint32_t(65536)) / 65536.0;
+		restart_phase += randomness_ratio * random * 1.0 / double(p_data.particle_count);
+	}
+
+	restart_phase *= (1.0 - explosiveness_ratio);
+	double restart_time = restart_phase * lifetime;
+	bool restart = false;
+
+	if (time > p_data.prev_time) {
+		// restart_time >= prev_time is used so particles emit in the first frame they are processed
 
-		if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
+		if (restart_time >= p_data.prev_time && restart_time < time) {
 			restart = true;
+			if (fractional_delta) {
+				local_delta = time - restart_time;
+			}
 		}
 
-		float tv = 0.0;
+	} else if (local_delta > 0.0) {
+		if (restart_time >= p_data.prev_time) {
+			restart = true;
+			if (fractional_delta) {
+				local_delta = lifetime - restart_time + time;
+			}
 
-		if (restart) {
-			if (!emitting) {
-				p.active = false;
-				continue;
+		} else if (restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				local_delta = time - restart_time;
 			}
-			p.active = true;
+		}
+	}
 
-			/*real_t tex_linear_velocity = 0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(0);
-			}*/
+	if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
+		restart = true;
+	}
 
-			real_t tex_angle = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
+	float tv = 0.0;
 
-			real_t tex_anim_offset = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
+	if (restart) {
+		if (!emitting) {
+			p.active = false;
+			return false;
+		}
+		p.active = true;
 
-			p.seed = Math::rand();
+		// Every particle has its own random sequence, so it only depends on the seed, whatever the processing order.
+		RandomPCG rng(hash_murmur3_one_32(uint32_t(p_index), hash_murmur3_one_32(uint32_t(cycle), process_seed)));
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+		/*real_t tex_linear_velocity = 0;
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(0);
+		}*/
 
-			if (color_initial_ramp.is_valid()) {
-				p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
-			} else {
-				p.start_color_rand = Color(1, 1, 1, 1);
-			}
+		real_t tex_angle = 1.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+		}
 
-			real_t angle1_rad = direction.angle() + Math::deg_to_rad((Math::randf() * 2.0 - 1.0) * spread);
-			Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-			p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)Math::randf());
-
-			real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
-			p.rotation = Math::deg_to_rad(base_angle);
-
-			p.custom[0] = 0.0; // unused
-			p.custom[1] = 0.0; // phase [0..1]
-			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand);
-			p.custom[3] = (1.0 - Math::randf() * lifetime_randomness);
-			p.transform = Transform2D();
-			p.time = 0;
-			p.lifetime = lifetime * p.custom[3];
-			p.base_color = Color(1, 1, 1, 1);
-
-			switch (emission_shape) {
-				case EMISSION_SHAPE_POINT: {
-					//do none
-				} break;
-				case EMISSION_SHAPE_SPHERE: {
-					real_t t = Math_TAU * Math::randf();
-					real_t radius = emission_sphere_radius * Math::randf();
-					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
-				} break;
-				case EMISSION_SHAPE_SPHERE_SURFACE: {
-					real_t s = Math::randf(), t = Math_TAU * Math::randf();
-					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
-					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
-				} break;
-				case EMISSION_SHAPE_RECTANGLE: {
-					p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
-				} break;
-				case EMISSION_SHAPE_POINTS:
-				case EMISSION_SHAPE_DIRECTED_POINTS: {
-					int pc = emission_points.size();
-					if (pc == 0) {
-						break;
-					}
+		real_t tex_anim_offset = 1.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
+		}
 
-					int random_idx = Math::rand() % pc;
+		p.seed = rng.rand();
 
-					p.transform[2] = emission_points.get(random_idx);
+		p.angle_rand = rng.randf();
+		p.scale_rand = rng.randf();
+		p.hue_rot_rand = rng.randf();
+		p.anim_offset_rand = rng.randf();
 
-					if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
-						Vector2 normal = emission_normals.get(random_idx);
-						Transform2D m2;
-						m2.columns[0] = normal;
-						m2.columns[1] = normal.orthogonal();
-						p.velocity = m2.basis_xform(p.velocity);
-					}
+		if (color_initial_ramp.is_valid()) {
+			p.start_color_rand = color_initial_ramp->get_color_at_offset(rng.randf());
+		} else {
+			p.start_color_rand = Color(1, 1, 1, 1);
+		}
 
-					if (emission_colors.size() == pc) {
-						p.base_color = emission_colors.get(random_idx);
-					}
-				} break;
-				case EMISSION_SHAPE_MAX: { // Max value for validity check.
+		real_t angle1_rad = direction.angle() + Math::deg_to_rad((rng.randf() * 2.0 - 1.0) * spread);
+		Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
+		p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)rng.randf());
+
+		real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
+		p.rotation = Math::deg_to_rad(base_angle);
+
+		p.custom[0] = 0.0; // unused
+		p.custom[1] = 0.0; // phase [0..1]
+		p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand);
+		p.custom[3] = (1.0 - rng.randf() * lifetime_randomness);
+		p.transform = Transform2D();
+		p.time = 0;
+		p.lifetime = lifetime * p.custom[3];
+		p.base_color = Color(1, 1, 1, 1);
+
+		switch (emission_shape) {
+			case EMISSION_SHAPE_POINT: {
+				//do none
+			} break;
+			case EMISSION_SHAPE_SPHERE: {
+				real_t t = Math_TAU * rng.randf();
+				real_t radius = emission_sphere_radius * rng.randf();
+				p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
+			} break;
+			case EMISSION_SHAPE_SPHERE_SURFACE: {
+				real_t s = rng.randf(), t = Math_TAU * rng.randf();
+				real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
+				p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
+			} break;
+			case EMISSION_SHAPE_RECTANGLE: {
+				p.transform[2] = Vector2(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_rect_extents;
+			} break;
+			case EMISSION_SHAPE_POINTS:
+			case EMISSION_SHAPE_DIRECTED_POINTS: {
+				int pc = emission_points.size();
+				if (pc == 0) {
 					break;
 				}
-			}
 
-			if (!local_coords) {
-				p.velocity = velocity_xform.xform(p.velocity);
-				p.transform = emission_xform * p.transform;
-			}
-
-		} else if (!p.active) {
-			continue;
-		} else if (p.time > p.lifetime) {
-			p.active = false;
-			tv = 1.0;
-		} else {
-			uint32_t alt_seed = p.seed;
+				int random_idx = rng.rand() % pc;
 
-			p.time += local_delta;
-			p.custom[1] = p.time / lifetime;
-			tv = p.time / p.lifetime;
+				p.transform[2] = emission_points.get(random_idx);
 
-			real_t tex_linear_velocity = 1.0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
-			}
+				if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
+					Vector2 normal = emission_normals.get(random_idx);
+					Transform2D m2;
+					m2.columns[0] = normal;
+					m2.columns[1] = normal.orthogonal();
+					p.velocity = m2.basis_xform(p.velocity);
+				}
 
-			real_t tex_orbit_velocity = 1.0;
-			if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-				tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
+				if (emission_colors.size() == pc) {
+					p.base_color = emission_colors.get(random_idx);
+				}
+			} break;
+			case EMISSION_SHAPE_MAX: { // Max value for validity check.
+				break;
 			}
+		}
 
-			real_t tex_angular_velocity = 1.0;
-			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
-			}
+		if (!local_coords) {
+			p.velocity = p_data.velocity_xform.xform(p.velocity);
+			p.transform = p_data.emission_xform * p.transform;
+		}
 
-			real_t tex_linear_accel = 1.0;
-			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
-			}
+	} else if (!p.active) {
+		return false;
+	} else if (p.time > p.lifetime) {
+		p.active = false;
+		tv = 1.0;
+	} else {
+		uint32_t alt_seed = p.seed;
 
-			real_t tex_tangential_accel = 1.0;
-			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
-			}
+		p.time += local_delta;
+		p.custom[1] = p.time / lifetime;
+		tv = p.time / p.lifetime;
 
-			real_t tex_radial_accel = 1.0;
-			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
-			}
+		real_t tex_linear_velocity = 1.0;
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
+		}
 
-			real_t tex_damping = 1.0;
-			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
-			}
+		real_t tex_orbit_velocity = 1.0;
+		if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
+			tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
+		}
 
-			real_t tex_angle = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
-			real_t tex_anim_speed = 1.0;
-			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
-			}
+		real_t tex_angular_velocity = 1.0;
+		if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
+			tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
+		}
 
-			real_t tex_anim_offset = 1.0;
-			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
-			}
+		real_t tex_linear_accel = 1.0;
+		if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
+			tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
+		}
 
-			Vector2 force = gravity;
-			Vector2 pos = p.transform[2];
-
-			//apply linear acceleration
-			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector2();
-			//apply radial acceleration
-			Vector2 org = emission_xform[2];
-			Vector2 diff = pos - org;
-			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector2();
-			//apply tangential acceleration;
-			Vector2 yx = Vector2(diff.y, diff.x);
-			force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector2();
-			//apply attractor forces
-			p.velocity += force * local_delta;
-			//orbit velocity
-			real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
-			if (orbit_amount != 0.0) {
-				real_t ang = orbit_amount * local_delta * Math_TAU;
-				// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
-				// but we use -ang here to reproduce its behavior.
-				Transform2D rot = Transform2D(-ang, Vector2());
-				p.transform[2] -= diff;
-				p.transform[2] += rot.basis_xform(diff);
-			}
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				p.velocity = p.velocity.normalized() * tex_linear_velocity;
-			}
+		real_t tex_tangential_accel = 1.0;
+		if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
+			tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
+		}
 
-			if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
-				real_t v = p.velocity.length();
-				real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
-				v -= damp * local_delta;
-				if (v < 0.0) {
-					p.velocity = Vector2();
-				} else {
-					p.velocity = p.velocity.normalized() * v;
-				}
-			}
-			real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
-			base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
-			p.rotation = Math::deg_to_rad(base_angle); //angle
-			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed));
+		real_t tex_radial_accel = 1.0;
+		if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
+			tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
 		}
-		//apply color
-		//apply hue rotation
 
-		Vector2 tex_scale = Vector2(1.0, 1.0);
-		if (split_scale) {
-			if (scale_curve_x.is_valid()) {
-				tex_scale.x = scale_curve_x->sample(tv);
-			} else {
-				tex_scale.x = 1.0;
-			}
-			if (scale_curve_y.is_valid()) {
-				tex_scale.y = scale_curve_y->sample(tv);
-			} else {
-				tex_scale.y = 1.0;
-			}
-		} else {
-			if (curve_parameters[PARAM_SCALE].is_valid()) {
-				real_t tmp_scale = curve_parameters[PARAM_SCALE]->sample(tv);
-				tex_scale.x = tmp_scale;
-				tex_scale.y = tmp_scale;
-			}
+		real_t tex_damping = 1.0;
+		if (curve_parameters[PARAM_DAMPING].is_valid()) {
+			tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
 		}
 
-		real_t tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->sample(tv);
+		real_t tex_angle = 1.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+		}
+		real_t tex_anim_speed = 1.0;
+		if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
+			tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
 		}
 
-		real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
-		real_t hue_rot_c = Math::cos(hue_rot_angle);
-		real_t hue_rot_s = Math::sin(hue_rot_angle);
+		real_t tex_anim_offset = 1.0;
+		if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
+			tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
+		}
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+		Vector2 force = gravity;
+		Vector2 pos = p.transform[2];
+
+		//apply linear acceleration
+		force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector2();
+		//apply radial acceleration
+		Vector2 org = p_data.emission_xform[2];
+		Vector2 diff = pos - org;
+		force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector2();
+		//apply tangential acceleration;
+		Vector2 yx = Vector2(diff.y, diff.x);
+		force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector2();
+		//apply attractor forces
+		p.velocity += force * local_delta;
+		//orbit velocity
+		real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
+		if (orbit_amount != 0.0) {
+			real_t ang = orbit_amount * local_delta * Math_TAU;
+			// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
+			// but we use -ang here to reproduce its behavior.
+			Transform2D rot = Transform2D(-ang, Vector2());
+			p.transform[2] -= diff;
+			p.transform[2] += rot.basis_xform(diff);
+		}
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			p.velocity = p.velocity.normalized() * tex_linear_velocity;
+		}
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+		if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
+			real_t v = p.velocity.length();
+			real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
+			v -= damp * local_delta;
+			if (v < 0.0) {
+				p.velocity = Vector2();
+			} else {
+				p.velocity = p.velocity.normalized() * v;
 			}
 		}
+		real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
+		base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
+		p.rotation = Math::deg_to_rad(base_angle); //angle
+		p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed));
+	}
+	//apply color
+	//apply hue rotation
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(tv) * color;
+	Vector2 tex_scale = Vector2(1.0, 1.0);
+	if (split_scale) {
+		if (scale_curve_x.is_valid()) {
+			tex_scale.x = scale_curve_x->sample(tv);
 		} else {
-			p.color = color;
+			tex_scale.x = 1.0;
+		}
+		if (scale_curve_y.is_valid()) {
+			tex_scale.y = scale_curve_y->sample(tv);
+		} else {
+			tex_scale.y = 1.0;
+		}
+	} else {
+		if (curve_parameters[PARAM_SCALE].is_valid()) {
+			real_t tmp_scale = curve_parameters[PARAM_SCALE]->sample(tv);
+			tex_scale.x = tmp_scale;
+			tex_scale.y = tmp_scale;
 		}
+	}
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
+	real_t tex_hue_variation = 0.0;
+	if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
+		tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->sample(tv);
+	}
 
-		p.color *= p.base_color * p.start_color_rand;
+	real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
+	real_t hue_rot_c = Math::cos(hue_rot_angle);
+	real_t hue_rot_s = Math::sin(hue_rot_angle);
 
-		if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
-			if (p.velocity.length() > 0.0) {
-				p.transform.columns[1] = p.velocity.normalized();
-				p.transform.columns[0] = p.transform.columns[1].orthogonal();
-			}
+	Basis hue_rot_mat;
+	{
+		Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+		Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+		Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
 
-		} else {
-			p.transform.columns[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
-			p.transform.columns[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
+		for (int j = 0; j < 3; j++) {
+			hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
 		}
+	}
 
-		//scale by scale
-		Vector2 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
-		if (base_scale.x < 0.00001) {
-			base_scale.x = 0.00001;
-		}
-		if (base_scale.y < 0.00001) {
-			base_scale.y = 0.00001;
+	if (color_ramp.is_valid()) {
+		p.color = color_ramp->get_color_at_offset(tv) * color;
+	} else {
+		p.color = color;
+	}
+
+	Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
+	p.color.r = color_rgb.x;
+	p.color.g = color_rgb.y;
+	p.color.b = color_rgb.z;
+
+	p.color *= p.base_color * p.start_color_rand;
+
+	if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
+		if (p.velocity.length() > 0.0) {
+			p.transform.columns[1] = p.velocity.normalized();
+			p.transform.columns[0] = p.transform.columns[1].orthogonal();
 		}
-		p.transform.columns[0] *= base_scale.x;
-		p.transform.columns[1] *= base_scale.y;
 
-		p.transform[2] += p.velocity * local_delta;
+	} else {
+		p.transform.columns[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
+		p.transform.columns[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
+	}
 
-		should_be_active = true;
+	//scale by scale
+	Vector2 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
+	if (base_scale.x < 0.00001) {
+		base_scale.x = 0.00001;
 	}
-	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
-		active = false;
-		emit_signal(SceneStringName(finished));
+	if (base_scale.y < 0.00001) {
+		base_scale.y = 0.00001;
 	}
+	p.transform.columns[0] *= base_scale.x;
+	p.transform.columns[1] *= base_scale.y;
+
+	p.transform[2] += p.velocity * local_delta;
+
+	return true;
+}
+
+void CPUParticles2D::_write_particle_data(const Particle &p_particle, float *r_data) const {
+	Transform2D t = p_particle.transform;
+
+	if (!local_coords) {
+		t = inv_emission_transform * t;
+	}
+
+	if (p_particle.active) {
+		r_data[0] = t.columns[0][0];
+		r_data[1] = t.columns[1][0];
+		r_data[2] = 0;
+		r_data[3] = t.columns[2][0];
+		r_data[4] = t.columns[0][1];
+		r_data[5] = t.columns[1][1];
+		r_data[6] = 0;
+		r_data[7] = t.columns[2][1];
+
+	} else {
+		memset(r_data, 0, sizeof(float) * 8);
+	}
+
+	Color c = p_particle.color;
+
+	r_data[8] = c.r;
+	r_data[9] = c.g;
+	r_data[10] = c.b;
+	r_data[11] = c.a;
+
+	r_data[12] = p_particle.custom[0];
+	r_data[13] = p_particle.custom[1];
+	r_data[14] = p_particle.custom[2];
+	r_data[15] = p_particle.custom[3];
 }
 
 void CPUParticles2D::_update_particle_data_buffer() {
@@ -1032,39 +1168,7 @@ void CPUParticles2D::_update_particle_data_buffer() {
 
 	for (int i = 0; i < pc; i++) {
 		int idx = order ? order[i] : i;
-
-		Transform2D t = r[idx].transform;
-
-		if (!local_coords) {
-			t = inv_emission_transform * t;
-		}
-
-		if (r[idx].active) {
-			ptr[0] = t.columns[0][0];
-			ptr[1] = t.columns[1][0];
-			ptr[2] = 0;
-			ptr[3] = t.columns[2][0];
-			ptr[4] = t.columns[0][1];
-			ptr[5] = t.columns[1][1];
-			ptr[6] = 0;
-			ptr[7] = t.columns[2][1];
-
-		} else {
-			memset(ptr, 0, sizeof(float) * 8);
-		}
-
-		Color c = r[idx].color;
-
-		ptr[8] = c.r;
-		ptr[9] = c.g;
-		ptr[10] = c.b;
-		ptr[11] = c.a;
-
-		ptr[12] = r[idx].custom[0];
-		ptr[13] = r[idx].custom[1];
-		ptr[14] = r[idx].custom[2];
-		ptr[15] = r[idx].custom[3];
-
+		_write_particle_data(r[idx], ptr);
 		ptr += 16;
 	}
 }
@@ -1278,6 +1382,10 @@ void CPUParticles2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_use_local_coordinates"), &CPUParticles2D::get_use_local_coordinates);
 	ClassDB::bind_method(D_METHOD("get_fixed_fps"), &CPUParticles2D::get_fixed_fps);
 	ClassDB::bind_method(D_METHOD("get_fractional_delta"), &CPUParticles2D::get_fractional_delta);
+	ClassDB::bind_method(D_METHOD("set_use_fixed_seed", "use_fixed_seed"), &CPUParticles2D::set_use_fixed_seed);
+	ClassDB::bind_method(D_METHOD("get_use_fixed_seed"), &CPUParticles2D::get_use_fixed_seed);
+	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &CPUParticles2D::set_seed);
+	ClassDB::bind_method(D_METHOD("get_seed"), &CPUParticles2D::get_seed);
 	ClassDB::bind_method(D_METHOD("get_speed_scale"), &CPUParticles2D::get_speed_scale);
 
 	ClassDB::bind_method(D_METHOD("set_draw_order", "order"), &CPUParticles2D::set_draw_order);
@@ -1301,6 +1409,8 @@ void CPUParticles2D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lifetime_randomness", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_lifetime_randomness", "get_lifetime_randomness");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "fixed_fps", PROPERTY_HINT_RANGE, "0,1000,1,suffix:FPS"), "set_fixed_fps", "get_fixed_fps");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "fract_delta"), "set_fractional_delta", "get_fractional_delta");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_fixed_seed", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), "set_use_fixed_seed", "get_use_fixed_seed");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed", PROPERTY_HINT_RANGE, "0,4294967295,1"), "set_seed", "get_seed");
 	ADD_GROUP("Drawing", "");
 	// No visibility_rect property contrarily to Particles2D, it's updated automatically.
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "local_coords"), "set_use_local_coordinates", "get_use_local_coordinates");
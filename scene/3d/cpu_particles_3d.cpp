@@ -30,6 +30,9 @@
 
 #include "cpu_particles_3d.h"
 
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/main/viewport.h"
@@ -202,6 +205,26 @@ bool CPUParticles3D::get_fractional_delta() const {
 	return fractional_delta;
 }
 
+void CPUParticles3D::set_use_fixed_seed(bool p_use_fixed_seed) {
+	if (use_fixed_seed == p_use_fixed_seed) {
+		return;
+	}
+	use_fixed_seed = p_use_fixed_seed;
+	notify_property_list_changed();
+}
+
+bool CPUParticles3D::get_use_fixed_seed() const {
+	return use_fixed_seed;
+}
+
+void CPUParticles3D::set_seed(uint32_t p_seed) {
+	seed = p_seed;
+}
+
+uint32_t CPUParticles3D::get_seed() const {
+	return seed;
+}
+
 PackedStringArray CPUParticles3D::get_configuration_warnings() const {
 	PackedStringArray warnings = GeometryInstance3D::get_configuration_warnings();
 
@@ -547,6 +570,10 @@ void CPUParticles3D::_validate_property(PropertyInfo &p_property) const {
 		p_property.hint = one_shot ? PROPERTY_HINT_ONESHOT : PROPERTY_HINT_NONE;
 	}
 
+	if (p_property.name == "seed" && !use_fixed_seed) {
+		p_property.usage = PROPERTY_USAGE_NONE;
+	}
+
 	if (p_property.name == "emission_sphere_radius" && (emission_shape != EMISSION_SHAPE_SPHERE && emission_shape != EMISSION_SHAPE_SPHERE_SURFACE)) {
 		p_property.usage = PROPERTY_USAGE_NONE;
 	}
@@ -618,6 +645,7 @@ void CPUParticles3D::_update_internal() {
 	_set_redraw(true);
 
 	bool processed = false;
+	bool buffer_updated = false;
 
 	if (time == 0 && pre_process_time > 0.0) {
 		double frame_time;
@@ -649,24 +677,27 @@ void CPUParticles3D::_update_internal() {
 		double todo = frame_remainder + ldelta;
 
 		while (todo >= frame_time) {
-			_particles_process(frame_time);
-			processed = true;
 			todo -= decr;
+			// The last step fills the instance data as it goes.
+			buffer_updated = draw_order == DRAW_ORDER_INDEX && todo < frame_time;
+			_particles_process(frame_time, buffer_updated);
+			processed = true;
 		}
 
 		frame_remainder = todo;
 
 	} else {
-		_particles_process(delta);
+		buffer_updated = draw_order == DRAW_ORDER_INDEX;
+		_particles_process(delta, buffer_updated);
 		processed = true;
 	}
 
-	if (processed) {
+	if (processed && !buffer_updated) {
 		_update_particle_data_buffer();
 	}
 }
 
-void CPUParticles3D::_particles_process(double p_delta) {
+void CPUParticles3D::_particles_process(double p_delta, bool p_update_buffer) {
 	p_delta *= speed_scale;
 
 	int pcount = particles.size();
@@ -674,6 +705,11 @@ void CPUParticles3D::_particles_process(double p_delta) {
 
 	Particle *parray = w;
 
+	if (time == 0 && cycle == 0) {
+		// The emission starts over.
+		process_seed = use_fixed_seed ? seed : Math::rand();
+	}
+
 	double prev_time = time;
 	time += p_delta;
 	if (time > lifetime) {
@@ -694,487 +730,588 @@ void CPUParticles3D::_particles_process(double p_delta) {
 
 	double system_phase = time / lifetime;
 
+	// Gradients sort their points when they are first read, which must not happen from several threads.
+	if (color_ramp.is_valid() && color_ramp->get_point_count() > 0) {
+		color_ramp->get_offset(0);
+	}
+	if (color_initial_ramp.is_valid() && color_initial_ramp->get_point_count() > 0) {
+		color_initial_ramp->get_offset(0);
+	}
+
+	ParticlesProcessData data;
+	data.particles = parray;
+	data.particle_count = pcount;
+	data.delta = p_delta;
+	data.prev_time = prev_time;
+	data.system_phase = system_phase;
+	data.emission_xform = emission_xform;
+	data.velocity_xform = velocity_xform;
+
+	if (p_update_buffer) {
+		update_mutex.lock();
+		data.buffer = particle_data.ptrw();
+	}
+
 	bool should_be_active = false;
-	for (int i = 0; i < pcount; i++) {
-		Particle &p = parray[i];
+	const int chunk_count = (pcount + PROCESS_CHUNK_SIZE - 1) / PROCESS_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		// Particles are independent of each other, so they can be processed in any order.
+		data.chunk_active.resize(chunk_count);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_particles_process_chunk, &data, chunk_count, -1, true, SNAME("CPUParticles3DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		for (const bool chunk_active : data.chunk_active) {
+			should_be_active = should_be_active || chunk_active;
+		}
+	} else {
+		should_be_active = _particles_process_range(0, pcount, data);
+	}
+
+	if (p_update_buffer) {
+		can_update.set();
+		update_mutex.unlock();
+	}
 
-		if (!emitting && !p.active) {
-			continue;
+	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
+		active = false;
+		emit_signal(SceneStringName(finished));
+	}
+}
+
+void CPUParticles3D::_particles_process_chunk(uint32_t p_chunk, ParticlesProcessData *p_data) {
+	const int from = p_chunk * PROCESS_CHUNK_SIZE;
+	const int to = MIN(from + PROCESS_CHUNK_SIZE, p_data->particle_count);
+	p_data->chunk_active[p_chunk] = _particles_process_range(from, to, *p_data);
+}
+
+bool CPUParticles3D::_particles_process_range(int p_from, int p_to, const ParticlesProcessData &p_data) {
+	bool should_be_active = false;
+	for (int i = p_from; i < p_to; i++) {
+		if (_particle_process(p_data.particles[i], i, p_data)) {
+			should_be_active = true;
+		}
+		if (p_data.buffer) {
+			_write_particle_data(p_data.particles[i], p_data.buffer + i * 20);
 		}
+	}
+	return should_be_active;
+}
 
-		double local_delta = p_delta;
+// Return whether the particle is still active.
+bool CPUParticles3D::_particle_process(Particle &r_particle, int p_index, const ParticlesProcessData &p_data) {
+	Particle &p = r_particle;
 
-		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
-		// While we use time in tests later on, for randomness we use the phase as done in the
-		// original shader code, and we later multiply by lifetime to get the time.
-		double restart_phase = double(i) / double(pcount);
+	if (!emitting && !p.active) {
+		return false;
+	}
 
-		if (randomness_ratio > 0.0) {
-			uint32_t seed = cycle;
-			if (restart_phase >= system_phase) {
-				seed -= uint32_t(1);
-			}
-			seed *= uint32_t(pcount);
-			seed += uint32_t(i);
-			double random = double(idhash(seed) % uint32_t(65536)) / 65536.0;
-			restart_phase += randomness_ratio * random * 1.0 / double(pcount);
+	double local_delta = p_data.delta;
+
+	// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
+	// While we use time in tests later on, for randomness we use the phase as done in the
+	// original shader code, and we later multiply by lifetime to get the time.
+	double restart_phase = double(p_index) / double(p_data.particle_count);
+
+	if (randomness_ratio > 0.0) {
+		uint32_t phase_seed = cycle;
+		if (restart_phase >= p_data.system_phase) {
+			phase_seed -= uint32_t(1);
 		}
+		phase_seed *= uint32_t(p_data.particle_count);
+		phase_seed += uint32_t(p_index);
+		double random = double(idhash(phase_seed) % uint32_t(65536)) / 65536.0;
+		restart_phase += randomness_ratio * random * 1.0 / double(p_data.particle_count);
+	}
 
-		restart_phase *= (1.0 - explosiveness_ratio);
-		double restart_time = restart_phase * lifetime;
-		bool restart = false;
+	restart_phase *= (1.0 - explosiveness_ratio);
+	double restart_time = restart_phase * lifetime;
+	bool restart = false;
 
-		if (time > prev_time) {
-			// restart_time >= prev_time is used so particles emit in the first frame they are processed
+	if (time > p_data.prev_time) {
+		// restart_time >= prev_time is used so particles emit in the first frame they are processed
 
-			if (restart_time >= prev_time && restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
+		if (restart_time >= p_data.prev_time && restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				local_delta = time - restart_time;
 			}
+		}
 
-		} else if (local_delta > 0.0) {
-			if (restart_time >= prev_time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = lifetime - restart_time + time;
-				}
+	} else if (local_delta > 0.0) {
+		if (restart_time >= p_data.prev_time) {
+			restart = true;
+			if (fractional_delta) {
+				local_delta = lifetime - restart_time + time;
+			}
 
-			} else if (restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
+		} else if (restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				local_delta = time - restart_time;
 			}
 		}
+	}
 
-		if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
-			restart = true;
+	if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
+		restart = true;
+	}
+
+	float tv = 0.0;
+
+	if (restart) {
+		if (!emitting) {
+			p.active = false;
+			return false;
 		}
+		p.active = true;
 
-		float tv = 0.0;
+		// Every particle has its own random sequence, so it only depends on the seed, whatever the processing order.
+		RandomPCG rng(hash_murmur3_one_32(uint32_t(p_index), hash_murmur3_one_32(uint32_t(cycle), process_seed)));
 
-		if (restart) {
-			if (!emitting) {
-				p.active = false;
-				continue;
-			}
-			p.active = true;
+		/*real_t tex_linear_velocity = 0;
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(0);
+		}*/
 
-			/*real_t tex_linear_velocity = 0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(0);
-			}*/
+		real_t tex_angle = 1.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+		}
 
-			real_t tex_angle = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
+		real_t tex_anim_offset = 1.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
+		}
 
-			real_t tex_anim_offset = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
+		p.seed = rng.rand();
 
-			p.seed = Math::rand();
+		p.angle_rand = rng.randf();
+		p.scale_rand = rng.randf();
+		p.hue_rot_rand = rng.randf();
+		p.anim_offset_rand = rng.randf();
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+		if (color_initial_ramp.is_valid()) {
+			p.start_color_rand = color_initial_ramp->get_color_at_offset(rng.randf());
+		} else {
+			p.start_color_rand = Color(1, 1, 1, 1);
+		}
 
-			if (color_initial_ramp.is_valid()) {
-				p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
+		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+			real_t angle1_rad = Math::atan2(direction.y, direction.x) + Math::deg_to_rad((rng.randf() * 2.0 - 1.0) * spread);
+			Vector3 rot = Vector3(Math::cos(angle1_rad), Math::sin(angle1_rad), 0.0);
+			p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)rng.randf());
+		} else {
+			//initiate velocity spread in 3D
+			real_t angle1_rad = Math::deg_to_rad((rng.randf() * (real_t)2.0 - (real_t)1.0) * spread);
+			real_t angle2_rad = Math::deg_to_rad((rng.randf() * (real_t)2.0 - (real_t)1.0) * ((real_t)1.0 - flatness) * spread);
+
+			Vector3 direction_xz = Vector3(Math::sin(angle1_rad), 0, Math::cos(angle1_rad));
+			Vector3 direction_yz = Vector3(0, Math::sin(angle2_rad), Math::cos(angle2_rad));
+			Vector3 spread_direction = Vector3(direction_xz.x * direction_yz.z, direction_yz.y, direction_xz.z * direction_yz.z);
+			Vector3 direction_nrm = direction;
+			if (direction_nrm.length_squared() > 0) {
+				direction_nrm.normalize();
 			} else {
-				p.start_color_rand = Color(1, 1, 1, 1);
+				direction_nrm = Vector3(0, 0, 1);
 			}
-
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				real_t angle1_rad = Math::atan2(direction.y, direction.x) + Math::deg_to_rad((Math::randf() * 2.0 - 1.0) * spread);
-				Vector3 rot = Vector3(Math::cos(angle1_rad), Math::sin(angle1_rad), 0.0);
-				p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)Math::randf());
-			} else {
-				//initiate velocity spread in 3D
-				real_t angle1_rad = Math::deg_to_rad((Math::randf() * (real_t)2.0 - (real_t)1.0) * spread);
-				real_t angle2_rad = Math::deg_to_rad((Math::randf() * (real_t)2.0 - (real_t)1.0) * ((real_t)1.0 - flatness) * spread);
-
-				Vector3 direction_xz = Vector3(Math::sin(angle1_rad), 0, Math::cos(angle1_rad));
-				Vector3 direction_yz = Vector3(0, Math::sin(angle2_rad), Math::cos(angle2_rad));
-				Vector3 spread_direction = Vector3(direction_xz.x * direction_yz.z, direction_yz.y, direction_xz.z * direction_yz.z);
-				Vector3 direction_nrm = direction;
-				if (direction_nrm.length_squared() > 0) {
-					direction_nrm.normalize();
-				} else {
-					direction_nrm = Vector3(0, 0, 1);
-				}
-				// rotate spread to direction
-				Vector3 binormal = Vector3(0.0, 1.0, 0.0).cross(direction_nrm);
-				if (binormal.length_squared() < 0.00000001) {
-					// direction is parallel to Y. Choose Z as the binormal.
-					binormal = Vector3(0.0, 0.0, 1.0);
-				}
-				binormal.normalize();
-				Vector3 normal = binormal.cross(direction_nrm);
-				spread_direction = binormal * spread_direction.x + normal * spread_direction.y + direction_nrm * spread_direction.z;
-				p.velocity = spread_direction * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)Math::randf());
+			// rotate spread to direction
+			Vector3 binormal = Vector3(0.0, 1.0, 0.0).cross(direction_nrm);
+			if (binormal.length_squared() < 0.00000001) {
+				// direction is parallel to Y. Choose Z as the binormal.
+				binormal = Vector3(0.0, 0.0, 1.0);
 			}
+			binormal.normalize();
+			Vector3 normal = binormal.cross(direction_nrm);
+			spread_direction = binormal * spread_direction.x + normal * spread_direction.y + direction_nrm * spread_direction.z;
+			p.velocity = spread_direction * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)rng.randf());
+		}
 
-			real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
-			p.custom[0] = Math::deg_to_rad(base_angle); //angle
-			p.custom[1] = 0.0; //phase
-			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand); //animation offset (0-1)
-			p.custom[3] = (1.0 - Math::randf() * lifetime_randomness);
-			p.transform = Transform3D();
-			p.time = 0;
-			p.lifetime = lifetime * p.custom[3];
-			p.base_color = Color(1, 1, 1, 1);
-
-			switch (emission_shape) {
-				case EMISSION_SHAPE_POINT: {
-					//do none
-				} break;
-				case EMISSION_SHAPE_SPHERE: {
-					real_t s = 2.0 * Math::randf() - 1.0;
-					real_t t = Math_TAU * Math::randf();
-					real_t x = Math::randf();
-					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
-					p.transform.origin = Vector3(0, 0, 0).lerp(Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s), x);
-				} break;
-				case EMISSION_SHAPE_SPHERE_SURFACE: {
-					real_t s = 2.0 * Math::randf() - 1.0;
-					real_t t = Math_TAU * Math::randf();
-					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
-					p.transform.origin = Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s);
-				} break;
-				case EMISSION_SHAPE_BOX: {
-					p.transform.origin = Vector3(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_box_extents;
-				} break;
-				case EMISSION_SHAPE_POINTS:
-				case EMISSION_SHAPE_DIRECTED_POINTS: {
-					int pc = emission_points.size();
-					if (pc == 0) {
-						break;
-					}
-
-					int random_idx = Math::rand() % pc;
-
-					p.transform.origin = emission_points.get(random_idx);
-
-					if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
-						if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-							Vector3 normal = emission_normals.get(random_idx);
-							Vector2 normal_2d(normal.x, normal.y);
-							Transform2D m2;
-							m2.columns[0] = normal_2d;
-							m2.columns[1] = normal_2d.orthogonal();
-							Vector2 velocity_2d(p.velocity.x, p.velocity.y);
-							velocity_2d = m2.basis_xform(velocity_2d);
-							p.velocity.x = velocity_2d.x;
-							p.velocity.y = velocity_2d.y;
-						} else {
-							Vector3 normal = emission_normals.get(random_idx);
-							Vector3 v0 = Math::abs(normal.z) < 0.999 ? Vector3(0.0, 0.0, 1.0) : Vector3(0, 1.0, 0.0);
-							Vector3 tangent = v0.cross(normal).normalized();
-							Vector3 bitangent = tangent.cross(normal).normalized();
-							Basis m3;
-							m3.set_column(0, tangent);
-							m3.set_column(1, bitangent);
-							m3.set_column(2, normal);
-							p.velocity = m3.xform(p.velocity);
-						}
-					}
+		real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
+		p.custom[0] = Math::deg_to_rad(base_angle); //angle
+		p.custom[1] = 0.0; //phase
+		p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand); //animation offset (0-1)
+		p.custom[3] = (1.0 - rng.randf() * lifetime_randomness);
+		p.transform = Transform3D();
+		p.time = 0;
+		p.lifetime = lifetime * p.custom[3];
+		p.base_color = Color(1, 1, 1, 1);
+
+		switch (emission_shape) {
+			case EMISSION_SHAPE_POINT: {
+				//do none
+			} break;
+			case EMISSION_SHAPE_SPHERE: {
+				real_t s = 2.0 * rng.randf() - 1.0;
+				real_t t = Math_TAU * rng.randf();
+				real_t x = rng.randf();
+				real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
+				p.transform.origin = Vector3(0, 0, 0).lerp(Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s), x);
+			} break;
+			case EMISSION_SHAPE_SPHERE_SURFACE: {
+				real_t s = 2.0 * rng.randf() - 1.0;
+				real_t t = Math_TAU * rng.randf();
+				real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
+				p.transform.origin = Vector3(radius * Math::cos(t), radius * Math::sin(t), emission_sphere_radius * s);
+			} break;
+			case EMISSION_SHAPE_BOX: {
+				p.transform.origin = Vector3(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * emission_box_extents;
+			} break;
+			case EMISSION_SHAPE_POINTS:
+			case EMISSION_SHAPE_DIRECTED_POINTS: {
+				int pc = emission_points.size();
+				if (pc == 0) {
+					break;
+				}
 
-					if (emission_colors.size() == pc) {
-						p.base_color = emission_colors.get(random_idx);
-					}
-				} break;
-				case EMISSION_SHAPE_RING: {
-					real_t radius_clamped = MAX(0.001, emission_ring_radius);
-					real_t top_radius = MAX(radius_clamped - Math::tan(Math::deg_to_rad(90.0 - emission_ring_cone_angle)) * emission_ring_height, 0.0);
-					real_t y_pos = Math::randf();
-					real_t skew = MAX(MIN(radius_clamped, top_radius) / MAX(radius_clamped, top_radius), 0.5);
-					y_pos = radius_clamped < top_radius ? Math::pow(y_pos, skew) : 1.0 - Math::pow(y_pos, skew);
-					real_t ring_random_angle = Math::randf() * Math_TAU;
-					real_t ring_random_radius = Math::sqrt(Math::randf() * (radius_clamped * radius_clamped - emission_ring_inner_radius * emission_ring_inner_radius) + emission_ring_inner_radius * emission_ring_inner_radius);
-					ring_random_radius = Math::lerp(ring_random_radius, ring_random_radius * (top_radius / radius_clamped), y_pos);
-					Vector3 axis = emission_ring_axis == Vector3(0.0, 0.0, 0.0) ? Vector3(0.0, 0.0, 1.0) : emission_ring_axis.normalized();
-					Vector3 ortho_axis;
-					if (axis.abs() == Vector3(1.0, 0.0, 0.0)) {
-						ortho_axis = Vector3(0.0, 1.0, 0.0).cross(axis);
+				int random_idx = rng.rand() % pc;
+
+				p.transform.origin = emission_points.get(random_idx);
+
+				if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
+					if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+						Vector3 normal = emission_normals.get(random_idx);
+						Vector2 normal_2d(normal.x, normal.y);
+						Transform2D m2;
+						m2.columns[0] = normal_2d;
+						m2.columns[1] = normal_2d.orthogonal();
+						Vector2 velocity_2d(p.velocity.x, p.velocity.y);
+						velocity_2d = m2.basis_xform(velocity_2d);
+						p.velocity.x = velocity_2d.x;
+						p.velocity.y = velocity_2d.y;
 					} else {
-						ortho_axis = Vector3(1.0, 0.0, 0.0).cross(axis);
+						Vector3 normal = emission_normals.get(random_idx);
+						Vector3 v0 = Math::abs(normal.z) < 0.999 ? Vector3(0.0, 0.0, 1.0) : Vector3(0, 1.0, 0.0);
+						Vector3 tangent = v0.cross(normal).normalized();
+						Vector3 bitangent = tangent.cross(normal).normalized();
+						Basis m3;
+						m3.set_column(0, tangent);
+						m3.set_column(1, bitangent);
+						m3.set_column(2, normal);
+						p.velocity = m3.xform(p.velocity);
 					}
-					ortho_axis = ortho_axis.normalized();
-					ortho_axis.rotate(axis, ring_random_angle);
-					ortho_axis = ortho_axis.normalized();
-					p.transform.origin = ortho_axis * ring_random_radius + (y_pos * emission_ring_height - emission_ring_height / 2.0) * axis;
-				} break;
-				case EMISSION_SHAPE_MAX: { // Max value for validity check.
-					break;
 				}
-			}
 
-			if (!local_coords) {
-				p.velocity = velocity_xform.xform(p.velocity);
-				p.transform = emission_xform * p.transform;
+				if (emission_colors.size() == pc) {
+					p.base_color = emission_colors.get(random_idx);
+				}
+			} break;
+			case EMISSION_SHAPE_RING: {
+				real_t radius_clamped = MAX(0.001, emission_ring_radius);
+				real_t top_radius = MAX(radius_clamped - Math::tan(Math::deg_to_rad(90.0 - emission_ring_cone_angle)) * emission_ring_height, 0.0);
+				real_t y_pos = rng.randf();
+				real_t skew = MAX(MIN(radius_clamped, top_radius) / MAX(radius_clamped, top_radius), 0.5);
+				y_pos = radius_clamped < top_radius ? Math::pow(y_pos, skew) : 1.0 - Math::pow(y_pos, skew);
+				real_t ring_random_angle = rng.randf() * Math_TAU;
+				real_t ring_random_radius = Math::sqrt(rng.randf() * (radius_clamped * radius_clamped - emission_ring_inner_radius * emission_ring_inner_radius) + emission_ring_inner_radius * emission_ring_inner_radius);
+				ring_random_radius = Math::lerp(ring_random_radius, ring_random_radius * (top_radius / radius_clamped), y_pos);
+				Vector3 axis = emission_ring_axis == Vector3(0.0, 0.0, 0.0) ? Vector3(0.0, 0.0, 1.0) : emission_ring_axis.normalized();
+				Vector3 ortho_axis;
+				if (axis.abs() == Vector3(1.0, 0.0, 0.0)) {
+					ortho_axis = Vector3(0.0, 1.0, 0.0).cross(axis);
+				} else {
+					ortho_axis = Vector3(1.0, 0.0, 0.0).cross(axis);
+				}
+				ortho_axis = ortho_axis.normalized();
+				ortho_axis.rotate(axis, ring_random_angle);
+				ortho_axis = ortho_axis.normalized();
+				p.transform.origin = ortho_axis * ring_random_radius + (y_pos * emission_ring_height - emission_ring_height / 2.0) * axis;
+			} break;
+			case EMISSION_SHAPE_MAX: { // Max value for validity check.
+				break;
 			}
+		}
 
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				p.velocity.z = 0.0;
-				p.transform.origin.z = 0.0;
-			}
+		if (!local_coords) {
+			p.velocity = p_data.velocity_xform.xform(p.velocity);
+			p.transform = p_data.emission_xform * p.transform;
+		}
 
-		} else if (!p.active) {
-			continue;
-		} else if (p.time > p.lifetime) {
-			p.active = false;
-			tv = 1.0;
-		} else {
-			uint32_t alt_seed = p.seed;
+		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+			p.velocity.z = 0.0;
+			p.transform.origin.z = 0.0;
+		}
 
-			p.time += local_delta;
-			p.custom[1] = p.time / lifetime;
-			tv = p.time / p.lifetime;
+	} else if (!p.active) {
+		return false;
+	} else if (p.time > p.lifetime) {
+		p.active = false;
+		tv = 1.0;
+	} else {
+		uint32_t alt_seed = p.seed;
 
-			real_t tex_linear_velocity = 1.0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
-			}
+		p.time += local_delta;
+		p.custom[1] = p.time / lifetime;
+		tv = p.time / p.lifetime;
 
-			real_t tex_orbit_velocity = 1.0;
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-					tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
-				}
-			}
+		real_t tex_linear_velocity = 1.0;
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
+		}
 
-			real_t tex_angular_velocity = 1.0;
-			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
+		real_t tex_orbit_velocity = 1.0;
+		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+			if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
+				tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
 			}
+		}
 
-			real_t tex_linear_accel = 1.0;
-			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
-			}
+		real_t tex_angular_velocity = 1.0;
+		if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
+			tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
+		}
 
-			real_t tex_tangential_accel = 1.0;
-			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
-			}
+		real_t tex_linear_accel = 1.0;
+		if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
+			tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
+		}
 
-			real_t tex_radial_accel = 1.0;
-			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
-			}
+		real_t tex_tangential_accel = 1.0;
+		if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
+			tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
+		}
 
-			real_t tex_damping = 1.0;
-			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
-			}
+		real_t tex_radial_accel = 1.0;
+		if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
+			tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
+		}
 
-			real_t tex_angle = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
-			real_t tex_anim_speed = 1.0;
-			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
-			}
+		real_t tex_damping = 1.0;
+		if (curve_parameters[PARAM_DAMPING].is_valid()) {
+			tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
+		}
 
-			real_t tex_anim_offset = 1.0;
-			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
-			}
+		real_t tex_angle = 1.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+		}
+		real_t tex_anim_speed = 1.0;
+		if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
+			tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
+		}
 
-			Vector3 force = gravity;
-			Vector3 position = p.transform.origin;
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				position.z = 0.0;
-			}
-			//apply linear acceleration
-			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector3();
-			//apply radial acceleration
-			Vector3 org = emission_xform.origin;
-			Vector3 diff = position - org;
-			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector3();
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				Vector2 yx = Vector2(diff.y, diff.x);
-				Vector2 yx2 = (yx * Vector2(-1.0, 1.0)).normalized();
-				force += yx.length() > 0.0 ? Vector3(yx2.x, yx2.y, 0.0) * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector3();
+		real_t tex_anim_offset = 1.0;
+		if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
+			tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
+		}
 
-			} else {
-				Vector3 crossDiff = diff.normalized().cross(gravity.normalized());
-				force += crossDiff.length() > 0.0 ? crossDiff.normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector3();
-			}
-			//apply attractor forces
-			p.velocity += force * local_delta;
-			//orbit velocity
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
-				if (orbit_amount != 0.0) {
-					real_t ang = orbit_amount * local_delta * Math_TAU;
-					// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
-					// but we use -ang here to reproduce its behavior.
-					Transform2D rot = Transform2D(-ang, Vector2());
-					Vector2 rotv = rot.basis_xform(Vector2(diff.x, diff.y));
-					p.transform.origin -= Vector3(diff.x, diff.y, 0);
-					p.transform.origin += Vector3(rotv.x, rotv.y, 0);
-				}
-			}
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				p.velocity = p.velocity.normalized() * tex_linear_velocity;
-			}
+		Vector3 force = gravity;
+		Vector3 position = p.transform.origin;
+		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+			position.z = 0.0;
+		}
+		//apply linear acceleration
+		force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector3();
+		//apply radial acceleration
+		Vector3 org = p_data.emission_xform.origin;
+		Vector3 diff = position - org;
+		force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector3();
+		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+			Vector2 yx = Vector2(diff.y, diff.x);
+			Vector2 yx2 = (yx * Vector2(-1.0, 1.0)).normalized();
+			force += yx.length() > 0.0 ? Vector3(yx2.x, yx2.y, 0.0) * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector3();
 
-			if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
-				real_t v = p.velocity.length();
-				real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
-				v -= damp * local_delta;
-				if (v < 0.0) {
-					p.velocity = Vector3();
-				} else {
-					p.velocity = p.velocity.normalized() * v;
-				}
+		} else {
+			Vector3 crossDiff = diff.normalized().cross(gravity.normalized());
+			force += crossDiff.length() > 0.0 ? crossDiff.normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector3();
+		}
+		//apply attractor forces
+		p.velocity += force * local_delta;
+		//orbit velocity
+		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+			real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
+			if (orbit_amount != 0.0) {
+				real_t ang = orbit_amount * local_delta * Math_TAU;
+				// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
+				// but we use -ang here to reproduce its behavior.
+				Transform2D rot = Transform2D(-ang, Vector2());
+				Vector2 rotv = rot.basis_xform(Vector2(diff.x, diff.y));
+				p.transform.origin -= Vector3(diff.x, diff.y, 0);
+				p.transform.origin += Vector3(rotv.x, rotv.y, 0);
 			}
-			real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
-			base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
-			p.custom[0] = Math::deg_to_rad(base_angle); //angle
-			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed)); //angle
 		}
-		//apply color
-		//apply hue rotation
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			p.velocity = p.velocity.normalized() * tex_linear_velocity;
+		}
 
-		Vector3 tex_scale = Vector3(1.0, 1.0, 1.0);
-		if (split_scale) {
-			if (scale_curve_x.is_valid()) {
-				tex_scale.x = scale_curve_x->sample(tv);
-			} else {
-				tex_scale.x = 1.0;
-			}
-			if (scale_curve_y.is_valid()) {
-				tex_scale.y = scale_curve_y->sample(tv);
+		if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
+			real_t v = p.velocity.length();
+			real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
+			v -= damp * local_delta;
+			if (v < 0.0) {
+				p.velocity = Vector3();
 			} else {
-				tex_scale.y = 1.0;
-			}
-			if (scale_curve_z.is_valid()) {
-				tex_scale.z = scale_curve_z->sample(tv);
-			} else {
-				tex_scale.z = 1.0;
-			}
-		} else {
-			if (curve_parameters[PARAM_SCALE].is_valid()) {
-				float tmp_scale = curve_parameters[PARAM_SCALE]->sample(tv);
-				tex_scale.x = tmp_scale;
-				tex_scale.y = tmp_scale;
-				tex_scale.z = tmp_scale;
+				p.velocity = p.velocity.normalized() * v;
 			}
 		}
+		real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
+		base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
+		p.custom[0] = Math::deg_to_rad(base_angle); //angle
+		p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed)); //angle
+	}
+	//apply color
+	//apply hue rotation
 
-		real_t tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->sample(tv);
+	Vector3 tex_scale = Vector3(1.0, 1.0, 1.0);
+	if (split_scale) {
+		if (scale_curve_x.is_valid()) {
+			tex_scale.x = scale_curve_x->sample(tv);
+		} else {
+			tex_scale.x = 1.0;
+		}
+		if (scale_curve_y.is_valid()) {
+			tex_scale.y = scale_curve_y->sample(tv);
+		} else {
+			tex_scale.y = 1.0;
+		}
+		if (scale_curve_z.is_valid()) {
+			tex_scale.z = scale_curve_z->sample(tv);
+		} else {
+			tex_scale.z = 1.0;
+		}
+	} else {
+		if (curve_parameters[PARAM_SCALE].is_valid()) {
+			float tmp_scale = curve_parameters[PARAM_SCALE]->sample(tv);
+			tex_scale.x = tmp_scale;
+			tex_scale.y = tmp_scale;
+			tex_scale.z = tmp_scale;
 		}
+	}
 
-		real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
-		real_t hue_rot_c = Math::cos(hue_rot_angle);
-		real_t hue_rot_s = Math::sin(hue_rot_angle);
+	real_t tex_hue_variation = 0.0;
+	if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
+		tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->sample(tv);
+	}
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+	real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
+	real_t hue_rot_c = Math::cos(hue_rot_angle);
+	real_t hue_rot_s = Math::sin(hue_rot_angle);
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
-			}
-		}
+	Basis hue_rot_mat;
+	{
+		Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+		Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+		Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(tv) * color;
-		} else {
-			p.color = color;
+		for (int j = 0; j < 3; j++) {
+			hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
 		}
+	}
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
+	if (color_ramp.is_valid()) {
+		p.color = color_ramp->get_color_at_offset(tv) * color;
+	} else {
+		p.color = color;
+	}
 
-		p.color *= p.base_color * p.start_color_rand;
+	Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
+	p.color.r = color_rgb.x;
+	p.color.g = color_rgb.y;
+	p.color.b = color_rgb.z;
 
-		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-			if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
-				if (p.velocity.length() > 0.0) {
-					p.transform.basis.set_column(1, p.velocity.normalized());
-				} else {
-					p.transform.basis.set_column(1, p.transform.basis.get_column(1));
-				}
-				p.transform.basis.set_column(0, p.transform.basis.get_column(1).cross(p.transform.basis.get_column(2)).normalized());
-				p.transform.basis.set_column(2, Vector3(0, 0, 1));
+	p.color *= p.base_color * p.start_color_rand;
 
+	if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+		if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
+			if (p.velocity.length() > 0.0) {
+				p.transform.basis.set_column(1, p.velocity.normalized());
 			} else {
-				p.transform.basis.set_column(0, Vector3(Math::cos(p.custom[0]), -Math::sin(p.custom[0]), 0.0));
-				p.transform.basis.set_column(1, Vector3(Math::sin(p.custom[0]), Math::cos(p.custom[0]), 0.0));
-				p.transform.basis.set_column(2, Vector3(0, 0, 1));
+				p.transform.basis.set_column(1, p.transform.basis.get_column(1));
 			}
+			p.transform.basis.set_column(0, p.transform.basis.get_column(1).cross(p.transform.basis.get_column(2)).normalized());
+			p.transform.basis.set_column(2, Vector3(0, 0, 1));
 
 		} else {
-			//orient particle Y towards velocity
-			if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
-				if (p.velocity.length() > 0.0) {
-					p.transform.basis.set_column(1, p.velocity.normalized());
-				} else {
-					p.transform.basis.set_column(1, p.transform.basis.get_column(1).normalized());
-				}
-				if (p.transform.basis.get_column(1) == p.transform.basis.get_column(0)) {
-					p.transform.basis.set_column(0, p.transform.basis.get_column(1).cross(p.transform.basis.get_column(2)).normalized());
-					p.transform.basis.set_column(2, p.transform.basis.get_column(0).cross(p.transform.basis.get_column(1)).normalized());
-				} else {
-					p.transform.basis.set_column(2, p.transform.basis.get_column(0).cross(p.transform.basis.get_column(1)).normalized());
-					p.transform.basis.set_column(0, p.transform.basis.get_column(1).cross(p.transform.basis.get_column(2)).normalized());
-				}
+			p.transform.basis.set_column(0, Vector3(Math::cos(p.custom[0]), -Math::sin(p.custom[0]), 0.0));
+			p.transform.basis.set_column(1, Vector3(Math::sin(p.custom[0]), Math::cos(p.custom[0]), 0.0));
+			p.transform.basis.set_column(2, Vector3(0, 0, 1));
+		}
+
+	} else {
+		//orient particle Y towards velocity
+		if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
+			if (p.velocity.length() > 0.0) {
+				p.transform.basis.set_column(1, p.velocity.normalized());
 			} else {
-				p.transform.basis.orthonormalize();
+				p.transform.basis.set_column(1, p.transform.basis.get_column(1).normalized());
 			}
-
-			//turn particle by rotation in Y
-			if (particle_flags[PARTICLE_FLAG_ROTATE_Y]) {
-				Basis rot_y(Vector3(0, 1, 0), p.custom[0]);
-				p.transform.basis = rot_y;
+			if (p.transform.basis.get_column(1) == p.transform.basis.get_column(0)) {
+				p.transform.basis.set_column(0, p.transform.basis.get_column(1).cross(p.transform.basis.get_column(2)).normalized());
+				p.transform.basis.set_column(2, p.transform.basis.get_column(0).cross(p.transform.basis.get_column(1)).normalized());
+			} else {
+				p.transform.basis.set_column(2, p.transform.basis.get_column(0).cross(p.transform.basis.get_column(1)).normalized());
+				p.transform.basis.set_column(0, p.transform.basis.get_column(1).cross(p.transform.basis.get_column(2)).normalized());
 			}
+		} else {
+			p.transform.basis.orthonormalize();
 		}
 
-		p.transform.basis = p.transform.basis.orthonormalized();
-		//scale by scale
-
-		Vector3 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
-		if (base_scale.x < CMP_EPSILON) {
-			base_scale.x = CMP_EPSILON;
-		}
-		if (base_scale.y < CMP_EPSILON) {
-			base_scale.y = CMP_EPSILON;
-		}
-		if (base_scale.z < CMP_EPSILON) {
-			base_scale.z = CMP_EPSILON;
+		//turn particle by rotation in Y
+		if (particle_flags[PARTICLE_FLAG_ROTATE_Y]) {
+			Basis rot_y(Vector3(0, 1, 0), p.custom[0]);
+			p.transform.basis = rot_y;
 		}
+	}
 
-		p.transform.basis.scale(base_scale);
+	p.transform.basis = p.transform.basis.orthonormalized();
+	//scale by scale
 
-		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-			p.velocity.z = 0.0;
-			p.transform.origin.z = 0.0;
-		}
+	Vector3 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
+	if (base_scale.x < CMP_EPSILON) {
+		base_scale.x = CMP_EPSILON;
+	}
+	if (base_scale.y < CMP_EPSILON) {
+		base_scale.y = CMP_EPSILON;
+	}
+	if (base_scale.z < CMP_EPSILON) {
+		base_scale.z = CMP_EPSILON;
+	}
 
-		p.transform.origin += p.velocity * local_delta;
+	p.transform.basis.scale(base_scale);
 
-		should_be_active = true;
+	if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+		p.velocity.z = 0.0;
+		p.transform.origin.z = 0.0;
 	}
-	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
-		active = false;
-		emit_signal(SceneStringName(finished));
+
+	p.transform.origin += p.velocity * local_delta;
+
+	return true;
+}
+
+void CPUParticles3D::_write_particle_data(const Particle &p_particle, float *r_data) const {
+	Transform3D t = p_particle.transform;
+
+	if (!local_coords) {
+		t = inv_emission_transform * t;
+	}
+
+	if (p_particle.active) {
+		r_data[0] = t.basis.rows[0][0];
+		r_data[1] = t.basis.rows[0][1];
+		r_data[2] = t.basis.rows[0][2];
+		r_data[3] = t.origin.x;
+		r_data[4] = t.basis.rows[1][0];
+		r_data[5] = t.basis.rows[1][1];
+		r_data[6] = t.basis.rows[1][2];
+		r_data[7] = t.origin.y;
+		r_data[8] = t.basis.rows[2][0];
+		r_data[9] = t.basis.rows[2][1];
+		r_data[10] = t.basis.rows[2][2];
+		r_data[11] = t.origin.z;
+	} else {
+		memset(r_data, 0, sizeof(float) * 12);
 	}
+
+	Color c = p_particle.color;
+
+	r_data[12] = c.r;
+	r_data[13] = c.g;
+	r_data[14] = c.b;
+	r_data[15] = c.a;
+
+	r_data[16] = p_particle.custom[0];
+	r_data[17] = p_particle.custom[1];
+	r_data[18] = p_particle.custom[2];
+	r_data[19] = p_particle.custom[3];
 }
 
 void CPUParticles3D::_update_particle_data_buffer() {
@@ -1224,42 +1361,7 @@ void CPUParticles3D::_update_particle_data_buffer() {
 
 	for (int i = 0; i < pc; i++) {
 		int idx = order ? order[i] : i;
-
-		Transform3D t = r[idx].transform;
-
-		if (!local_coords) {
-			t = inv_emission_transform * t;
-		}
-
-		if (r[idx].active) {
-			ptr[0] = t.basis.rows[0][0];
-			ptr[1] = t.basis.rows[0][1];
-			ptr[2] = t.basis.rows[0][2];
-			ptr[3] = t.origin.x;
-			ptr[4] = t.basis.rows[1][0];
-			ptr[5] = t.basis.rows[1][1];
-			ptr[6] = t.basis.rows[1][2];
-			ptr[7] = t.origin.y;
-			ptr[8] = t.basis.rows[2][0];
-			ptr[9] = t.basis.rows[2][1];
-			ptr[10] = t.basis.rows[2][2];
-			ptr[11] = t.origin.z;
-		} else {
-			memset(ptr, 0, sizeof(float) * 12);
-		}
-
-		Color c = r[idx].color;
-
-		ptr[12] = c.r;
-		ptr[13] = c.g;
-		ptr[14] = c.b;
-		ptr[15] = c.a;
-
-		ptr[16] = r[idx].custom[0];
-		ptr[17] = r[idx].custom[1];
-		ptr[18] = r[idx].custom[2];
-		ptr[19] = r[idx].custom[3];
-
+		_write_particle_data(r[idx], ptr);
 		ptr += 20;
 	}
 
@@ -1473,6 +1575,10 @@ void CPUParticles3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_use_local_coordinates"), &CPUParticles3D::get_use_local_coordinates);
 	ClassDB::bind_method(D_METHOD("get_fixed_fps"), &CPUParticles3D::get_fixed_fps);
 	ClassDB::bind_method(D_METHOD("get_fractional_delta"), &CPUParticles3D::get_fractional_delta);
+	ClassDB::bind_method(D_METHOD("set_use_fixed_seed", "use_fixed_seed"), &CPUParticles3D::set_use_fixed_seed);
+	ClassDB::bind_method(D_METHOD("get_use_fixed_seed"), &CPUParticles3D::get_use_fixed_seed);
+	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &CPUParticles3D::set_seed);
+	ClassDB::bind_method(D_METHOD("get_seed"), &CPUParticles3D::get_seed);
 	ClassDB::bind_method(D_METHOD("get_speed_scale"), &CPUParticles3D::get_speed_scale);
 
 	ClassDB::bind_method(D_METHOD("set_draw_order", "order"), &CPUParticles3D::set_draw_order);
@@ -1497,6 +1603,8 @@ void CPUParticles3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lifetime_randomness", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_lifetime_randomness", "get_lifetime_randomness");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "fixed_fps", PROPERTY_HINT_RANGE, "0,1000,1,suffix:FPS"), "set_fixed_fps", "get_fixed_fps");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "fract_delta"), "set_fractional_delta", "get_fractional_delta");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_fixed_seed", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), "set_use_fixed_seed", "get_use_fixed_seed");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed", PROPERTY_HINT_RANGE, "0,4294967295,1"), "set_seed", "get_seed");
 	ADD_GROUP("Drawing", "");
 	ADD_PROPERTY(PropertyInfo(Variant::AABB, "visibility_aabb", PROPERTY_HINT_NONE, "suffix:m"), "set_visibility_aabb", "get_visibility_aabb");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "local_coords"), "set_use_local_coordinates", "get_use_local_coordinates");
@@ -187,8 +187,30 @@ private:
 
 	Vector3 gravity = Vector3(0, -9.8, 0);
 
+	bool use_fixed_seed = false;
+	uint32_t seed = 0;
+	uint32_t process_seed = 0; // The seed of the current emission, random unless use_fixed_seed is set.
+
+	// Shared by the particles processed in a step, which may be split into chunks run on the WorkerThreadPool.
+	static constexpr int PROCESS_CHUNK_SIZE = 512;
+	struct ParticlesProcessData {
+		Particle *particles = nullptr;
+		int particle_count = 0;
+		double delta = 0.0;
+		double prev_time = 0.0;
+		double system_phase = 0.0;
+		Transform3D emission_xform;
+		Basis velocity_xform;
+		float *buffer = nullptr; // If set, the instance data is written along with each particle, in index order.
+		LocalVector<bool> chunk_active;
+	};
+
 	void _update_internal();
-	void _particles_process(double p_delta);
+	void _particles_process(double p_delta, bool p_update_buffer = false);
+	void _particles_process_chunk(uint32_t p_chunk, ParticlesProcessData *p_data);
+	bool _particles_process_range(int p_from, int p_to, const ParticlesProcessData &p_data);
+	bool _particle_process(Particle &r_particle, int p_index, const ParticlesProcessData &p_data);
+	void _write_particle_data(const Particle &p_particle, float *r_data) const;
 	void _update_particle_data_buffer();
 
 	Mutex update_mutex;
@@ -235,6 +257,12 @@ public:
 	void set_fractional_delta(bool p_enable);
 	bool get_fractional_delta() const;
 
+	void set_use_fixed_seed(bool p_use_fixed_seed);
+	bool get_use_fixed_seed() const;
+
+	void set_seed(uint32_t p_seed);
+	uint32_t get_seed() const;
+
 	void set_draw_order(DrawOrder p_order);
 	DrawOrder get_draw_order() const;
 
@@ -330,6 +330,15 @@ void Skeleton3D::_notification(int p_what) {
 			_notification(NOTIFICATION_UPDATE_SKELETON);
 		} break;
 		case NOTIFICATION_UPDATE_SKELETON: {
+			// When the animation of a far away character skips a frame, the modifiers don't need to run again on the same poses.
+			bool skip = modifier_update_skipped && !dirty && !modifiers_dirty && !(update_flags & UPDATE_FLAG_POSE);
+			modifier_update_skipped = false;
+			if (skip) {
+				_store_global_pose_statistics();
+				update_flags = UPDATE_FLAG_NONE;
+				return;
+			}
+
 			// Update bone transforms to apply unprocessed poses.
 			force_update_all_dirty_bones();
 
@@ -355,6 +364,7 @@ void Skeleton3D::_notification(int p_what) {
 
 			// Abort if pose is not changed.
 			if (!(update_flags & UPDATE_FLAG_POSE)) {
+				_store_global_pose_statistics();
 				updating = false;
 				update_flags = UPDATE_FLAG_NONE;
 				return;
@@ -426,8 +436,11 @@ void Skeleton3D::_notification(int p_what) {
 				}
 				// Restore dirty flags for global bone poses.
 				bone_global_pose_dirty = bone_global_pose_dirty_backup;
+				global_pose_dirty_begin = 0;
+				global_pose_dirty_end = bone_global_pose_dirty.size();
 			}
 
+			_store_global_pose_statistics();
 			updating = false;
 			update_flags = UPDATE_FLAG_NONE;
 		} break;
@@ -501,6 +514,8 @@ void Skeleton3D::_make_bone_global_poses_dirty() {
 	for (uint32_t i = 0; i < bone_global_pose_dirty.size(); i++) {
 		bone_global_pose_dirty[i] = true;
 	}
+	global_pose_dirty_begin = 0;
+	global_pose_dirty_end = bone_global_pose_dirty.size();
 }
 
 void Skeleton3D::_make_bone_global_pose_subtree_dirty(int p_bone) {
@@ -520,6 +535,8 @@ void Skeleton3D::_make_bone_global_pose_subtree_dirty(int p_bone) {
 	for (int i = span_offset; i < span_end; i++) {
 		bone_global_pose_dirty[i] = true;
 	}
+	global_pose_dirty_begin = MIN(global_pose_dirty_begin, span_offset);
+	global_pose_dirty_end = MAX(global_pose_dirty_end, span_end);
 }
 
 void Skeleton3D::_update_bone_global_pose(int p_bone) {
@@ -567,6 +584,93 @@ void Skeleton3D::_update_bone_global_pose(int p_bone) {
 		bone.global_pose = global_pose;
 		bone_global_pose_dirty[bone.nested_set_offset] = false;
 	}
+
+	global_pose_update_count++;
+	global_pose_bone_update_count += bone_list.size();
+}
+
+// Calculate the dirty global poses between two nested set offsets in a single pass. Parents always come before
+// their children in the nested set, so their global pose is up to date when a child needs it.
+void Skeleton3D::_update_bone_global_poses(int p_begin, int p_end) {
+	Bone *bonesptr = bones.ptr();
+	const int *offset_to_bone_index = nested_set_offset_to_bone_index.ptr();
+	bool *dirty_ptr = bone_global_pose_dirty.ptr();
+	uint32_t updated = 0;
+
+	for (int offset = p_begin; offset < p_end; offset++) {
+		if (!dirty_ptr[offset]) {
+			continue;
+		}
+
+		Bone &b = bonesptr[offset_to_bone_index[offset]];
+		bool bone_enabled = b.enabled && !show_rest_only;
+
+		if (bone_enabled) {
+			b.update_pose_cache();
+			Transform3D pose = b.pose_cache;
+
+			if (b.parent >= 0) {
+				b.global_pose = bonesptr[b.parent].global_pose * pose;
+			} else {
+				b.global_pose = pose;
+			}
+		} else {
+			if (b.parent >= 0) {
+				b.global_pose = bonesptr[b.parent].global_pose * b.rest;
+			} else {
+				b.global_pose = b.rest;
+			}
+		}
+		if (rest_dirty) {
+			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
+		}
+
+#ifndef DISABLE_DEPRECATED
+		if (bone_enabled) {
+			Transform3D pose = b.pose_cache;
+			if (b.parent >= 0) {
+				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
+			} else {
+				b.pose_global_no_override = pose;
+			}
+		} else {
+			if (b.parent >= 0) {
+				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
+			} else {
+				b.pose_global_no_override = b.rest;
+			}
+		}
+		if (b.global_pose_override_amount >= CMP_EPSILON) {
+			b.global_pose = b.global_pose.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+		}
+		if (b.global_pose_override_reset) {
+			b.global_pose_override_amount = 0.0;
+		}
+#endif // _DISABLE_DEPRECATED
+
+		dirty_ptr[offset] = false;
+		updated++;
+	}
+
+	if (updated > 0) {
+		global_pose_update_count++;
+		global_pose_bone_update_count += updated;
+	}
+}
+
+void Skeleton3D::_store_global_pose_statistics() {
+	last_global_pose_update_count = global_pose_update_count;
+	last_global_pose_bone_update_count = global_pose_bone_update_count;
+	global_pose_update_count = 0;
+	global_pose_bone_update_count = 0;
+}
+
+int Skeleton3D::get_global_pose_update_count() const {
+	return last_global_pose_update_count;
+}
+
+int Skeleton3D::get_global_pose_bone_update_count() const {
+	return last_global_pose_bone_update_count;
 }
 
 Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
@@ -886,6 +990,27 @@ void Skeleton3D::set_bone_pose_scale(int p_bone, const Vector3 &p_scale) {
 	}
 }
 
+void Skeleton3D::set_bone_pose_components(int p_bone, const Vector3 *p_position, const Quaternion *p_rotation, const Vector3 *p_scale) {
+	const int bone_size = bones.size();
+	ERR_FAIL_INDEX(p_bone, bone_size);
+
+	Bone &bone = bones[p_bone];
+	if (p_position) {
+		bone.pose_position = *p_position;
+	}
+	if (p_rotation) {
+		bone.pose_rotation = *p_rotation;
+	}
+	if (p_scale) {
+		bone.pose_scale = *p_scale;
+	}
+	bone.pose_cache_dirty = true;
+	if (is_inside_tree()) {
+		_make_dirty();
+		_make_bone_global_pose_subtree_dirty(p_bone);
+	}
+}
+
 Vector3 Skeleton3D::get_bone_pose_position(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Vector3());
@@ -1036,6 +1161,10 @@ void Skeleton3D::force_update_deferred() {
 	_make_dirty();
 }
 
+void Skeleton3D::skip_next_modifier_update() {
+	modifier_update_skipped = true;
+}
+
 void Skeleton3D::force_update_all_dirty_bones() {
 	if (!dirty) {
 		return;
@@ -1045,9 +1174,9 @@ void Skeleton3D::force_update_all_dirty_bones() {
 
 void Skeleton3D::force_update_all_bone_transforms() {
 	_update_process_order();
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		force_update_bone_children_transforms(parentless_bones[i]);
-	}
+	_update_bone_global_poses(global_pose_dirty_begin, global_pose_dirty_end);
+	global_pose_dirty_begin = bones.size();
+	global_pose_dirty_end = 0;
 	rest_dirty = false;
 	dirty = false;
 	if (updating) {
@@ -1060,63 +1189,18 @@ void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone_idx, bone_size);
 
-	Bone *bonesptr = bones.ptr();
-
-	// Loop through nested set.
-	for (int offset = 0; offset < bone_size; offset++) {
-		if (!bone_global_pose_dirty[offset]) {
-			continue;
-		}
-
-		int current_bone_idx = nested_set_offset_to_bone_index[offset];
-		Bone &b = bonesptr[current_bone_idx];
-		bool bone_enabled = b.enabled && !show_rest_only;
-
-		if (bone_enabled) {
-			b.update_pose_cache();
-			Transform3D pose = b.pose_cache;
-
-			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * pose;
-			} else {
-				b.global_pose = pose;
-			}
-		} else {
-			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * b.rest;
-			} else {
-				b.global_pose = b.rest;
-			}
-		}
-		if (rest_dirty) {
-			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
-		}
-
-#ifndef DISABLE_DEPRECATED
-		if (bone_enabled) {
-			Transform3D pose = b.pose_cache;
-			if (b.parent >= 0) {
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
-			} else {
-				b.pose_global_no_override = pose;
-			}
-		} else {
-			if (b.parent >= 0) {
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
-			} else {
-				b.pose_global_no_override = b.rest;
-			}
-		}
-		if (b.global_pose_override_amount >= CMP_EPSILON) {
-			b.global_pose = b.global_pose.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
-		}
-		if (b.global_pose_override_reset) {
-			b.global_pose_override_amount = 0.0;
-		}
-#endif // _DISABLE_DEPRECATED
+	_update_process_order();
+	if (rest_dirty) {
+		// The global rests of the whole hierarchy may be needed.
+		_update_bone_global_poses(global_pose_dirty_begin, global_pose_dirty_end);
+		return;
+	}
 
-		bone_global_pose_dirty[offset] = false;
+	const Bone &bone = bones[p_bone_idx];
+	if (bone.parent >= 0) {
+		_update_bone_global_pose(bone.parent);
 	}
+	_update_bone_global_poses(bone.nested_set_offset, bone.nested_set_offset + bone.nested_set_span);
 }
 
 void Skeleton3D::_find_modifiers() {
@@ -1163,8 +1247,9 @@ void Skeleton3D::_process_modifiers() {
 		} else {
 			mod->process_modification();
 		}
-		force_update_all_dirty_bones();
 	}
+	// Global poses read by the modifiers were calculated on demand, only the remaining ones are needed for the skins.
+	force_update_all_dirty_bones();
 }
 
 void Skeleton3D::add_child_notify(Node *p_child) {
@@ -1243,6 +1328,9 @@ void Skeleton3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("force_update_all_bone_transforms"), &Skeleton3D::force_update_all_bone_transforms);
 	ClassDB::bind_method(D_METHOD("force_update_bone_child_transform", "bone_idx"), &Skeleton3D::force_update_bone_children_transforms);
 
+	ClassDB::bind_method(D_METHOD("get_global_pose_update_count"), &Skeleton3D::get_global_pose_update_count);
+	ClassDB::bind_method(D_METHOD("get_global_pose_bone_update_count"), &Skeleton3D::get_global_pose_bone_update_count);
+
 	ClassDB::bind_method(D_METHOD("set_motion_scale", "motion_scale"), &Skeleton3D::set_motion_scale);
 	ClassDB::bind_method(D_METHOD("get_motion_scale"), &Skeleton3D::get_motion_scale);
 
@@ -91,6 +91,7 @@ private:
 	void _update_deferred(UpdateFlag p_update_flag = UPDATE_FLAG_POSE);
 	uint8_t update_flags = UPDATE_FLAG_NONE;
 	bool updating = false; // Is updating now?
+	bool modifier_update_skipped = false;
 
 	struct Bone {
 		String name;
@@ -189,11 +190,22 @@ private:
 	// Global bone pose calculation.
 	LocalVector<int> nested_set_offset_to_bone_index; // Map from Bone::nested_set_offset to bone index.
 	LocalVector<bool> bone_global_pose_dirty; // Indexable with Bone::nested_set_offset.
+	// Nested set offsets outside of this range are never dirty, so updates only scan the part of the hierarchy that changed.
+	int global_pose_dirty_begin = 0;
+	int global_pose_dirty_end = 0;
 	void _update_bones_nested_set();
 	int _update_bone_nested_set(int p_bone, int p_offset);
 	void _make_bone_global_poses_dirty();
 	void _make_bone_global_pose_subtree_dirty(int p_bone);
 	void _update_bone_global_pose(int p_bone);
+	void _update_bone_global_poses(int p_begin, int p_end);
+
+	// Statistics of the global pose calculations since the previous skeleton update, to measure the cost of modifiers.
+	uint32_t global_pose_update_count = 0;
+	uint32_t global_pose_bone_update_count = 0;
+	uint32_t last_global_pose_update_count = 0;
+	uint32_t last_global_pose_bone_update_count = 0;
+	void _store_global_pose_statistics();
 
 #ifndef DISABLE_DEPRECATED
 	void _add_bone_bind_compat_88791(const String &p_name);
@@ -268,6 +280,7 @@ public:
 	void set_bone_pose_position(int p_bone, const Vector3 &p_position);
 	void set_bone_pose_rotation(int p_bone, const Quaternion &p_rotation);
 	void set_bone_pose_scale(int p_bone, const Vector3 &p_scale);
+	void set_bone_pose_components(int p_bone, const Vector3 *p_position, const Quaternion *p_rotation, const Vector3 *p_scale); // Components passed as null are left unchanged.
 
 	Transform3D get_bone_global_pose(int p_bone) const;
 	void set_bone_global_pose(int p_bone, const Transform3D &p_pose);
@@ -285,6 +298,10 @@ public:
 	void force_update_all_bone_transforms();
 	void force_update_bone_children_transforms(int bone_idx);
 	void force_update_deferred();
+	int get_global_pose_update_count() const;
+	int get_global_pose_bone_update_count() const;
+
+	void skip_next_modifier_update(); // The next update keeps the previous result if no bone pose changed, for the animation LOD.
 
 	void set_modifier_callback_mode_process(ModifierCallbackModeProcess p_mode);
 	ModifierCallbackModeProcess get_modifier_callback_mode_process() const;
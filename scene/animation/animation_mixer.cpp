@@ -33,21 +33,26 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
 #include "scene/animation/animation_player.h"
 #include "scene/audio/audio_stream_player.h"
+#include "scene/main/scene_tree.h"
 #include "scene/resources/animation.h"
 #include "servers/audio/audio_stream.h"
 #include "servers/audio_server.h"
 
 #ifndef _3D_DISABLED
 #include "scene/3d/audio_stream_player_3d.h"
+#include "scene/3d/camera_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
 #include "scene/3d/skeleton_modifier_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#include "scene/main/viewport.h"
 #endif // _3D_DISABLED
 
 #ifdef TOOLS_ENABLED
@@ -528,6 +533,58 @@ AnimationMixer::AnimationCallbackModeDiscrete AnimationMixer::get_callback_mode_
 	return callback_mode_discrete;
 }
 
+void AnimationMixer::set_parallel_processing_enabled(bool p_enabled) {
+	if (parallel_processing == p_enabled) {
+		return;
+	}
+	parallel_processing = p_enabled;
+	if (!is_inside_tree()) {
+		return;
+	}
+	if (parallel_processing) {
+		_parallel_register();
+	} else {
+		_parallel_unregister();
+	}
+}
+
+bool AnimationMixer::is_parallel_processing_enabled() const {
+	return parallel_processing;
+}
+
+void AnimationMixer::set_lod_distances(const PackedFloat32Array &p_distances) {
+	lod_distances = p_distances;
+}
+
+PackedFloat32Array AnimationMixer::get_lod_distances() const {
+	return lod_distances;
+}
+
+void AnimationMixer::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod_visibility_notifier = p_path;
+}
+
+NodePath AnimationMixer::get_lod_visibility_notifier() const {
+	return lod_visibility_notifier;
+}
+
+void AnimationMixer::set_lod_offscreen_update_interval(int p_interval) {
+	ERR_FAIL_COND(p_interval < 0);
+	lod_offscreen_update_interval = p_interval;
+}
+
+int AnimationMixer::get_lod_offscreen_update_interval() const {
+	return lod_offscreen_update_interval;
+}
+
+void AnimationMixer::set_lod_skip_blend_shapes_enabled(bool p_enabled) {
+	lod_skip_blend_shapes = p_enabled;
+}
+
+bool AnimationMixer::is_lod_skip_blend_shapes_enabled() const {
+	return lod_skip_blend_shapes;
+}
+
 void AnimationMixer::set_audio_max_polyphony(int p_audio_max_polyphony) {
 	ERR_FAIL_COND(p_audio_max_polyphony < 0 || p_audio_max_polyphony > 128);
 	audio_max_polyphony = p_audio_max_polyphony;
@@ -579,6 +636,8 @@ void AnimationMixer::_clear_caches() {
 	}
 	track_cache.clear();
 	animation_track_num_to_track_cashe.clear();
+	animation_skeleton_blend_cache.clear();
+	animated_skeletons.clear();
 	cache_valid = false;
 	capture_cache.clear();
 
@@ -631,6 +690,54 @@ void AnimationMixer::_create_track_num_to_track_cashe_for_animation(Ref<Animatio
 	}
 }
 
+void AnimationMixer::_create_skeleton_blend_cache_for_animation(const Ref<Animation> &p_animation) {
+#ifndef _3D_DISABLED
+	const LocalVector<TrackCache *> &track_num_to_track_cashe = animation_track_num_to_track_cashe[p_animation];
+	const Vector<Animation::Track *> &tracks = p_animation->get_tracks();
+
+	ObjectID skeleton_id;
+	LocalVector<int> tracks_by_type[3];
+	for (int i = 0; i < tracks.size(); i++) {
+		Animation::TrackType type = tracks[i]->type;
+		if (type != Animation::TYPE_POSITION_3D && type != Animation::TYPE_ROTATION_3D && type != Animation::TYPE_SCALE_3D) {
+			return;
+		}
+		if (!track_num_to_track_cashe[i]) {
+			continue; // Not resolved, _blend_process() skips it too.
+		}
+		TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track_num_to_track_cashe[i]);
+		if (!t->skeleton_id.is_valid() || t->bone_idx < 0 || (skeleton_id.is_valid() && t->skeleton_id != skeleton_id)) {
+			return;
+		}
+		skeleton_id = t->skeleton_id;
+		tracks_by_type[type - Animation::TYPE_POSITION_3D].push_back(i);
+	}
+	if (!skeleton_id.is_valid()) {
+		return;
+	}
+
+	SkeletonBlendCache &sbc = animation_skeleton_blend_cache.insert_new(p_animation, SkeletonBlendCache())->value;
+	sbc.skeleton_id = skeleton_id;
+	sbc.animation_track_count = tracks.size();
+	sbc.root_motion_track = root_motion_track;
+	for (const LocalVector<int> &type_tracks : tracks_by_type) {
+		for (int track : type_tracks) {
+			TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track_num_to_track_cashe[track]);
+			sbc.tracks.push_back(track);
+			sbc.caches.push_back(t);
+			sbc.has_root_motion = sbc.has_root_motion || t->path == root_motion_track;
+		}
+	}
+	sbc.rotation_offset = tracks_by_type[0].size();
+	sbc.scale_offset = sbc.rotation_offset + tracks_by_type[1].size();
+	sbc.cursors.resize(sbc.tracks.size());
+	sbc.blends.resize(sbc.tracks.size());
+	sbc.positions.resize(tracks_by_type[0].size());
+	sbc.rotations.resize(tracks_by_type[1].size());
+	sbc.scales.resize(tracks_by_type[2].size());
+#endif // _3D_DISABLED
+}
+
 bool AnimationMixer::_update_caches() {
 	setup_pass++;
 
@@ -968,13 +1075,43 @@ bool AnimationMixer::_update_caches() {
 	}
 
 	animation_track_num_to_track_cashe.clear();
+	animation_skeleton_blend_cache.clear();
 	for (const StringName &E : sname_list) {
 		Ref<Animation> anim = get_animation(E);
 		_create_track_num_to_track_cashe_for_animation(anim);
+		_create_skeleton_blend_cache_for_animation(anim);
 	}
 
 	track_count = idx;
 
+	// Only tracks which are blended into the caches and applied later can be evaluated outside of the main thread.
+	// Method, audio and animation tracks call into other objects, as do discrete value tracks unless forced to be continuous.
+	// Bezier tracks share the value track cache, so the same applies to them.
+	parallel_safe = true;
+	animated_skeletons.clear();
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		switch (K.value->type) {
+			case Animation::TYPE_POSITION_3D: {
+#ifndef _3D_DISABLED
+				const TrackCacheTransform *t = static_cast<const TrackCacheTransform *>(K.value);
+				if (t->skeleton_id.is_valid() && animated_skeletons.find(t->skeleton_id) < 0) {
+					animated_skeletons.push_back(t->skeleton_id);
+				}
+#endif // _3D_DISABLED
+			} break;
+			case Animation::TYPE_BLEND_SHAPE: {
+			} break;
+			case Animation::TYPE_VALUE: {
+				if (callback_mode_discrete != ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS) {
+					parallel_safe = false;
+				}
+			} break;
+			default: {
+				parallel_safe = false;
+			} break;
+		}
+	}
+
 	cache_valid = true;
 
 	return true;
@@ -987,9 +1124,7 @@ bool AnimationMixer::_update_caches() {
 void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 	_blend_init();
 	if (_blend_pre_process(p_delta, track_count, track_map)) {
-		_blend_capture(p_delta);
-		_blend_calc_total_weight();
-		_blend_process(p_delta, p_update_only);
+		_blend_evaluate(p_delta, p_update_only);
 		_blend_apply();
 		_blend_post_process();
 		emit_signal(SNAME("mixer_applied"));
@@ -1027,6 +1162,13 @@ Variant AnimationMixer::post_process_key_value(const Ref<Animation> &p_anim, int
 	return _post_process_key_value(p_anim, p_track, p_value, p_object_id, p_object_sub_idx);
 }
 
+bool AnimationMixer::_has_post_process_key_value_override() {
+	if (is_GDVIRTUAL_CALL_post_process_key_value && !GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value)) {
+		is_GDVIRTUAL_CALL_post_process_key_value = false;
+	}
+	return is_GDVIRTUAL_CALL_post_process_key_value;
+}
+
 void AnimationMixer::_blend_init() {
 	// Check all tracks, see if they need modification.
 	root_motion_position = Vector3(0, 0, 0);
@@ -1096,6 +1238,12 @@ void AnimationMixer::_blend_capture(double p_delta) {
 	blend_capture(p_delta);
 }
 
+void AnimationMixer::_blend_evaluate(double p_delta, bool p_update_only) {
+	_blend_capture(p_delta);
+	_blend_calc_total_weight();
+	_blend_process(p_delta, p_update_only);
+}
+
 void AnimationMixer::blend_capture(double p_delta) {
 	if (capture_cache.animation.is_null()) {
 		return;
@@ -1189,6 +1337,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 		bool calc_root = !seeked || is_external_seeking;
 #endif // _3D_DISABLED
 		ERR_CONTINUE_EDMSG(!animation_track_num_to_track_cashe.has(a), "No animation in cache.");
+		if (_blend_process_skeleton(ai)) {
+			continue;
+		}
 		LocalVector<TrackCache *> &track_num_to_track_cashe = animation_track_num_to_track_cashe[a];
 		const Vector<Animation::Track *> tracks = a->get_tracks();
 		Animation::Track *const *tracks_ptr = tracks.ptr();
@@ -1541,6 +1692,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					if (Math::is_zero_approx(blend)) {
 						continue; // Nothing to blend.
 					}
+					if (lod_reduced && lod_skip_blend_shapes) {
+						continue; // Not worth it at a distance, see _lod_update().
+					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
 					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
@@ -1851,7 +2005,114 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 	is_GDVIRTUAL_CALL_post_process_key_value = true;
 }
 
+// Gives the same result as _blend_process() for animations with a SkeletonBlendCache, without going through
+// Variant and _post_process_key_value() for every key.
+bool AnimationMixer::_blend_process_skeleton(const AnimationInstance &p_instance) {
+#ifndef _3D_DISABLED
+	const Ref<Animation> &a = p_instance.animation_data.animation;
+	SkeletonBlendCache *sbc = animation_skeleton_blend_cache.getptr(a);
+	if (!sbc) {
+		return false;
+	}
+	if (sbc->root_motion_track != root_motion_track) {
+		sbc->root_motion_track = root_motion_track;
+		sbc->has_root_motion = false;
+		for (const TrackCacheTransform *t : sbc->caches) {
+			sbc->has_root_motion = sbc->has_root_motion || t->path == root_motion_track;
+		}
+	}
+	if (sbc->has_root_motion || _has_post_process_key_value_override()) {
+		return false;
+	}
+	const Vector<Animation::Track *> tracks = a->get_tracks();
+	Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(sbc->skeleton_id));
+	if (!skeleton || tracks.size() != sbc->animation_track_count) {
+		return false;
+	}
+	const real_t motion_scale = skeleton->get_motion_scale();
+
+	const double time = p_instance.playback_info.time;
+	const real_t weight = p_instance.playback_info.weight;
+	const real_t *track_weights_ptr = p_instance.playback_info.track_weights.ptr();
+	const int track_weights_count = p_instance.playback_info.track_weights.size();
+	Animation::Track *const *tracks_ptr = tracks.ptr();
+	const int *track_indices = sbc->tracks.ptr();
+	TrackCacheTransform *const *caches = sbc->caches.ptr();
+	real_t *blends = sbc->blends.ptr();
+	const uint32_t count = sbc->tracks.size();
+
+	for (uint32_t i = 0; i < count; i++) {
+		blends[i] = 0.0;
+		if (!tracks_ptr[track_indices[i]]->enabled) {
+			continue;
+		}
+		TrackCacheTransform *t = caches[i];
+		int blend_idx = t->blend_idx;
+		ERR_CONTINUE(blend_idx < 0 || blend_idx >= track_count);
+		real_t blend = blend_idx < track_weights_count ? track_weights_ptr[blend_idx] * weight : weight;
+		if (!deterministic) {
+			if (Math::is_zero_approx(t->total_weight)) {
+				continue;
+			}
+			blend = blend / t->total_weight;
+		}
+		t->root_motion = false;
+		blends[i] = blend;
+	}
+
+	// Sample.
+	Animation::KeyCursor *cursors = sbc->cursors.ptr();
+	for (uint32_t i = 0; i < sbc->rotation_offset; i++) {
+		if (!Math::is_zero_approx(blends[i]) && a->try_position_track_interpolate(track_indices[i], time, &sbc->positions[i], false, &cursors[i]) != OK) {
+			blends[i] = 0.0;
+		}
+	}
+	for (uint32_t i = sbc->rotation_offset; i < sbc->scale_offset; i++) {
+		if (!Math::is_zero_approx(blends[i]) && a->try_rotation_track_interpolate(track_indices[i], time, &sbc->rotations[i - sbc->rotation_offset], false, &cursors[i]) != OK) {
+			blends[i] = 0.0;
+		}
+	}
+	for (uint32_t i = sbc->scale_offset; i < count; i++) {
+		if (!Math::is_zero_approx(blends[i]) && a->try_scale_track_interpolate(track_indices[i], time, &sbc->scales[i - sbc->scale_offset], false, &cursors[i]) != OK) {
+			blends[i] = 0.0;
+		}
+	}
+
+	// Blend.
+	const Vector3 *positions = sbc->positions.ptr();
+	for (uint32_t i = 0; i < sbc->rotation_offset; i++) {
+		if (!Math::is_zero_approx(blends[i])) {
+			TrackCacheTransform *t = caches[i];
+			t->loc += (positions[i] * motion_scale - t->init_loc) * blends[i];
+		}
+	}
+	const Quaternion *rotations = sbc->rotations.ptr();
+	for (uint32_t i = sbc->rotation_offset; i < sbc->scale_offset; i++) {
+		if (!Math::is_zero_approx(blends[i])) {
+			TrackCacheTransform *t = caches[i];
+			t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rotations[i - sbc->rotation_offset], blends[i])).normalized();
+		}
+	}
+	const Vector3 *scales = sbc->scales.ptr();
+	for (uint32_t i = sbc->scale_offset; i < count; i++) {
+		if (!Math::is_zero_approx(blends[i])) {
+			TrackCacheTransform *t = caches[i];
+			t->scale += (scales[i - sbc->scale_offset] - t->init_scale) * blends[i];
+		}
+	}
+	return true;
+#else
+	return false;
+#endif // _3D_DISABLED
+}
+
 void AnimationMixer::_blend_apply() {
+#ifndef _3D_DISABLED
+	// The bones of a skeleton are usually cached one after the other, so only look it up again when it changes.
+	ObjectID skeleton_id;
+	Skeleton3D *skeleton = nullptr;
+#endif // _3D_DISABLED
+
 	// Finally, set the tracks.
 	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
 		TrackCache *track = K.value;
@@ -1872,20 +2133,16 @@ void AnimationMixer::_blend_apply() {
 					root_motion_rotation_accumulator = t->rot;
 					root_motion_scale_accumulator = t->scale;
 				} else if (t->skeleton_id.is_valid() && t->bone_idx >= 0) {
-					Skeleton3D *t_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(t->skeleton_id));
-					if (!t_skeleton) {
-						return;
-					}
-					if (t->loc_used) {
-						t_skeleton->set_bone_pose_position(t->bone_idx, t->loc);
+					if (t->skeleton_id != skeleton_id) {
+						skeleton_id = t->skeleton_id;
+						skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(skeleton_id));
 					}
-					if (t->rot_used) {
-						t_skeleton->set_bone_pose_rotation(t->bone_idx, t->rot);
+					if (!skeleton) {
+						return;
 					}
-					if (t->scale_used) {
-						t_skeleton->set_bone_pose_scale(t->bone_idx, t->scale);
+					if (t->loc_used || t->rot_used || t->scale_used) {
+						skeleton->set_bone_pose_components(t->bone_idx, t->loc_used ? &t->loc : nullptr, t->rot_used ? &t->rot : nullptr, t->scale_used ? &t->scale : nullptr);
 					}
-
 				} else if (!t->skeleton_id.is_valid()) {
 					Node3D *t_node_3d = Object::cast_to<Node3D>(ObjectDB::get_instance(t->object_id));
 					if (!t_node_3d) {
@@ -1905,6 +2162,9 @@ void AnimationMixer::_blend_apply() {
 			} break;
 			case Animation::TYPE_BLEND_SHAPE: {
 #ifndef _3D_DISABLED
+				if (lod_reduced && lod_skip_blend_shapes) {
+					continue;
+				}
 				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 
 				MeshInstance3D *t_mesh_3d = Object::cast_to<MeshInstance3D>(ObjectDB::get_instance(t->object_id));
@@ -2064,6 +2324,211 @@ void AnimationMixer::clear_caches() {
 	_clear_caches();
 }
 
+/* -------------------------------------------- */
+/* -- Parallel processing --------------------- */
+/* -------------------------------------------- */
+
+LocalVector<AnimationMixer *> AnimationMixer::parallel_mixers;
+ObjectID AnimationMixer::parallel_tree_id;
+uint64_t AnimationMixer::parallel_pass_count = 0;
+uint64_t AnimationMixer::parallel_idle_pass = 0;
+uint64_t AnimationMixer::parallel_physics_pass = 0;
+
+void AnimationMixer::_parallel_register() {
+	if (parallel_mixers.find(this) >= 0) {
+		return;
+	}
+	if (parallel_mixers.is_empty()) {
+		SceneTree *tree = get_tree();
+		tree->connect(SNAME("process_frame"), callable_mp_static(&AnimationMixer::_process_parallel_mixers_idle));
+		tree->connect(SNAME("physics_frame"), callable_mp_static(&AnimationMixer::_process_parallel_mixers_physics));
+		parallel_tree_id = tree->get_instance_id();
+	}
+	parallel_mixers.push_back(this);
+}
+
+void AnimationMixer::_parallel_unregister() {
+	if (!parallel_mixers.erase(this) || !parallel_mixers.is_empty()) {
+		return;
+	}
+	SceneTree *tree = Object::cast_to<SceneTree>(ObjectDB::get_instance(parallel_tree_id));
+	if (tree) {
+		tree->disconnect(SNAME("process_frame"), callable_mp_static(&AnimationMixer::_process_parallel_mixers_idle));
+		tree->disconnect(SNAME("physics_frame"), callable_mp_static(&AnimationMixer::_process_parallel_mixers_physics));
+	}
+	parallel_tree_id = ObjectID();
+}
+
+bool AnimationMixer::_is_parallel_processed(bool p_physics) const {
+	return parallel_processing && parallel_process_pass == (p_physics ? parallel_physics_pass : parallel_idle_pass);
+}
+
+void AnimationMixer::_parallel_evaluate_task(void *p_userdata, uint32_t p_index) {
+	AnimationMixer *mixer = static_cast<AnimationMixer **>(p_userdata)[p_index];
+	mixer->_blend_evaluate(mixer->parallel_delta);
+}
+
+// Runs on the process_frame/physics_frame signals, before any node is processed, and does the work of
+// _process_animation() for all the mixers at once: Pre-processing, applying and signals stay on the main thread
+// in mixer order, while the track caches of the mixers that are parallel safe are evaluated on the WorkerThreadPool.
+void AnimationMixer::_process_parallel_mixers(bool p_physics) {
+	const uint64_t pass = ++parallel_pass_count;
+	if (p_physics) {
+		parallel_physics_pass = pass;
+	} else {
+		parallel_idle_pass = pass;
+	}
+	const AnimationCallbackModeProcess mode = p_physics ? ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS : ANIMATION_CALLBACK_MODE_PROCESS_IDLE;
+
+	// Pre-processing and applying can emit signals, so the mixers are looked up again after each of them.
+	LocalVector<ObjectID> batch;
+	for (const AnimationMixer *mixer : parallel_mixers) {
+		if (mixer->active && mixer->callback_mode_process == mode && (p_physics ? mixer->is_physics_processing_internal() : mixer->is_processing_internal()) && mixer->can_process()) {
+			batch.push_back(mixer->get_instance_id());
+		}
+	}
+	if (batch.is_empty()) {
+		return;
+	}
+
+	struct PendingMixer {
+		ObjectID id;
+		bool evaluated = false;
+	};
+	LocalVector<PendingMixer> pending;
+	for (const ObjectID &id : batch) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (!mixer || !mixer->active || !mixer->is_inside_tree()) {
+			continue;
+		}
+		mixer->parallel_process_pass = pass;
+		mixer->parallel_delta = p_physics ? mixer->get_physics_process_delta_time() : mixer->get_process_delta_time();
+		if (!mixer->_lod_update(mixer->parallel_delta)) {
+			continue;
+		}
+		mixer->_blend_init();
+		if (mixer->_blend_pre_process(mixer->parallel_delta, mixer->track_count, mixer->track_map)) {
+			PendingMixer pm;
+			pm.id = id;
+			pending.push_back(pm);
+		} else {
+			mixer->clear_animation_instances();
+		}
+	}
+
+	// Nothing else runs until everything is evaluated, so the pointers stay valid meanwhile.
+	LocalVector<AnimationMixer *> parallel;
+	for (PendingMixer &pm : pending) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(pm.id));
+		if (!mixer || !mixer->cache_valid || !mixer->parallel_safe) {
+			continue;
+		}
+		if (mixer->_has_post_process_key_value_override()) {
+			continue; // Scripts must be called from the main thread.
+		}
+		pm.evaluated = true;
+		parallel.push_back(mixer);
+	}
+
+	if (parallel.size() == 1) {
+		parallel[0]->_blend_evaluate(parallel[0]->parallel_delta);
+	} else if (parallel.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationMixer::_parallel_evaluate_task, parallel.ptr(), parallel.size(), -1, true, SNAME("AnimationMixerEvaluate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	for (const PendingMixer &pm : pending) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(pm.id));
+		if (!mixer) {
+			continue;
+		}
+		if (!pm.evaluated) {
+			mixer->_blend_evaluate(mixer->parallel_delta);
+		}
+		mixer->_blend_apply();
+		mixer->_blend_post_process();
+		mixer->emit_signal(SNAME("mixer_applied"));
+		mixer->clear_animation_instances();
+	}
+}
+
+/* -------------------------------------------- */
+/* -- Level of detail ------------------------- */
+/* -------------------------------------------- */
+
+int AnimationMixer::get_lod_update_interval() const {
+#ifndef _3D_DISABLED
+	if (!is_inside_tree()) {
+		return 1;
+	}
+	const Node3D *reference = nullptr;
+	if (!lod_visibility_notifier.is_empty()) {
+		const VisibleOnScreenNotifier3D *notifier = Object::cast_to<VisibleOnScreenNotifier3D>(get_node_or_null(lod_visibility_notifier));
+		if (notifier) {
+			if (!notifier->is_on_screen()) {
+				return lod_offscreen_update_interval;
+			}
+			reference = notifier;
+		}
+	}
+	if (lod_distances.is_empty()) {
+		return 1;
+	}
+	if (!reference) {
+		reference = Object::cast_to<Node3D>(get_node_or_null(root_node));
+	}
+	const Camera3D *camera = get_viewport()->get_camera_3d();
+	if (!reference || !camera) {
+		return 1;
+	}
+
+	// Each distance that is reached halves the update rate.
+	const real_t distance = camera->get_global_position().distance_to(reference->get_global_position());
+	int band = 0;
+	for (const float &lod_distance : lod_distances) {
+		if (distance >= lod_distance) {
+			band++;
+		}
+	}
+	return 1 << MIN(band, 16);
+#else
+	return 1;
+#endif // _3D_DISABLED
+}
+
+// Return whether the animation must be processed this frame, with the delta of all the frames skipped before it.
+bool AnimationMixer::_lod_update(double &r_delta) {
+	if (lod_distances.is_empty() && lod_visibility_notifier.is_empty()) {
+		lod_reduced = false;
+		return true;
+	}
+	if (Engine::get_singleton()->is_editor_hint()) {
+		lod_reduced = false;
+		return true;
+	}
+
+	const int interval = get_lod_update_interval();
+	lod_frame++;
+	if (interval == 0 || lod_frame % interval != 0) {
+		lod_accumulated_delta += r_delta;
+#ifndef _3D_DISABLED
+		// The bone poses stay the same, so the skeletons don't have to process their modifiers again either.
+		for (const ObjectID &skeleton_id : animated_skeletons) {
+			Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(skeleton_id));
+			if (skeleton) {
+				skeleton->skip_next_modifier_update();
+			}
+		}
+#endif // _3D_DISABLED
+		return false;
+	}
+
+	r_delta += lod_accumulated_delta;
+	lod_accumulated_delta = 0.0;
+	lod_reduced = interval > 1;
+	return true;
+}
+
 /* -------------------------------------------- */
 /* -- Root motion ----------------------------- */
 /* -------------------------------------------- */
@@ -2349,21 +2814,36 @@ void AnimationMixer::_notification(int p_what) {
 				set_process_internal(false);
 			}
 			_clear_caches();
+			if (parallel_processing) {
+				_parallel_register();
+			}
+			// Spread the reduced rate updates of the mixers entering the tree together over different frames.
+			lod_frame = hash_murmur3_one_64(get_instance_id());
+			lod_accumulated_delta = 0.0;
 		} break;
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE && !_is_parallel_processed(false)) {
+				double delta = get_process_delta_time();
+				if (_lod_update(delta)) {
+					_process_animation(delta);
+				}
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS && !_is_parallel_processed(true)) {
+				double delta = get_physics_process_delta_time();
+				if (_lod_update(delta)) {
+					_process_animation(delta);
+				}
 			}
 		} break;
 
 		case NOTIFICATION_EXIT_TREE: {
+			if (parallel_processing) {
+				_parallel_unregister();
+			}
 			_clear_caches();
 		} break;
 	}
@@ -2423,6 +2903,20 @@ void AnimationMixer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_callback_mode_discrete", "mode"), &AnimationMixer::set_callback_mode_discrete);
 	ClassDB::bind_method(D_METHOD("get_callback_mode_discrete"), &AnimationMixer::get_callback_mode_discrete);
 
+	ClassDB::bind_method(D_METHOD("set_parallel_processing_enabled", "enabled"), &AnimationMixer::set_parallel_processing_enabled);
+	ClassDB::bind_method(D_METHOD("is_parallel_processing_enabled"), &AnimationMixer::is_parallel_processing_enabled);
+
+	/* ---- Level of detail ---- */
+	ClassDB::bind_method(D_METHOD("set_lod_distances", "distances"), &AnimationMixer::set_lod_distances);
+	ClassDB::bind_method(D_METHOD("get_lod_distances"), &AnimationMixer::get_lod_distances);
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationMixer::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationMixer::get_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("set_lod_offscreen_update_interval", "interval"), &AnimationMixer::set_lod_offscreen_update_interval);
+	ClassDB::bind_method(D_METHOD("get_lod_offscreen_update_interval"), &AnimationMixer::get_lod_offscreen_update_interval);
+	ClassDB::bind_method(D_METHOD("set_lod_skip_blend_shapes_enabled", "enabled"), &AnimationMixer::set_lod_skip_blend_shapes_enabled);
+	ClassDB::bind_method(D_METHOD("is_lod_skip_blend_shapes_enabled"), &AnimationMixer::is_lod_skip_blend_shapes_enabled);
+	ClassDB::bind_method(D_METHOD("get_lod_update_interval"), &AnimationMixer::get_lod_update_interval);
+
 	/* ---- Audio ---- */
 	ClassDB::bind_method(D_METHOD("set_audio_max_polyphony", "max_polyphony"), &AnimationMixer::set_audio_max_polyphony);
 	ClassDB::bind_method(D_METHOD("get_audio_max_polyphony"), &AnimationMixer::get_audio_max_polyphony);
@@ -2454,6 +2948,7 @@ void AnimationMixer::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "deterministic"), "set_deterministic", "is_deterministic");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "parallel_processing"), "set_parallel_processing_enabled", "is_parallel_processing_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "reset_on_save", PROPERTY_HINT_NONE, ""), "set_reset_on_save_enabled", "is_reset_on_save_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_node"), "set_root_node", "get_root_node");
 
@@ -2461,6 +2956,12 @@ void AnimationMixer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "root_motion_local"), "set_root_motion_local", "is_root_motion_local");
 
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "lod_distances"), "set_lod_distances", "get_lod_distances");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_offscreen_update_interval", PROPERTY_HINT_RANGE, "0,60,1"), "set_lod_offscreen_update_interval", "get_lod_offscreen_update_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lod_skip_blend_shapes"), "set_lod_skip_blend_shapes_enabled", "is_lod_skip_blend_shapes_enabled");
+
 	ADD_GROUP("Audio", "audio_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "audio_max_polyphony", PROPERTY_HINT_RANGE, "1,127,1"), "set_audio_max_polyphony", "get_audio_max_polyphony");
 
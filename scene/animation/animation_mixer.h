@@ -139,6 +139,39 @@ protected:
 
 	void _set_process(bool p_process, bool p_force = false);
 
+	/* ---- Parallel processing ---- */
+	// Mixers with parallel processing enabled are processed together at the start of the frame, see _process_parallel_mixers().
+	bool parallel_processing = false;
+	bool parallel_safe = false; // Whether the track caches can be evaluated outside of the main thread, updated with the caches.
+	uint64_t parallel_process_pass = 0;
+	double parallel_delta = 0.0;
+
+	static LocalVector<AnimationMixer *> parallel_mixers;
+	static ObjectID parallel_tree_id;
+	static uint64_t parallel_pass_count;
+	static uint64_t parallel_idle_pass;
+	static uint64_t parallel_physics_pass;
+
+	void _parallel_register();
+	void _parallel_unregister();
+	bool _is_parallel_processed(bool p_physics) const;
+	static void _parallel_evaluate_task(void *p_userdata, uint32_t p_index);
+	static void _process_parallel_mixers(bool p_physics);
+	static void _process_parallel_mixers_idle() { _process_parallel_mixers(false); }
+	static void _process_parallel_mixers_physics() { _process_parallel_mixers(true); }
+
+	/* ---- Level of detail ---- */
+	PackedFloat32Array lod_distances;
+	NodePath lod_visibility_notifier;
+	int lod_offscreen_update_interval = 8;
+	bool lod_skip_blend_shapes = true;
+	uint32_t lod_frame = 0;
+	double lod_accumulated_delta = 0.0;
+	bool lod_reduced = false; // Whether the current update is at a lower rate, where optional tracks are skipped.
+	LocalVector<ObjectID> animated_skeletons;
+
+	bool _lod_update(double &r_delta);
+
 	/* ---- Caches for blending ---- */
 	bool cache_valid = false;
 	uint64_t setup_pass = 1;
@@ -312,6 +345,26 @@ protected:
 	RootMotionCache root_motion_cache;
 	AHashMap<Animation::TypeHash, TrackCache *, HashHasher> track_cache;
 	AHashMap<Ref<Animation>, LocalVector<TrackCache *>> animation_track_num_to_track_cashe;
+
+	// Animations whose tracks only move the bones of a single Skeleton3D are blended by _blend_process_skeleton(),
+	// which samples each kind of track into its own array, remembering where the keys were found between frames.
+	struct SkeletonBlendCache {
+		ObjectID skeleton_id;
+		int animation_track_count = 0;
+		NodePath root_motion_track; // What root_motion_track was when has_root_motion was last checked.
+		bool has_root_motion = false;
+		LocalVector<int> tracks; // Position tracks first, then rotation tracks, then scale tracks.
+		LocalVector<TrackCacheTransform *> caches;
+		LocalVector<Animation::KeyCursor> cursors;
+		uint32_t rotation_offset = 0;
+		uint32_t scale_offset = 0;
+		LocalVector<real_t> blends;
+		LocalVector<Vector3> positions;
+		LocalVector<Quaternion> rotations;
+		LocalVector<Vector3> scales;
+	};
+	AHashMap<Ref<Animation>, SkeletonBlendCache> animation_skeleton_blend_cache;
+
 	HashSet<TrackCache *> playing_caches;
 	Vector<Node *> playing_audio_stream_players;
 
@@ -322,6 +375,7 @@ protected:
 	void _init_root_motion_cache();
 	bool _update_caches();
 	void _create_track_num_to_track_cashe_for_animation(Ref<Animation> &p_animation);
+	void _create_skeleton_blend_cache_for_animation(const Ref<Animation> &p_animation);
 
 	/* ---- Audio ---- */
 	AudioServer::PlaybackType playback_type;
@@ -373,6 +427,9 @@ protected:
 	virtual void _blend_capture(double p_delta);
 	void _blend_calc_total_weight(); // For undeterministic blending.
 	void _blend_process(double p_delta, bool p_update_only = false);
+	bool _blend_process_skeleton(const AnimationInstance &p_instance);
+	bool _has_post_process_key_value_override();
+	void _blend_evaluate(double p_delta, bool p_update_only = false); // Capture, weights and process, only touches the track caches when parallel safe.
 	void _blend_apply();
 	virtual void _blend_post_process();
 	void _call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred);
@@ -440,6 +497,24 @@ public:
 	void set_callback_mode_discrete(AnimationCallbackModeDiscrete p_mode);
 	AnimationCallbackModeDiscrete get_callback_mode_discrete() const;
 
+	void set_parallel_processing_enabled(bool p_enabled);
+	bool is_parallel_processing_enabled() const;
+
+	/* ---- Level of detail ---- */
+	void set_lod_distances(const PackedFloat32Array &p_distances);
+	PackedFloat32Array get_lod_distances() const;
+
+	void set_lod_visibility_notifier(const NodePath &p_path);
+	NodePath get_lod_visibility_notifier() const;
+
+	void set_lod_offscreen_update_interval(int p_interval);
+	int get_lod_offscreen_update_interval() const;
+
+	void set_lod_skip_blend_shapes_enabled(bool p_enabled);
+	bool is_lod_skip_blend_shapes_enabled() const;
+
+	int get_lod_update_interval() const;
+
 	/* ---- Audio ---- */
 	void set_audio_max_polyphony(int p_audio_max_polyphony);
 	int get_audio_max_polyphony() const;
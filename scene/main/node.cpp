@@ -3777,6 +3777,8 @@ void Node::_bind_methods() {
 
 	BIND_CONSTANT(NOTIFICATION_EDITOR_PRE_SAVE);
 	BIND_CONSTANT(NOTIFICATION_EDITOR_POST_SAVE);
+	BIND_CONSTANT(NOTIFICATION_POOL_RELEASED);
+	BIND_CONSTANT(NOTIFICATION_POOL_ACQUIRED);
 
 	BIND_CONSTANT(NOTIFICATION_WM_MOUSE_ENTER);
 	BIND_CONSTANT(NOTIFICATION_WM_MOUSE_EXIT);
@@ -3986,6 +3988,11 @@ Error Node::emit_signalp(const StringName &p_name, const Variant **p_args, int p
 	return Object::emit_signalp(p_name, p_args, p_argcount);
 }
 
+Error Node::emit_signal_handlep(SignalHandle &p_handle, const Variant **p_args, int p_argcount) {
+	ERR_THREAD_GUARD_V(ERR_INVALID_PARAMETER);
+	return Object::emit_signal_handlep(p_handle, p_args, p_argcount);
+}
+
 bool Node::has_signal(const StringName &p_name) const {
 	ERR_THREAD_GUARD_V(false);
 	return Object::has_signal(p_name);
@@ -441,7 +441,11 @@ public:
 		NOTIFICATION_EDITOR_PRE_SAVE = 9001,
 		NOTIFICATION_EDITOR_POST_SAVE = 9002,
 		NOTIFICATION_SUSPENDED = 9003,
-		NOTIFICATION_UNSUSPENDED = 9004
+		NOTIFICATION_UNSUSPENDED = 9004,
+
+		// Sent by ScenePool.
+		NOTIFICATION_POOL_RELEASED = 9005,
+		NOTIFICATION_POOL_ACQUIRED = 9006,
 	};
 
 	/* NODE/TREE */
@@ -795,6 +799,7 @@ public:
 	virtual void get_meta_list(List<StringName> *p_list) const override;
 
 	virtual Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) override;
+	virtual Error emit_signal_handlep(SignalHandle &p_handle, const Variant **p_args, int p_argcount) override;
 	virtual bool has_signal(const StringName &p_name) const override;
 	virtual void get_signal_list(List<MethodInfo> *p_signals) const override;
 	virtual void get_signal_connection_list(const StringName &p_signal, List<Connection> *p_connections) const override;
@@ -0,0 +1,308 @@
+/**************************************************************************/
+/*  scene_pool.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_pool.h"
+
+#include "core/object/script_language.h"
+#include "scene/main/canvas_item.h"
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif // _3D_DISABLED
+
+Node *ScenePool::_instantiate() {
+	Node *node = scene->instantiate();
+	ERR_FAIL_NULL_V_MSG(node, nullptr, vformat("Failed to instantiate scene \"%s\" for the pool.", scene->get_path()));
+	if (!defaults_recorded) {
+		_record_defaults(node);
+	}
+	return node;
+}
+
+void ScenePool::_record_defaults(Node *p_root) {
+	defaults.clear();
+	_record_node_defaults(p_root, p_root);
+	defaults_recorded = true;
+}
+
+void ScenePool::_record_node_defaults(Node *p_root, Node *p_node) {
+	NodeDefaults node_defaults;
+	node_defaults.path = p_root->get_path_to(p_node);
+
+	List<PropertyInfo> properties;
+	p_node->get_property_list(&properties);
+	for (const PropertyInfo &E : properties) {
+		if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == CoreStringName(script)) {
+			continue;
+		}
+
+		PropertyDefault property;
+		property.name = E.name;
+		property.value = p_node->get(E.name);
+		Ref<Resource> res = property.value;
+		if (res.is_valid() && res->is_local_to_scene()) {
+			// Each instance has its own copy, which must not be replaced by the one of another instance.
+			continue;
+		}
+		if (property.value.get_type() == Variant::OBJECT) {
+			Node *node = Object::cast_to<Node>(property.value.get_validated_object());
+			if (node) {
+				if (node != p_root && !p_root->is_ancestor_of(node)) {
+					continue; // Outside of the scene, nothing to reset it to.
+				}
+				// Each instance must point to its own node, not to the one of the instance recorded here.
+				property.value = p_root->get_path_to(node);
+				property.node_reference = true;
+			}
+		} else if (property.value.get_type() == Variant::ARRAY || property.value.get_type() == Variant::DICTIONARY) {
+			if (_contains_node(property.value)) {
+				continue; // Nodes of the recorded instance can't be stored for the other ones.
+			}
+			property.value = property.value.duplicate();
+		}
+		node_defaults.properties.push_back(property);
+	}
+	defaults.push_back(node_defaults);
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_record_node_defaults(p_root, p_node->get_child(i));
+	}
+}
+
+bool ScenePool::_contains_node(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			return Object::cast_to<Node>(p_value.get_validated_object()) != nullptr;
+		}
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				if (_contains_node(array[i])) {
+					return true;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			for (const Variant *key = dictionary.next(nullptr); key; key = dictionary.next(key)) {
+				if (_contains_node(*key) || _contains_node(dictionary[*key])) {
+					return true;
+				}
+			}
+		} break;
+		default:
+			break;
+	}
+	return false;
+}
+
+void ScenePool::_reset(Node *p_root) {
+	for (const NodeDefaults &node_defaults : defaults) {
+		Node *node = p_root->get_node_or_null(node_defaults.path);
+		if (!node) {
+			continue;
+		}
+
+		for (const PropertyDefault &E : node_defaults.properties) {
+			Variant value = E.value;
+			if (E.node_reference) {
+				value = p_root->get_node_or_null(E.value);
+			}
+
+			// Only set what changed, most properties keep their value during the life of an instance.
+			bool valid = false;
+			Variant current = node->get(E.name, &valid);
+			if (valid && current == value) {
+				continue;
+			}
+			if (value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+				node->set(E.name, value.duplicate());
+			} else {
+				node->set(E.name, value);
+			}
+		}
+	}
+}
+
+void ScenePool::_make_dormant(Node *p_root) {
+	// Both are stored properties, so resetting the instance when it's acquired brings it back.
+	p_root->set_process_mode(Node::PROCESS_MODE_DISABLED);
+	CanvasItem *canvas_item = Object::cast_to<CanvasItem>(p_root);
+	if (canvas_item) {
+		canvas_item->hide();
+	}
+#ifndef _3D_DISABLED
+	Node3D *node_3d = Object::cast_to<Node3D>(p_root);
+	if (node_3d) {
+		node_3d->hide();
+	}
+#endif // _3D_DISABLED
+}
+
+void ScenePool::_free_available() {
+	for (const ObjectID &id : available) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		if (node) {
+			memdelete(node);
+		}
+	}
+	available.clear();
+}
+
+void ScenePool::set_scene(const Ref<PackedScene> &p_scene) {
+	if (scene == p_scene) {
+		return;
+	}
+	clear();
+	scene = p_scene;
+	defaults.clear();
+	defaults_recorded = false;
+}
+
+Ref<PackedScene> ScenePool::get_scene() const {
+	return scene;
+}
+
+void ScenePool::set_max_size(int p_max_size) {
+	ERR_FAIL_COND(p_max_size < 0);
+	max_size = p_max_size;
+	while (max_size > 0 && (int)available.size() > max_size) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(available[available.size() - 1]));
+		available.resize(available.size() - 1);
+		if (node) {
+			memdelete(node);
+		}
+	}
+}
+
+int ScenePool::get_max_size() const {
+	return max_size;
+}
+
+void ScenePool::set_keep_in_tree(bool p_keep_in_tree) {
+	keep_in_tree = p_keep_in_tree;
+}
+
+bool ScenePool::is_keeping_in_tree() const {
+	return keep_in_tree;
+}
+
+Node *ScenePool::acquire() {
+	ERR_FAIL_COND_V_MSG(scene.is_null(), nullptr, "No scene set for the pool.");
+
+	while (!available.is_empty()) {
+		ObjectID id = available[available.size() - 1];
+		available.resize(available.size() - 1);
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		if (!node) {
+			continue; // Freed while in the pool.
+		}
+		_reset(node);
+		node->notification(Node::NOTIFICATION_POOL_ACQUIRED);
+		return node;
+	}
+
+	return _instantiate();
+}
+
+void ScenePool::release(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), "Can't release a node queued for deletion to the pool.");
+	ERR_FAIL_COND_MSG(scene.is_null(), "No scene set for the pool.");
+	// Instances of a scene saved to its own file know where they come from, other ones can't be told apart.
+	const String scene_file_path = scene->is_built_in() ? String() : scene->get_path();
+	ERR_FAIL_COND_MSG(p_node->get_scene_file_path() != scene_file_path, vformat("Node \"%s\" is not an instance of the pooled scene \"%s\".", p_node->get_name(), scene->get_path()));
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(available.has(p_node->get_instance_id()), vformat("Node \"%s\" is already in the pool.", p_node->get_name()));
+#endif
+
+	const bool dormant = keep_in_tree && p_node->is_inside_tree();
+	if (!dormant) {
+		Node *parent = p_node->get_parent();
+		if (parent) {
+			parent->remove_child(p_node);
+		}
+	}
+
+	if (max_size > 0 && (int)available.size() >= max_size) {
+		// The pool is full. Queued, as this may be called from one of the node's own callbacks.
+		p_node->queue_free();
+		return;
+	}
+
+	if (dormant) {
+		_make_dormant(p_node);
+	}
+	p_node->notification(Node::NOTIFICATION_POOL_RELEASED);
+	available.push_back(p_node->get_instance_id());
+}
+
+void ScenePool::prewarm(int p_count) {
+	ERR_FAIL_COND_MSG(scene.is_null(), "No scene set for the pool.");
+	ERR_FAIL_COND(p_count < 0);
+
+	int target = max_size > 0 ? MIN(p_count, max_size) : p_count;
+	while ((int)available.size() < target) {
+		Node *node = _instantiate();
+		ERR_FAIL_NULL(node);
+		available.push_back(node->get_instance_id());
+	}
+}
+
+int ScenePool::get_available_count() const {
+	return available.size();
+}
+
+void ScenePool::clear() {
+	_free_available();
+}
+
+void ScenePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_scene", "scene"), &ScenePool::set_scene);
+	ClassDB::bind_method(D_METHOD("get_scene"), &ScenePool::get_scene);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &ScenePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &ScenePool::get_max_size);
+	ClassDB::bind_method(D_METHOD("set_keep_in_tree", "enable"), &ScenePool::set_keep_in_tree);
+	ClassDB::bind_method(D_METHOD("is_keeping_in_tree"), &ScenePool::is_keeping_in_tree);
+
+	ClassDB::bind_method(D_METHOD("acquire"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &ScenePool::prewarm);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &ScenePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("clear"), &ScenePool::clear);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"), "set_scene", "get_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "keep_in_tree"), "set_keep_in_tree", "is_keeping_in_tree");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_max_size", "get_max_size");
+}
+
+ScenePool::~ScenePool() {
+	_free_available();
+}
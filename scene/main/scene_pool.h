@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  scene_pool.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SCENE_POOL_H
+#define SCENE_POOL_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/packed_scene.h"
+
+// Keeps instances of a scene that are not needed anymore out of the tree (or disabled in it), so they can be reused
+// instead of freeing them and instantiating the scene again.
+class ScenePool : public RefCounted {
+	GDCLASS(ScenePool, RefCounted);
+
+	struct PropertyDefault {
+		StringName name;
+		Variant value;
+		bool node_reference = false; // The value is the path of a node of the scene, relative to its root.
+	};
+
+	// Values of the stored properties of a node, as they were right after the scene was instantiated.
+	struct NodeDefaults {
+		NodePath path; // Relative to the root of the scene.
+		LocalVector<PropertyDefault> properties;
+	};
+
+	Ref<PackedScene> scene;
+	int max_size = 0;
+	bool keep_in_tree = false;
+
+	LocalVector<ObjectID> available;
+	LocalVector<NodeDefaults> defaults;
+	bool defaults_recorded = false;
+
+	Node *_instantiate();
+	void _record_defaults(Node *p_root);
+	void _record_node_defaults(Node *p_root, Node *p_node);
+	static bool _contains_node(const Variant &p_value);
+	void _reset(Node *p_root);
+	void _make_dormant(Node *p_root);
+	void _free_available();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_scene(const Ref<PackedScene> &p_scene);
+	Ref<PackedScene> get_scene() const;
+
+	void set_max_size(int p_max_size);
+	int get_max_size() const;
+
+	void set_keep_in_tree(bool p_keep_in_tree);
+	bool is_keeping_in_tree() const;
+
+	Node *acquire();
+	void release(Node *p_node);
+	void prewarm(int p_count);
+
+	int get_available_count() const;
+	void clear();
+
+	ScenePool() {}
+	~ScenePool();
+};
+
+#endif // SCENE_POOL_H
@@ -173,10 +173,12 @@ SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_nod
 		E = group_map.insert(p_group, Group());
 	}
 
-	ERR_FAIL_COND_V_MSG(E->value.nodes.has(p_node), &E->value, "Already in group: " + p_group + ".");
-	E->value.nodes.push_back(p_node);
-	E->value.changed = true;
-	return &E->value;
+	Group &g = E->value;
+	ERR_FAIL_COND_V_MSG(g.indices.has(p_node), &g, "Already in group: " + p_group + ".");
+	g.indices.insert(p_node, g.nodes.size());
+	g.nodes.push_back(p_node);
+	g.changed = true;
+	return &g;
 }
 
 void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
@@ -185,9 +187,21 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
 	ERR_FAIL_COND(!E);
 
-	E->value.nodes.erase(p_node);
-	if (E->value.nodes.is_empty()) {
+	Group &g = E->value;
+	HashMap<Node *, int>::Iterator I = g.indices.find(p_node);
+	if (!I) {
+		return;
+	}
+	int index = I->value;
+	g.indices.remove(I);
+
+	if (g.indices.is_empty()) {
 		group_map.remove(E);
+	} else if (index == g.nodes.size() - 1) {
+		g.nodes.resize(index);
+	} else {
+		g.nodes.write[index] = nullptr;
+		g.removed++;
 	}
 }
 
@@ -233,6 +247,25 @@ void SceneTree::_flush_ugc() {
 }
 
 void SceneTree::_update_group_order(Group &g) {
+	if (g.removed > 0) {
+		// Compact the nodes left by removals, keeping their order.
+		Node **gr_nodes = g.nodes.ptrw();
+		int gr_node_count = g.nodes.size();
+		int to = 0;
+		for (int from = 0; from < gr_node_count; from++) {
+			if (!gr_nodes[from]) {
+				continue;
+			}
+			if (from != to) {
+				gr_nodes[to] = gr_nodes[from];
+				*g.indices.getptr(gr_nodes[to]) = to;
+			}
+			to++;
+		}
+		g.nodes.resize(to);
+		g.removed = 0;
+	}
+
 	if (!g.changed) {
 		return;
 	}
@@ -246,9 +279,104 @@ void SceneTree::_update_group_order(Group &g) {
 	SortArray<Node *, Node::Comparator> node_sort;
 	node_sort.sort(gr_nodes, gr_node_count);
 
+	for (int i = 0; i < gr_node_count; i++) {
+		*g.indices.getptr(gr_nodes[i]) = i;
+	}
+
 	g.changed = false;
 }
 
+Vector<Node *> SceneTree::_get_group_nodes(const StringName &p_group) {
+	_THREAD_SAFE_METHOD_
+	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
+	if (!E) {
+		return Vector<Node *>();
+	}
+
+	_update_group_order(E->value);
+	return E->value.nodes;
+}
+
+void SceneTree::_lock_group_call() {
+	_THREAD_SAFE_METHOD_
+	nodes_removed_on_group_call_lock++;
+}
+
+void SceneTree::_unlock_group_call() {
+	_THREAD_SAFE_METHOD_
+	nodes_removed_on_group_call_lock--;
+	if (nodes_removed_on_group_call_lock == 0) {
+		nodes_removed_on_group_call.clear();
+	}
+}
+
+void SceneTree::_call_group_node(Node *p_node, const StringName &p_function, const Variant **p_args, int p_argcount) {
+	Callable::CallError ce;
+	p_node->callp(p_function, p_args, p_argcount, ce);
+	if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
+		ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", p_node->get_name(), Variant::get_callable_error_text(Callable(p_node, p_function), p_args, p_argcount, ce)));
+	}
+}
+
+void SceneTree::_call_group_thread(uint32_t p_index, GroupCallThreadData *p_data) {
+	const GroupCallThreadTask &task = p_data->tasks[p_index];
+	Node::current_process_thread_group = task.owner;
+	for (Node *node : task.nodes) {
+		_call_group_node(node, p_data->function, p_data->args, p_data->argcount);
+	}
+	Node::current_process_thread_group = nullptr;
+}
+
+void SceneTree::_call_group_threaded(const Vector<Node *> &p_nodes, const StringName &p_function, const Variant **p_args, int p_argcount) {
+	// Nodes processed in a sub-thread group are called from a worker thread, one task per group so the calls to
+	// the nodes of a group stay sequential, like when processing them. The other nodes are called on this thread first.
+	GroupCallThreadData data;
+	data.function = p_function;
+	data.args = p_args;
+	data.argcount = p_argcount;
+	HashMap<Node *, uint32_t> task_indices;
+
+	for (Node *node : p_nodes) {
+		if (nodes_removed_on_group_call.has(node)) {
+			continue;
+		}
+
+		Node *owner = node->data.process_thread_group_owner;
+		if (!owner || owner->data.process_thread_group != Node::PROCESS_THREAD_GROUP_SUB_THREAD) {
+			_call_group_node(node, p_function, p_args, p_argcount);
+			continue;
+		}
+
+		HashMap<Node *, uint32_t>::Iterator E = task_indices.find(owner);
+		if (!E) {
+			E = task_indices.insert(owner, data.tasks.size());
+			data.tasks.push_back(GroupCallThreadTask());
+			data.tasks[E->value].owner = owner;
+		}
+		data.tasks[E->value].nodes.push_back(node);
+	}
+
+	if (data.tasks.is_empty()) {
+		return;
+	}
+
+	if (!nodes_removed_on_group_call.is_empty()) {
+		// Nodes removed by the calls made on this thread are not called from the worker threads either.
+		for (GroupCallThreadTask &task : data.tasks) {
+			uint32_t to = 0;
+			for (uint32_t from = 0; from < task.nodes.size(); from++) {
+				if (!nodes_removed_on_group_call.has(task.nodes[from])) {
+					task.nodes[to++] = task.nodes[from];
+				}
+			}
+			task.nodes.resize(to);
+		}
+	}
+
+	WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_call_group_thread, &data, data.tasks.size(), -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+}
+
 void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
 	Vector<Node *> nodes_copy;
 
@@ -288,7 +416,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 		nodes_copy = g.nodes;
 	}
 
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
 	{
@@ -296,7 +424,12 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 		nodes_removed_on_group_call_lock++;
 	}
 
-	if (p_call_flags & GROUP_CALL_REVERSE) {
+	// Threads are only dispatched from the main thread, nodes of a thread group calling a group are called sequentially.
+	bool threaded = (p_call_flags & GROUP_CALL_THREADED) && !(p_call_flags & GROUP_CALL_DEFERRED) && !node_threading_disabled && !Node::is_group_processing() && Thread::is_main_thread();
+
+	if (threaded) {
+		_call_group_threaded(nodes_copy, p_function, p_args, p_argcount);
+	} else if (p_call_flags & GROUP_CALL_REVERSE) {
 		for (int i = gr_node_count - 1; i >= 0; i--) {
 			if (nodes_removed_on_group_call_lock && nodes_removed_on_group_call.has(gr_nodes[i])) {
 				continue;
@@ -304,11 +437,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 
 			Node *node = gr_nodes[i];
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
-				Callable::CallError ce;
-				node->callp(p_function, p_args, p_argcount, ce);
-				if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
-					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
-				}
+				_call_group_node(node, p_function, p_args, p_argcount);
 			} else {
 				MessageQueue::get_singleton()->push_callp(node, p_function, p_args, p_argcount);
 			}
@@ -322,11 +451,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 
 			Node *node = gr_nodes[i];
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
-				Callable::CallError ce;
-				node->callp(p_function, p_args, p_argcount, ce);
-				if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
-					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
-				}
+				_call_group_node(node, p_function, p_args, p_argcount);
 			} else {
 				MessageQueue::get_singleton()->push_callp(node, p_function, p_args, p_argcount);
 			}
@@ -360,7 +485,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 		nodes_copy = g.nodes;
 	}
 
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
 	{
@@ -422,7 +547,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 
 		nodes_copy = g.nodes;
 	}
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
 	{
@@ -536,7 +661,7 @@ bool SceneTree::physics_process(double p_time) {
 	}
 	physics_process_time = p_time;
 
-	emit_signal(SNAME("physics_frame"));
+	emit_signal(physics_frame_signal);
 
 	call_group(SNAME("_picking_viewports"), SNAME("_process_picking"));
 
@@ -579,7 +704,7 @@ bool SceneTree::process(double p_time) {
 		}
 	}
 
-	emit_signal(SNAME("process_frame"));
+	emit_signal(process_frame_signal);
 
 	MessageQueue::get_singleton()->flush(); //small little hack
 
@@ -1274,7 +1399,7 @@ void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_cal
 	}
 
 	int gr_node_count = nodes_copy.size();
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 
 	{
 		_THREAD_SAFE_METHOD_
@@ -1393,7 +1518,7 @@ TypedArray<Node> SceneTree::_get_nodes_in_group(const StringName &p_group) {
 
 	ret.resize(nc);
 
-	Node **ptr = E->value.nodes.ptrw();
+	Node *const *ptr = E->value.nodes.ptr();
 	for (int i = 0; i < nc; i++) {
 		ret[i] = ptr[i];
 	}
@@ -1413,7 +1538,7 @@ int SceneTree::get_node_count_in_group(const StringName &p_group) const {
 		return 0;
 	}
 
-	return E->value.nodes.size();
+	return E->value.indices.size();
 }
 
 Node *SceneTree::get_first_node_in_group(const StringName &p_group) {
@@ -1444,7 +1569,7 @@ void SceneTree::get_nodes_in_group(const StringName &p_group, List<Node *> *p_li
 	if (nc == 0) {
 		return;
 	}
-	Node **ptr = E->value.nodes.ptrw();
+	Node *const *ptr = E->value.nodes.ptr();
 	for (int i = 0; i < nc; i++) {
 		p_list->push_back(ptr[i]);
 	}
@@ -1776,6 +1901,7 @@ void SceneTree::_bind_methods() {
 	BIND_ENUM_CONSTANT(GROUP_CALL_REVERSE);
 	BIND_ENUM_CONSTANT(GROUP_CALL_DEFERRED);
 	BIND_ENUM_CONSTANT(GROUP_CALL_UNIQUE);
+	BIND_ENUM_CONSTANT(GROUP_CALL_THREADED);
 }
 
 SceneTree *SceneTree::singleton = nullptr;
@@ -1829,6 +1955,9 @@ SceneTree::SceneTree() {
 
 	GLOBAL_DEF("debug/shapes/collision/draw_2d_outlines", true);
 
+	physics_frame_signal = get_signal_handle(SNAME("physics_frame"));
+	process_frame_signal = get_signal_handle(SNAME("process_frame"));
+
 	process_group_call_queue_allocator = memnew(CallQueue::Allocator(64));
 	Math::randomize();
 
@@ -120,6 +120,10 @@ private:
 
 	struct Group {
 		Vector<Node *> nodes;
+		// Position of each node in `nodes`, so membership can be checked and removed without searching.
+		HashMap<Node *, int> indices;
+		// Removed nodes leave a null behind, compacted on the next update, so removals don't shift the whole group.
+		int removed = 0;
 		bool changed = false;
 	};
 
@@ -134,6 +138,9 @@ private:
 
 	double physics_process_time = 0.0;
 	double process_time = 0.0;
+	// Emitted every frame, so they are resolved once.
+	SignalHandle physics_frame_signal;
+	SignalHandle process_frame_signal;
 	bool accept_quit = true;
 	bool quit_on_go_back = true;
 
@@ -184,6 +191,25 @@ private:
 	void _flush_ugc();
 
 	_FORCE_INLINE_ void _update_group_order(Group &g);
+	Vector<Node *> _get_group_nodes(const StringName &p_group);
+	void _lock_group_call();
+	void _unlock_group_call();
+
+	struct GroupCallThreadTask {
+		Node *owner = nullptr;
+		LocalVector<Node *> nodes;
+	};
+
+	struct GroupCallThreadData {
+		LocalVector<GroupCallThreadTask> tasks;
+		StringName function;
+		const Variant **args = nullptr;
+		int argcount = 0;
+	};
+
+	void _call_group_node(Node *p_node, const StringName &p_function, const Variant **p_args, int p_argcount);
+	void _call_group_thread(uint32_t p_index, GroupCallThreadData *p_data);
+	void _call_group_threaded(const Vector<Node *> &p_nodes, const StringName &p_function, const Variant **p_args, int p_argcount);
 
 	TypedArray<Node> _get_nodes_in_group(const StringName &p_group);
 
@@ -285,6 +311,7 @@ public:
 		GROUP_CALL_REVERSE = 1,
 		GROUP_CALL_DEFERRED = 2,
 		GROUP_CALL_UNIQUE = 4,
+		GROUP_CALL_THREADED = 8,
 	};
 
 	_FORCE_INLINE_ Window *get_root() const { return root; }
@@ -392,6 +419,27 @@ public:
 	void queue_delete(Object *p_object);
 
 	void get_nodes_in_group(const StringName &p_group, List<Node *> *p_list);
+
+	// Calls `p_callback` with each node of the group, in tree order. Unlike `get_nodes_in_group()` nothing is allocated,
+	// the group is only copied if it changes during the iteration. Nodes removed from the tree meanwhile are skipped.
+	template <typename F>
+	void for_each_node_in_group(const StringName &p_group, F p_callback) {
+		const Vector<Node *> nodes = _get_group_nodes(p_group);
+		if (nodes.is_empty()) {
+			return;
+		}
+
+		_lock_group_call();
+		Node *const *nodes_ptr = nodes.ptr();
+		for (int i = 0; i < nodes.size(); i++) {
+			if (nodes_removed_on_group_call.has(nodes_ptr[i])) {
+				continue;
+			}
+			p_callback(nodes_ptr[i]);
+		}
+		_unlock_group_call();
+	}
+
 	Node *get_first_node_in_group(const StringName &p_group);
 	bool has_group(const StringName &p_identifier) const;
 	int get_node_count_in_group(const StringName &p_group) const;
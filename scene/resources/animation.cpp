@@ -1189,7 +1189,7 @@ Error Animation::position_track_get_key(int p_track, int p_key, Vector3 *r_posit
 	return OK;
 }
 
-Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, KeyCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, ERR_INVALID_PARAMETER);
@@ -1206,7 +1206,7 @@ Error Animation::try_position_track_interpolate(int p_track, double p_time, Vect
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1269,7 +1269,7 @@ Error Animation::rotation_track_get_key(int p_track, int p_key, Quaternion *r_ro
 	return OK;
 }
 
-Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward) const {
+Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward, KeyCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, ERR_INVALID_PARAMETER);
@@ -1286,7 +1286,7 @@ Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quat
 
 	bool ok = false;
 
-	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward);
+	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1349,7 +1349,7 @@ Error Animation::scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) c
 	return OK;
 }
 
-Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, KeyCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, ERR_INVALID_PARAMETER);
@@ -1366,7 +1366,7 @@ Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -2456,6 +2456,39 @@ int Animation::_find(const Vector<K> &p_keys, double p_time, bool p_backward, bo
 	return middle;
 }
 
+template <typename K>
+int Animation::_find_from_cursor(const Vector<K> &p_keys, double p_time, bool p_backward, int &r_cursor) const {
+	int len = p_keys.size();
+	if (len == 0) {
+		return -2;
+	}
+
+	// Check whether the key found last time, or the one after it in the playback direction, is still
+	// the one _find() would return: an approximate match, or the closest key before the time (after it when backward).
+	const K *keys = p_keys.ptr();
+	for (int i = 0; i < 2; i++) {
+		int idx = r_cursor + (p_backward ? -i : i);
+		if (idx >= 0 && idx < len && Math::is_equal_approx(p_time, (double)keys[idx].time)) {
+			r_cursor = idx;
+			return idx;
+		}
+		if (!p_backward) {
+			if (idx >= -1 && idx < len && (idx < 0 || keys[idx].time < p_time) && (idx + 1 == len || (keys[idx + 1].time > p_time && !Math::is_equal_approx(p_time, (double)keys[idx + 1].time)))) {
+				r_cursor = idx;
+				return idx;
+			}
+		} else {
+			if (idx >= 0 && idx <= len && (idx == len || keys[idx].time > p_time) && (idx == 0 || (keys[idx - 1].time < p_time && !Math::is_equal_approx(p_time, (double)keys[idx - 1].time)))) {
+				r_cursor = idx;
+				return idx;
+			}
+		}
+	}
+
+	r_cursor = _find(p_keys, p_time, p_backward);
+	return r_cursor;
+}
+
 // Linear interpolation for anytype.
 
 Vector3 Animation::_interpolate(const Vector3 &p_a, const Vector3 &p_b, real_t p_c) const {
@@ -2525,8 +2558,8 @@ Variant Animation::_cubic_interpolate_angle_in_time(const Variant &p_pre_a, cons
 }
 
 template <typename T>
-T Animation::_interpolate(const Vector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward) const {
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+T Animation::_interpolate(const Vector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward, KeyCursor *r_cursor) const {
+	int len = (r_cursor ? _find_from_cursor(p_keys, length, false, r_cursor->last_key) : _find(p_keys, length)) + 1; // try to find last key (there may be more past the end)
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -2543,7 +2576,7 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, double p_time, Interpol
 		return p_keys[0].value;
 	}
 
-	int idx = _find(p_keys, p_time, p_backward);
+	int idx = r_cursor ? _find_from_cursor(p_keys, p_time, p_backward, r_cursor->key) : _find(p_keys, p_time, p_backward);
 
 	ERR_FAIL_COND_V(idx == -2, T());
 	int maxi = len - 1;
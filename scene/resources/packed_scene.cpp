@@ -165,6 +165,8 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	LocalVector<DeferredNodePathProperties> deferred_node_paths;
 
+	const InstantiatePlan *plan = (instantiate_plans_enabled && p_edit_state == GEN_EDIT_STATE_DISABLED) ? _get_instantiate_plan() : nullptr;
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
@@ -191,6 +193,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		Node *node = nullptr;
 		MissingNode *missing_node = nullptr;
 		bool is_inherited_scene = false;
+		const InstantiatePlan::Setter *setters = nullptr;
 
 		if (i == 0 && base_scene_idx >= 0) {
 			// Scene inheritance on root node.
@@ -261,6 +264,10 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 			node = Object::cast_to<Node>(obj);
 
+			if (node && plan && plan->node_setters[i] != UINT32_MAX) {
+				setters = &plan->setters[plan->node_setters[i]];
+			}
+
 			if (!node) {
 				if (obj) {
 					memdelete(obj);
@@ -313,6 +320,23 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 					ERR_FAIL_INDEX_V(nprops[j].value, prop_count, nullptr);
 
+					if (setters && setters[j].method && !node->get_script_instance()) {
+						// Same as what `Object::set()` ends up doing for a native property, without looking it up by name.
+						Callable::CallError ce;
+						if (setters[j].index >= 0) {
+							Variant index = setters[j].index;
+							const Variant *args[2] = { &index, &props[nprops[j].value] };
+							setters[j].method->call(node, args, 2, ce);
+						} else {
+							const Variant *args[1] = { &props[nprops[j].value] };
+							setters[j].method->call(node, args, 1, ce);
+						}
+#ifdef TOOLS_ENABLED
+						node->set_edited(true);
+#endif
+						continue;
+					}
+
 					if (nprops[j].name & FLAG_PATH_PROPERTY_IS_NODE) {
 						if (!Engine::get_singleton()->is_editor_hint() && node->get_scene_instance_load_placeholder()) {
 							// We cannot know if the referenced nodes exist yet, so instead of deferring, we write the NodePaths directly.
@@ -592,7 +616,9 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			callable = callable.unbind(c.unbinds);
 		} else if (!c.binds.is_empty()) {
 			Vector<Variant> binds;
-			if (c.binds.size()) {
+			if (plan) {
+				binds = plan->connection_binds[i];
+			} else if (c.binds.size()) {
 				binds.resize(c.binds.size());
 				for (int j = 0; j < c.binds.size(); j++) {
 					binds.write[j] = props[c.binds[j]];
@@ -681,6 +707,78 @@ Dictionary SceneState::setup_resources_in_dictionary(Dictionary &p_dictionary_to
 	return p_dictionary_to_scan;
 }
 
+const SceneState::InstantiatePlan *SceneState::_get_instantiate_plan() const {
+	InstantiatePlan *plan = instantiate_plan.load(std::memory_order_acquire);
+	if (likely(plan)) {
+		return plan;
+	}
+
+	plan = memnew(InstantiatePlan);
+	plan->node_setters.resize(nodes.size());
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		plan->node_setters[i] = UINT32_MAX;
+
+		// Only nodes created from a native class, the others are set up by their own scene or by scripts.
+		if ((i == 0 && base_scene_idx >= 0) || n.instance >= 0 || n.type == TYPE_INSTANTIATED || n.type < 0 || n.type >= names.size() || n.properties.is_empty()) {
+			continue;
+		}
+		const StringName &type = names[n.type];
+		if (!ClassDB::class_exists(type)) {
+			continue;
+		}
+		// Method binds of extensions may go away when they are reloaded.
+		ClassDB::APIType api = ClassDB::get_api_type(type);
+		if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+			continue;
+		}
+
+		plan->node_setters[i] = plan->setters.size();
+		for (const NodeData::Property &prop : n.properties) {
+			InstantiatePlan::Setter setter;
+			if (!(prop.name & FLAG_PATH_PROPERTY_IS_NODE) && prop.name >= 0 && prop.name < names.size() && prop.value >= 0 && prop.value < variants.size()) {
+				const StringName &name = names[prop.name];
+				Variant::Type value_type = variants[prop.value].get_type();
+				// Resources, arrays and dictionaries may need to be made local to the scene or retyped, so they're set by name.
+				if (name != CoreStringName(script) && value_type != Variant::OBJECT && value_type != Variant::ARRAY && value_type != Variant::DICTIONARY) {
+					StringName setter_name = ClassDB::get_property_setter(type, name);
+					if (setter_name != StringName()) {
+						setter.method = ClassDB::get_method(type, setter_name);
+						setter.index = ClassDB::get_property_index(type, name);
+					}
+				}
+			}
+			plan->setters.push_back(setter);
+		}
+	}
+
+	plan->connection_binds.resize(connections.size());
+	for (int i = 0; i < connections.size(); i++) {
+		const ConnectionData &c = connections[i];
+		Vector<Variant> &binds = plan->connection_binds[i];
+		binds.resize(c.binds.size());
+		for (int j = 0; j < c.binds.size(); j++) {
+			binds.write[j] = variants[c.binds[j]];
+		}
+	}
+
+	// Another thread may have built it at the same time, keep the first one.
+	InstantiatePlan *expected = nullptr;
+	if (!instantiate_plan.compare_exchange_strong(expected, plan, std::memory_order_acq_rel)) {
+		memdelete(plan);
+		return expected;
+	}
+	return plan;
+}
+
+void SceneState::_clear_instantiate_plan() {
+	InstantiatePlan *plan = instantiate_plan.exchange(nullptr, std::memory_order_acq_rel);
+	if (plan) {
+		memdelete(plan);
+	}
+}
+
 bool SceneState::has_local_resource(const Array &p_array) const {
 	for (int i = 0; i < p_array.size(); i++) {
 		Ref<Resource> res = p_array[i];
@@ -1302,6 +1400,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiate_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1451,6 +1550,12 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+bool SceneState::instantiate_plans_enabled = true;
+
+void SceneState::set_instantiate_plans_enabled(bool p_enabled) {
+	instantiate_plans_enabled = p_enabled;
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1493,6 +1598,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_clear_instantiate_plan();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -1961,11 +2068,13 @@ Ref<Resource> SceneState::get_sub_resource(const String &p_path) {
 //add
 
 int SceneState::add_name(const StringName &p_name) {
+	_clear_instantiate_plan();
 	names.push_back(p_name);
 	return names.size() - 1;
 }
 
 int SceneState::add_value(const Variant &p_value) {
+	_clear_instantiate_plan();
 	variants.push_back(p_value);
 	return variants.size() - 1;
 }
@@ -1976,6 +2085,7 @@ int SceneState::add_node_path(const NodePath &p_path) {
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_clear_instantiate_plan();
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -2001,6 +2111,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	}
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_clear_instantiate_plan();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -2012,6 +2123,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
 	base_scene_idx = p_idx;
+	_clear_instantiate_plan();
 }
 
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, int p_unbinds, const Vector<int> &p_binds) {
@@ -2030,6 +2142,7 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	c.unbinds = p_unbinds;
 	c.binds = p_binds;
 	connections.push_back(c);
+	_clear_instantiate_plan();
 }
 
 void SceneState::add_editable_instance(const NodePath &p_path) {
@@ -2119,6 +2232,10 @@ void SceneState::_bind_methods() {
 SceneState::SceneState() {
 }
 
+SceneState::~SceneState() {
+	_clear_instantiate_plan();
+}
+
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
@@ -89,6 +89,24 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// What can be resolved ahead of time from the data above, built on the first instantiation without edit state
+	// and reused by the following ones. Cleared whenever the data changes.
+	struct InstantiatePlan {
+		struct Setter {
+			MethodBind *method = nullptr; // Null when the property must be set by name.
+			int index = -1; // For indexed properties.
+		};
+
+		LocalVector<uint32_t> node_setters; // Offset in `setters` of the first property of each node, or `UINT32_MAX`.
+		LocalVector<Setter> setters;
+		LocalVector<Vector<Variant>> connection_binds;
+	};
+
+	mutable std::atomic<InstantiatePlan *> instantiate_plan = nullptr;
+
+	const InstantiatePlan *_get_instantiate_plan() const;
+	void _clear_instantiate_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -97,6 +115,7 @@ class SceneState : public RefCounted {
 	uint64_t last_modified_time = 0;
 
 	static bool disable_placeholders;
+	static bool instantiate_plans_enabled;
 
 	Vector<String> _get_node_groups(int p_idx) const;
 
@@ -136,6 +155,7 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_instantiate_plans_enabled(bool p_enabled);
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
@@ -225,6 +245,7 @@ public:
 #endif
 
 	SceneState();
+	~SceneState();
 };
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
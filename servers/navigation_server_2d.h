@@ -294,6 +294,8 @@ public:
 
 	/// Returns a customized navigation path using a query parameters object
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const = 0;
+	/// Returns customized navigation paths for a batch of query parameters objects
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) const = 0;
 
 	virtual void init() = 0;
 	virtual void sync() = 0;
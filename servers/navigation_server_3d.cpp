@@ -73,6 +73,7 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_random_point", "map", "navigation_layers", "uniformly"), &NavigationServer3D::map_get_random_point);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_paths", "parameters", "results"), &NavigationServer3D::query_paths);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer3D::region_set_enabled);
@@ -247,6 +248,10 @@ NavigationServer3D::NavigationServer3D() {
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_high_priority_threads", true);
 
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "navigation/pathfinding/hierarchical_pathfinding_cluster_size", PROPERTY_HINT_RANGE, "4,1024,1,or_greater"), 64);
+	GLOBAL_DEF("navigation/pathfinding/thread_model/path_queries_use_multiple_threads", true);
+	GLOBAL_DEF("navigation/pathfinding/use_hierarchical_pathfinding", false);
+
 	GLOBAL_DEF("navigation/baking/use_crash_prevention_checks", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_multiple_threads", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_high_priority_threads", true);
@@ -947,6 +952,39 @@ void NavigationServer3D::query_path(const Ref<NavigationPathQueryParameters3D> &
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+void NavigationServer3D::query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) const {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of query parameters and query results must match.");
+
+	const uint32_t query_count = p_query_parameters.size();
+
+	LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+	parameters.resize(query_count);
+	for (uint32_t i = 0; i < query_count; i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		ERR_FAIL_COND(!query_parameters.is_valid());
+		ERR_FAIL_COND(!Ref<NavigationPathQueryResult3D>(p_query_results[i]).is_valid());
+		parameters[i] = query_parameters->get_parameters();
+	}
+
+	LocalVector<NavigationUtilities::PathQueryResult> results;
+	results.resize(query_count);
+	_query_paths(parameters.ptr(), results.ptr(), query_count);
+
+	for (uint32_t i = 0; i < query_count; i++) {
+		Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		query_result->set_path(results[i].path);
+		query_result->set_path_types(results[i].path_types);
+		query_result->set_path_rids(results[i].path_rids);
+		query_result->set_path_owner_ids(results[i].path_owner_ids);
+	}
+}
+
+void NavigationServer3D::_query_paths(const NavigationUtilities::PathQueryParameters *p_parameters, NavigationUtilities::PathQueryResult *r_results, uint32_t p_count) const {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_results[i] = _query_path(p_parameters[i]);
+	}
+}
+
 ///////////////////////////////////////////////////////
 
 NavigationServer3DCallback NavigationServer3DManager::create_callback = nullptr;
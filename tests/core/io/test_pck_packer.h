@@ -32,6 +32,7 @@
 #define TEST_PCK_PACKER_H
 
 #include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 
@@ -117,6 +118,188 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+static Vector<uint8_t> _make_pack_data(uint64_t p_size, uint32_t p_seed) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	uint32_t x = p_seed;
+	for (uint64_t i = 0; i < p_size; i++) {
+		x = x * 1664525u + 1013904223u;
+		w[i] = x >> 24;
+	}
+	return data;
+}
+
+static String _write_pack_source(const String &p_name, const Vector<uint8_t> &p_data) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_buffer(p_data.ptr(), p_data.size());
+	return path;
+}
+
+TEST_CASE("[PCKPacker] Read the files of a pack with and without memory mapping") {
+	const uint64_t size = 256 * 1024 + 3;
+	const Vector<uint8_t> data = _make_pack_data(size, 1);
+	const String source_path = _write_pack_source("mapped_source.bin", data);
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_mapped.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://mapped_test/data.bin", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	bool own_packed_data = PackedData::get_singleton() == nullptr;
+	PackedData *packed_data = own_packed_data ? memnew(PackedData) : PackedData::get_singleton();
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+
+	for (int mapped = 0; mapped < 2; mapped++) {
+		packed_data->set_memory_mapping_enabled(mapped);
+
+		Ref<FileAccess> f = FileAccess::open("res://mapped_test/data.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == size);
+		CHECK(f->get_buffer(size) == data);
+		CHECK_FALSE(f->eof_reached());
+
+		f->seek(16);
+		CHECK(f->get_32() == decode_uint32(data.ptr() + 16));
+
+		const uint8_t *direct = f->get_mapped_buffer(8);
+#ifdef UNIX_ENABLED
+		if (mapped) {
+			REQUIRE(direct != nullptr);
+			CHECK(memcmp(direct, data.ptr() + 20, 8) == 0);
+			CHECK(f->get_position() == 28);
+
+			// Past the end of the file.
+			CHECK(f->get_mapped_buffer(size) == nullptr);
+			CHECK(f->get_position() == 28);
+		}
+#endif
+		if (!mapped) {
+			CHECK(direct == nullptr);
+			CHECK(f->get_position() == 20);
+		}
+
+		f->seek(size - 2);
+		uint8_t tail[4] = {};
+		CHECK(f->get_buffer(tail, 4) == 2);
+		CHECK(f->eof_reached());
+		CHECK(tail[1] == data[size - 1]);
+	}
+
+	if (own_packed_data) {
+		memdelete(packed_data);
+	} else {
+		packed_data->set_memory_mapping_enabled(true);
+		packed_data->remove_path("res://mapped_test/data.bin");
+	}
+}
+
+TEST_CASE("[PCKPacker] Read the files of a pack replaced at the same path") {
+	const Vector<uint8_t> first_data = _make_pack_data(4096, 2);
+	const Vector<uint8_t> second_data = _make_pack_data(8192 + 5, 3);
+	const String first_source_path = _write_pack_source("replaced_first.bin", first_data);
+	const String second_source_path = _write_pack_source("replaced_second.bin", second_data);
+	const String output_pck_path = TestUtils::get_temp_path("output_replaced.pck");
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://replaced_test/data.bin", first_source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	bool own_packed_data = PackedData::get_singleton() == nullptr;
+	PackedData *packed_data = own_packed_data ? memnew(PackedData) : PackedData::get_singleton();
+	packed_data->set_memory_mapping_enabled(true);
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+
+	Ref<FileAccess> f = FileAccess::open("res://replaced_test/data.bin", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_buffer(first_data.size()) == first_data);
+	f.unref();
+
+	// Another file first, so the data is at a different offset in the new pack.
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://replaced_test/other.bin", first_source_path) == OK);
+	REQUIRE(pck_packer.add_file("res://replaced_test/data.bin", second_source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+
+	f = FileAccess::open("res://replaced_test/data.bin", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == uint64_t(second_data.size()));
+	CHECK_MESSAGE(f->get_buffer(second_data.size()) == second_data, "The new pack should be read, not the mapping of the old one.");
+	f.unref();
+
+	if (own_packed_data) {
+		memdelete(packed_data);
+	} else {
+		packed_data->remove_path("res://replaced_test/data.bin");
+		packed_data->remove_path("res://replaced_test/other.bin");
+	}
+}
+
+TEST_CASE("[PCKPacker][Benchmark] Pack read throughput" * doctest::skip()) {
+	const int file_count = 8;
+	const uint64_t file_size = 2 * 1024 * 1024;
+	const int small_reads = 64 * 1024;
+
+	const String source_path = _write_pack_source("benchmark_source.bin", _make_pack_data(file_size, 2));
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_benchmark.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	for (int i = 0; i < file_count; i++) {
+		REQUIRE(pck_packer.add_file(vformat("res://benchmark_test/%d.bin", i), source_path) == OK);
+	}
+	REQUIRE(pck_packer.flush() == OK);
+
+	bool own_packed_data = PackedData::get_singleton() == nullptr;
+	PackedData *packed_data = own_packed_data ? memnew(PackedData) : PackedData::get_singleton();
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+
+	Vector<uint8_t> buffer;
+	buffer.resize(file_size);
+	uint64_t bulk_usec[2] = {};
+	uint64_t small_usec[2] = {};
+	uint32_t checksum[2] = {};
+
+	for (int mapped = 0; mapped < 2; mapped++) {
+		packed_data->set_memory_mapping_enabled(mapped);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open(vformat("res://benchmark_test/%d.bin", i), FileAccess::READ);
+			f->get_buffer(buffer.ptrw(), file_size);
+		}
+		bulk_usec[mapped] = OS::get_singleton()->get_ticks_usec() - begin;
+
+		// Many small reads, like the binary resource loader does for headers and properties.
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open(vformat("res://benchmark_test/%d.bin", i), FileAccess::READ);
+			for (int j = 0; j < small_reads; j++) {
+				checksum[mapped] += f->get_32();
+			}
+		}
+		small_usec[mapped] = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+	CHECK(checksum[0] == checksum[1]);
+
+	const double megabytes = double(file_count * file_size) / (1024.0 * 1024.0);
+	MESSAGE("Reading ", megabytes, " MiB from a pack: ", bulk_usec[0], " usec through a file handle, ", bulk_usec[1], " usec from the memory mapping.");
+	MESSAGE(file_count * small_reads, " 32-bit reads from a pack: ", small_usec[0], " usec through a file handle, ", small_usec[1], " usec from the memory mapping.");
+
+	if (own_packed_data) {
+		memdelete(packed_data);
+	} else {
+		packed_data->set_memory_mapping_enabled(true);
+		for (int i = 0; i < file_count; i++) {
+			packed_data->remove_path(vformat("res://benchmark_test/%d.bin", i));
+		}
+	}
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
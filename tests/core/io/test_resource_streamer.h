@@ -0,0 +1,171 @@
+/**************************************************************************/
+/*  test_resource_streamer.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RESOURCE_STREAMER_H
+#define TEST_RESOURCE_STREAMER_H
+
+#include "core/io/file_access.h"
+#include "core/io/resource_saver.h"
+#include "core/io/resource_streamer.h"
+#include "core/os/os.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+#include "tests/test_macros.h"
+
+namespace TestResourceStreamer {
+
+static String _save_resource(const String &p_name) {
+	Ref<Resource> resource;
+	resource.instantiate();
+	resource->set_name(p_name);
+	const String path = TestUtils::get_temp_path("streamer_" + p_name + ".res");
+	ResourceSaver::save(resource, path);
+	return path;
+}
+
+static bool _poll_until(const Ref<ResourceStreamer> &p_streamer, const String &p_path, ResourceStreamer::Status p_status) {
+	for (int i = 0; i < 5000; i++) {
+		p_streamer->poll();
+		if (p_streamer->get_status(p_path) == p_status) {
+			return true;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+TEST_CASE("[ResourceStreamer] Priority and cancellation") {
+	const String path_a = _save_resource("a");
+	const String path_b = _save_resource("b");
+	const String path_c = _save_resource("c");
+
+	Ref<ResourceStreamer> streamer;
+	streamer.instantiate();
+	streamer->set_max_concurrent_loads(1);
+
+	SUBCASE("Higher priorities are loaded first, then in request order") {
+		streamer->request(path_a);
+		streamer->request(path_b, "", 5);
+		streamer->request(path_c);
+		CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_QUEUED);
+
+		streamer->poll();
+		CHECK(streamer->get_status(path_b) == ResourceStreamer::STATUS_LOADING);
+		CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_QUEUED);
+		CHECK(streamer->get_status(path_c) == ResourceStreamer::STATUS_QUEUED);
+
+		REQUIRE(_poll_until(streamer, path_b, ResourceStreamer::STATUS_LOADED));
+		CHECK(streamer->get_resource(path_b)->get_name() == "b");
+		CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_LOADING);
+		CHECK(streamer->get_status(path_c) == ResourceStreamer::STATUS_QUEUED);
+
+		// Boosting a queued request.
+		streamer->request(path_c, "", 10);
+		REQUIRE(_poll_until(streamer, path_c, ResourceStreamer::STATUS_LOADED));
+
+		Dictionary metrics = streamer->get_metrics();
+		CHECK(int(metrics["requested"]) == 3);
+		CHECK(int(metrics["loaded"]) == 3);
+		CHECK(int(metrics["resident"]) == 3);
+		CHECK(int(metrics["queued"]) == 0);
+	}
+
+	SUBCASE("Canceled requests are not kept") {
+		streamer->request(path_a);
+		streamer->request(path_b);
+		streamer->poll();
+		CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_LOADING);
+
+		// One in flight, one still queued.
+		CHECK(streamer->cancel(path_a));
+		CHECK(streamer->cancel(path_b));
+		CHECK_FALSE(streamer->cancel(path_b));
+		CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_NONE);
+		CHECK(streamer->get_status(path_b) == ResourceStreamer::STATUS_NONE);
+
+		streamer->request(path_c);
+		REQUIRE(_poll_until(streamer, path_c, ResourceStreamer::STATUS_LOADED));
+		CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_NONE);
+		CHECK(streamer->get_resource(path_a).is_null());
+
+		Dictionary metrics = streamer->get_metrics();
+		CHECK(int(metrics["canceled"]) == 2);
+		CHECK(int(metrics["loaded"]) == 1);
+	}
+}
+
+TEST_CASE("[ResourceStreamer] Memory budget") {
+	const String path_a = _save_resource("a");
+	const String path_b = _save_resource("b");
+	const String path_c = _save_resource("c");
+	const int64_t size_a = FileAccess::open(path_a, FileAccess::READ)->get_length();
+	const int64_t size_b = FileAccess::open(path_b, FileAccess::READ)->get_length();
+
+	Ref<ResourceStreamer> streamer;
+	streamer.instantiate();
+	streamer->set_max_concurrent_loads(3);
+	streamer->set_group_budget("chunks", size_a + size_b);
+
+	streamer->request(path_a, "", 0, "chunks");
+	streamer->request(path_b, "", 0, "chunks");
+	REQUIRE(_poll_until(streamer, path_a, ResourceStreamer::STATUS_LOADED));
+	REQUIRE(_poll_until(streamer, path_b, ResourceStreamer::STATUS_LOADED));
+	CHECK(streamer->get_group_usage("chunks") == size_a + size_b);
+
+	// Resources of other groups don't count.
+	streamer->request(path_c);
+	REQUIRE(_poll_until(streamer, path_c, ResourceStreamer::STATUS_LOADED));
+	CHECK(streamer->get_group_usage("chunks") == size_a + size_b);
+
+	// Shrinking the budget evicts the least recently used resource.
+	streamer->get_resource(path_a);
+	streamer->set_group_budget("chunks", size_a);
+	streamer->poll();
+	CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_LOADED);
+	CHECK(streamer->get_status(path_b) == ResourceStreamer::STATUS_NONE);
+	CHECK(streamer->get_status(path_c) == ResourceStreamer::STATUS_LOADED);
+	CHECK(streamer->get_group_usage("chunks") == size_a);
+	CHECK(int(streamer->get_metrics()["evicted"]) == 1);
+
+	// The most recently used resource is kept even if it's over the budget.
+	streamer->set_group_budget("chunks", 1);
+	streamer->poll();
+	CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_LOADED);
+
+	streamer->clear();
+	CHECK(streamer->get_status(path_a) == ResourceStreamer::STATUS_NONE);
+	CHECK(streamer->get_group_usage("chunks") == 0);
+	CHECK(streamer->get_group_budget("chunks") == 1);
+}
+
+} // namespace TestResourceStreamer
+
+#endif // TEST_RESOURCE_STREAMER_H
@@ -34,6 +34,7 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -69,6 +70,27 @@ public:
 
 namespace TestObject {
 
+class _SignalReceiver : public Object {
+public:
+	Object *source = nullptr;
+	_SignalReceiver *partner = nullptr;
+	int calls = 0;
+
+	void count() {
+		calls++;
+	}
+
+	void connect_partner() {
+		calls++;
+		source->connect("my_custom_signal", callable_mp(partner, &_SignalReceiver::count));
+	}
+
+	void disconnect_partner() {
+		calls++;
+		source->disconnect("my_custom_signal", callable_mp(partner, &_SignalReceiver::count));
+	}
+};
+
 class _MockScriptInstance : public ScriptInstance {
 	StringName property_name = "NO_NAME";
 	Variant property_value;
@@ -464,6 +486,128 @@ TEST_CASE("[Object] Signals") {
 		object.get_all_signal_connections(&signal_connections);
 		CHECK(signal_connections.size() == 0);
 	}
+
+	SUBCASE("Disconnecting during emission should not affect the current emission") {
+		_SignalReceiver first;
+		_SignalReceiver second;
+		first.source = &object;
+		first.partner = &second;
+
+		object.connect("my_custom_signal", callable_mp(&first, &_SignalReceiver::disconnect_partner));
+		object.connect("my_custom_signal", callable_mp(&second, &_SignalReceiver::count));
+
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 1);
+
+		object.disconnect("my_custom_signal", callable_mp(&first, &_SignalReceiver::disconnect_partner));
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 1);
+	}
+
+	SUBCASE("Connecting during emission should only take effect on the next emission") {
+		_SignalReceiver first;
+		_SignalReceiver second;
+		first.source = &object;
+		first.partner = &second;
+
+		object.connect("my_custom_signal", callable_mp(&first, &_SignalReceiver::connect_partner), Object::CONNECT_ONE_SHOT);
+
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 0);
+
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 1);
+	}
+
+	SUBCASE("Emitting through a signal handle should follow the connections") {
+		_SignalReceiver receiver;
+		Object::SignalHandle handle = object.get_signal_handle("my_custom_signal");
+		CHECK_FALSE(handle.is_null());
+		CHECK(handle.get_name() == StringName("my_custom_signal"));
+
+		CHECK(object.emit_signal(handle) == OK);
+		CHECK(receiver.calls == 0);
+
+		object.connect("my_custom_signal", callable_mp(&receiver, &_SignalReceiver::count));
+		CHECK(object.emit_signal(handle) == OK);
+		CHECK(receiver.calls == 1);
+
+		object.disconnect("my_custom_signal", callable_mp(&receiver, &_SignalReceiver::count));
+		CHECK(object.emit_signal(handle) == OK);
+		CHECK(receiver.calls == 1);
+
+		object.set_block_signals(true);
+		CHECK(object.emit_signal(handle) == ERR_CANT_ACQUIRE_RESOURCE);
+		object.set_block_signals(false);
+
+		Object other;
+		ERR_PRINT_OFF;
+		CHECK(other.emit_signal(handle) == ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Signal handles should be resolved again when the signal is added or removed") {
+		_SignalReceiver receiver;
+		Object::SignalHandle handle = object.get_signal_handle("script_changed");
+		CHECK(object.emit_signal(handle) == ERR_UNAVAILABLE);
+
+		object.connect("script_changed", callable_mp(&receiver, &_SignalReceiver::count));
+		CHECK(object.emit_signal(handle) == OK);
+		CHECK(receiver.calls == 1);
+
+		// Disconnecting the last connection of a built-in signal removes it from the object.
+		object.disconnect("script_changed", callable_mp(&receiver, &_SignalReceiver::count));
+		CHECK(object.emit_signal(handle) == ERR_UNAVAILABLE);
+
+		object.connect("script_changed", callable_mp(&receiver, &_SignalReceiver::count));
+		CHECK(object.emit_signal(handle) == OK);
+		CHECK(receiver.calls == 2);
+		object.disconnect("script_changed", callable_mp(&receiver, &_SignalReceiver::count));
+	}
+
+#ifdef DEBUG_ENABLED
+	SUBCASE("Signal handles can't be obtained for non-existing signals") {
+		ERR_PRINT_OFF;
+		Object::SignalHandle handle = object.get_signal_handle("non_existing_signal");
+		ERR_PRINT_ON;
+		CHECK(handle.is_null());
+	}
+#endif
+}
+
+TEST_CASE("[Object][Benchmark] Signal emission" * doctest::skip()) {
+	const int connection_count = 8;
+	const int emission_count = 20000;
+
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal"));
+	_SignalReceiver receivers[connection_count];
+	for (_SignalReceiver &receiver : receivers) {
+		object.connect("my_custom_signal", callable_mp(&receiver, &_SignalReceiver::count));
+	}
+
+	const StringName name = "my_custom_signal";
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emission_count; i++) {
+		object.emit_signal(name);
+	}
+	const uint64_t by_name_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Object::SignalHandle handle = object.get_signal_handle(name);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emission_count; i++) {
+		object.emit_signal(handle);
+	}
+	const uint64_t by_handle_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	for (const _SignalReceiver &receiver : receivers) {
+		CHECK(receiver.calls == emission_count * 2);
+	}
+	MESSAGE(emission_count, " emissions to ", connection_count, " connections: ", by_name_usec, " usec by name, ", by_handle_usec, " usec through a handle.");
 }
 
 class NotificationObject1 : public Object {
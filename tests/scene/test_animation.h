@@ -136,6 +136,42 @@ TEST_CASE("[Animation] Create 3D position track") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Animation] Interpolate 3D position track with a key cursor") {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(1.0);
+	animation->set_loop_mode(Animation::LOOP_LINEAR);
+	const int track_index = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track_index, NodePath("Enemy:position"));
+	for (int i = 0; i < 8; i++) {
+		animation->position_track_insert_key(track_index, i * 0.125, Vector3(i, i * i, -i));
+	}
+
+	// The cursor must never change the result, whichever way the time moves.
+	Animation::KeyCursor cursor;
+	const double steps[] = { 0.03, 0.2, -0.05, 0.7, -0.4 };
+	double time = 0.0;
+	for (double step : steps) {
+		for (int i = 0; i < 40; i++) {
+			time = Math::fposmod(time + step, 1.0);
+			const bool backward = step < 0;
+			Vector3 expected;
+			Vector3 interpolation;
+			CHECK(animation->try_position_track_interpolate(track_index, time, &expected, backward) == OK);
+			CHECK(animation->try_position_track_interpolate(track_index, time, &interpolation, backward, &cursor) == OK);
+			CHECK(interpolation.is_equal_approx(expected));
+		}
+	}
+
+	// Keys at the cursor position may be removed.
+	animation->track_remove_key(track_index, 7);
+	animation->track_remove_key(track_index, 6);
+	Vector3 expected;
+	Vector3 interpolation;
+	CHECK(animation->try_position_track_interpolate(track_index, 0.9, &expected) == OK);
+	CHECK(animation->try_position_track_interpolate(track_index, 0.9, &interpolation, false, &cursor) == OK);
+	CHECK(interpolation.is_equal_approx(expected));
+}
+
 TEST_CASE("[Animation] Create 3D rotation track") {
 	Ref<Animation> animation = memnew(Animation);
 	const int track_index = animation->add_track(Animation::TYPE_ROTATION_3D);
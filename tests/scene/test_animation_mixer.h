@@ -0,0 +1,346 @@
+/**************************************************************************/
+/*  test_animation_mixer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ANIMATION_MIXER_H
+#define TEST_ANIMATION_MIXER_H
+
+#include "core/os/os.h"
+#include "scene/3d/camera_3d.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
+#include "scene/resources/animation_library.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationMixer {
+
+// A looping animation rotating all the bones of the skeleton, and moving and scaling some of them.
+static Ref<Animation> _make_bone_animation(int p_bones, real_t p_amount) {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	animation->set_loop_mode(Animation::LOOP_LINEAR);
+	for (int i = 0; i < p_bones; i++) {
+		NodePath path = NodePath(vformat("Skeleton:bone_%d", i));
+
+		int track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(track, path);
+		Vector3 axis = Vector3(i % 3 == 0, i % 3 == 1, i % 3 == 2);
+		animation->rotation_track_insert_key(track, 0.0, Quaternion());
+		animation->rotation_track_insert_key(track, 0.5, Quaternion(axis, p_amount + i * 0.01));
+		animation->rotation_track_insert_key(track, 1.0, Quaternion());
+
+		if (i % 4 == 0) {
+			track = animation->add_track(Animation::TYPE_POSITION_3D);
+			animation->track_set_path(track, path);
+			animation->position_track_insert_key(track, 0.0, Vector3());
+			animation->position_track_insert_key(track, 0.3, Vector3(0, p_amount, 0));
+			animation->position_track_insert_key(track, 1.0, Vector3());
+		}
+		if (i % 5 == 0) {
+			track = animation->add_track(Animation::TYPE_SCALE_3D);
+			animation->track_set_path(track, path);
+			animation->scale_track_insert_key(track, 0.0, Vector3(1, 1, 1));
+			animation->scale_track_insert_key(track, 0.6, Vector3(1, 1, 1) * (1.0 + p_amount));
+			animation->scale_track_insert_key(track, 1.0, Vector3(1, 1, 1));
+		}
+	}
+	return animation;
+}
+
+// A character with a skeleton of `p_bones` bones, and "walk" and "run" animations moving them.
+static Node3D *_make_character(int p_bones, bool p_parallel, bool p_method_track = false) {
+	Node3D *root = memnew(Node3D);
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton");
+	root->add_child(skeleton);
+	for (int i = 0; i < p_bones; i++) {
+		skeleton->add_bone(vformat("bone_%d", i));
+		if (i > 0) {
+			skeleton->set_bone_parent(i, i - 1);
+		}
+	}
+
+	Ref<Animation> walk = _make_bone_animation(p_bones, 1.0);
+	if (p_method_track) {
+		int track = walk->add_track(Animation::TYPE_METHOD);
+		walk->track_set_path(track, NodePath("."));
+		Dictionary key;
+		key["method"] = "set_meta";
+		Array args;
+		args.push_back("method_called");
+		args.push_back(true);
+		key["args"] = args;
+		walk->track_insert_key(track, 0.05, key);
+	}
+
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("walk", walk);
+	library->add_animation("run", _make_bone_animation(p_bones, 0.5));
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->set_name("AnimationPlayer");
+	player->set_callback_mode_method(AnimationMixer::ANIMATION_CALLBACK_MODE_METHOD_IMMEDIATE);
+	player->set_parallel_processing_enabled(p_parallel);
+	player->add_animation_library("", library);
+	root->add_child(player);
+	return root;
+}
+
+static bool _bones_match(Node3D *p_a, Node3D *p_b) {
+	Skeleton3D *a = Object::cast_to<Skeleton3D>(p_a->get_node(NodePath("Skeleton")));
+	Skeleton3D *b = Object::cast_to<Skeleton3D>(p_b->get_node(NodePath("Skeleton")));
+	for (int i = 0; i < a->get_bone_count(); i++) {
+		if (!a->get_bone_pose_rotation(i).is_equal_approx(b->get_bone_pose_rotation(i)) ||
+				!a->get_bone_pose_position(i).is_equal_approx(b->get_bone_pose_position(i)) ||
+				!a->get_bone_pose_scale(i).is_equal_approx(b->get_bone_pose_scale(i))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Parallel processing matches serial processing") {
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	Node3D *reference = _make_character(8, false);
+	root->add_child(reference);
+	LocalVector<Node3D *> crowd;
+	for (int i = 0; i < 4; i++) {
+		Node3D *character = _make_character(8, true);
+		root->add_child(character);
+		crowd.push_back(character);
+	}
+
+	Object::cast_to<AnimationPlayer>(reference->get_node(NodePath("AnimationPlayer")))->play("walk");
+	for (Node3D *character : crowd) {
+		Object::cast_to<AnimationPlayer>(character->get_node(NodePath("AnimationPlayer")))->play("walk");
+	}
+
+	SUBCASE("Bone poses are the same after every frame") {
+		for (int frame = 0; frame < 10; frame++) {
+			SceneTree::get_singleton()->process(0.07);
+			for (Node3D *character : crowd) {
+				CHECK(_bones_match(reference, character));
+			}
+		}
+		Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(crowd[0]->get_node(NodePath("Skeleton")));
+		CHECK_FALSE(skeleton->get_bone_pose_rotation(0).is_equal_approx(Quaternion()));
+	}
+
+	SUBCASE("Disabling parallel processing keeps the mixer animated") {
+		AnimationPlayer *player = Object::cast_to<AnimationPlayer>(crowd[0]->get_node(NodePath("AnimationPlayer")));
+		SceneTree::get_singleton()->process(0.07);
+		player->set_parallel_processing_enabled(false);
+		for (int frame = 0; frame < 3; frame++) {
+			SceneTree::get_singleton()->process(0.07);
+			CHECK(_bones_match(reference, crowd[0]));
+			CHECK(_bones_match(reference, crowd[1]));
+		}
+	}
+
+	for (Node3D *character : crowd) {
+		memdelete(character);
+	}
+	memdelete(reference);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Parallel processing runs method tracks on the main thread") {
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	Node3D *reference = _make_character(4, false, true);
+	Node3D *character = _make_character(4, true, true);
+	Node3D *other = _make_character(4, true);
+	root->add_child(reference);
+	root->add_child(character);
+	root->add_child(other);
+	Object::cast_to<AnimationPlayer>(reference->get_node(NodePath("AnimationPlayer")))->play("walk");
+	Object::cast_to<AnimationPlayer>(character->get_node(NodePath("AnimationPlayer")))->play("walk");
+	Object::cast_to<AnimationPlayer>(other->get_node(NodePath("AnimationPlayer")))->play("walk");
+
+	for (int frame = 0; frame < 4; frame++) {
+		SceneTree::get_singleton()->process(0.04);
+		CHECK(_bones_match(reference, character));
+		CHECK(_bones_match(reference, other));
+	}
+	CHECK(character->has_meta("method_called"));
+	CHECK(reference->has_meta("method_called"));
+
+	memdelete(other);
+	memdelete(character);
+	memdelete(reference);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Skeleton animations blend like any other animation") {
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	// The method track keeps the "walk" animation of the reference out of the skeleton blending path.
+	Node3D *reference = _make_character(10, false, true);
+	Node3D *character = _make_character(10, false);
+	root->add_child(reference);
+	root->add_child(character);
+	AnimationPlayer *reference_player = Object::cast_to<AnimationPlayer>(reference->get_node(NodePath("AnimationPlayer")));
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_node(NodePath("AnimationPlayer")));
+	reference_player->play("walk");
+	player->play("walk");
+
+	for (int frame = 0; frame < 30; frame++) {
+		if (frame == 10) {
+			// Cross-fade, so both animations are blended.
+			reference_player->play("run", 0.5);
+			player->play("run", 0.5);
+		} else if (frame == 20) {
+			reference_player->set_speed_scale(-1.0);
+			player->set_speed_scale(-1.0);
+		}
+		SceneTree::get_singleton()->process(0.07);
+		CHECK(_bones_match(reference, character));
+	}
+
+	memdelete(character);
+	memdelete(reference);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Level of detail lowers the update rate of far away characters") {
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	Node3D *reference = _make_character(6, false);
+	Node3D *character = _make_character(6, false);
+	root->add_child(reference);
+	root->add_child(character);
+	character->set_position(Vector3(0, 0, -50));
+	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_node(NodePath("AnimationPlayer")));
+	Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(character->get_node(NodePath("Skeleton")));
+	PackedFloat32Array distances;
+	distances.push_back(10);
+	distances.push_back(100);
+	player->set_lod_distances(distances);
+	Object::cast_to<AnimationPlayer>(reference->get_node(NodePath("AnimationPlayer")))->play("walk");
+	player->play("walk");
+	SceneTree::get_singleton()->process(0.05); // The first frame after playing doesn't advance.
+
+	SUBCASE("Without a camera, the animation is processed every frame") {
+		CHECK(player->get_lod_update_interval() == 1);
+		for (int frame = 0; frame < 4; frame++) {
+			SceneTree::get_singleton()->process(0.05);
+			CHECK(_bones_match(reference, character));
+		}
+	}
+
+	SUBCASE("Skipped frames are caught up on the next update") {
+		Camera3D *camera = memnew(Camera3D);
+		root->add_child(camera);
+		camera->make_current();
+		CHECK(player->get_lod_update_interval() == 2);
+
+		int updates = 0;
+		Quaternion previous = skeleton->get_bone_pose_rotation(1);
+		for (int frame = 0; frame < 8; frame++) {
+			SceneTree::get_singleton()->process(0.05);
+			if (!skeleton->get_bone_pose_rotation(1).is_equal_approx(previous)) {
+				updates++;
+				CHECK(_bones_match(reference, character));
+			}
+			previous = skeleton->get_bone_pose_rotation(1);
+		}
+		CHECK(updates == 4);
+
+		character->set_position(Vector3(0, 0, -5));
+		CHECK(player->get_lod_update_interval() == 1);
+		SceneTree::get_singleton()->process(0.05);
+		SceneTree::get_singleton()->process(0.05);
+		CHECK(_bones_match(reference, character));
+
+		memdelete(camera);
+	}
+
+	SUBCASE("Off-screen animations can be paused") {
+		// Nothing is rendered in the tests, so the notifier is never on screen.
+		VisibleOnScreenNotifier3D *notifier = memnew(VisibleOnScreenNotifier3D);
+		notifier->set_name("Notifier");
+		character->add_child(notifier);
+		player->set_lod_visibility_notifier(NodePath("../Notifier"));
+		player->set_lod_offscreen_update_interval(0);
+		CHECK(player->get_lod_update_interval() == 0);
+
+		Quaternion paused = skeleton->get_bone_pose_rotation(1);
+		for (int frame = 0; frame < 3; frame++) {
+			SceneTree::get_singleton()->process(0.05);
+			CHECK(skeleton->get_bone_pose_rotation(1).is_equal_approx(paused));
+		}
+
+		player->set_lod_visibility_notifier(NodePath());
+		SceneTree::get_singleton()->process(0.05);
+		CHECK(_bones_match(reference, character));
+	}
+
+	memdelete(character);
+	memdelete(reference);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer][Benchmark] Animate a crowd of characters" * doctest::skip()) {
+	const int character_count = 300;
+	const int bone_count = 40;
+	const int frame_count = 30;
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	for (int pass = 0; pass < 2; pass++) {
+		const bool parallel = pass == 1;
+		LocalVector<Node3D *> crowd;
+		for (int i = 0; i < character_count; i++) {
+			Node3D *character = _make_character(bone_count, parallel);
+			root->add_child(character);
+			AnimationPlayer *player = Object::cast_to<AnimationPlayer>(character->get_node(NodePath("AnimationPlayer")));
+			player->play("walk");
+			player->seek(i * 0.003);
+			crowd.push_back(character);
+		}
+		SceneTree::get_singleton()->process(0.016); // Build the caches.
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < frame_count; frame++) {
+			SceneTree::get_singleton()->process(0.016);
+		}
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%s: %d characters with %d bones, %.3f ms per frame.", parallel ? "Parallel" : "Serial", character_count, bone_count, elapsed / 1000.0 / frame_count));
+
+		for (Node3D *character : crowd) {
+			memdelete(character);
+		}
+	}
+}
+
+} // namespace TestAnimationMixer
+
+#endif // TEST_ANIMATION_MIXER_H
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  test_cpu_particles_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CPU_PARTICLES_3D_H
+#define TEST_CPU_PARTICLES_3D_H
+
+#include "tests/test_macros.h"
+
+#include "core/os/os.h"
+#include "scene/3d/cpu_particles_3d.h"
+#include "scene/main/window.h"
+
+namespace TestCPUParticles3D {
+
+static CPUParticles3D *_make_particles(int p_amount, uint32_t p_seed) {
+	CPUParticles3D *particles = memnew(CPUParticles3D);
+	particles->set_amount(p_amount);
+	particles->set_use_fixed_seed(true);
+	particles->set_seed(p_seed);
+	particles->set_emission_shape(CPUParticles3D::EMISSION_SHAPE_SPHERE);
+	particles->set_emission_sphere_radius(2.0);
+	particles->set_spread(180.0);
+	particles->set_param_min(CPUParticles3D::PARAM_INITIAL_LINEAR_VELOCITY, 1.0);
+	particles->set_param_max(CPUParticles3D::PARAM_INITIAL_LINEAR_VELOCITY, 4.0);
+	particles->set_param_min(CPUParticles3D::PARAM_ANGULAR_VELOCITY, -90.0);
+	particles->set_param_max(CPUParticles3D::PARAM_ANGULAR_VELOCITY, 90.0);
+	particles->set_param_min(CPUParticles3D::PARAM_SCALE, 0.5);
+	return particles;
+}
+
+static Vector<float> _get_instance_buffer(CPUParticles3D *p_particles) {
+	// The instance data is handed to the multimesh right before drawing.
+	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
+	return RS::get_singleton()->multimesh_get_buffer(p_particles->get_base());
+}
+
+TEST_CASE("[SceneTree][CPUParticles3D] Fixed seed") {
+	SUBCASE("[CPUParticles3D] Seed properties") {
+		CPUParticles3D *particles = memnew(CPUParticles3D);
+		CHECK_FALSE(particles->get_use_fixed_seed());
+		CHECK(particles->get_seed() == 0);
+
+		particles->set_use_fixed_seed(true);
+		particles->set_seed(123456789);
+		CHECK(particles->get_use_fixed_seed());
+		CHECK(particles->get_seed() == 123456789);
+		memdelete(particles);
+	}
+
+	// Enough particles to be processed in several chunks.
+	const int amount = 3000;
+	CPUParticles3D *first = _make_particles(amount, 42);
+	CPUParticles3D *second = _make_particles(amount, 42);
+	CPUParticles3D *other = _make_particles(amount, 7);
+	SceneTree::get_singleton()->get_root()->add_child(first);
+	SceneTree::get_singleton()->get_root()->add_child(second);
+	SceneTree::get_singleton()->get_root()->add_child(other);
+
+	for (int i = 0; i < 10; i++) {
+		SceneTree::get_singleton()->process(0.016);
+	}
+
+	Vector<float> first_buffer = _get_instance_buffer(first);
+	Vector<float> second_buffer = _get_instance_buffer(second);
+	Vector<float> other_buffer = _get_instance_buffer(other);
+
+	REQUIRE(first_buffer.size() == amount * 20);
+	CHECK_MESSAGE(first_buffer == second_buffer, "Particles with the same seed should be simulated identically.");
+	CHECK_MESSAGE(first_buffer != other_buffer, "Particles with different seeds should be simulated differently.");
+
+	memdelete(first);
+	memdelete(second);
+	memdelete(other);
+}
+
+TEST_CASE("[SceneTree][CPUParticles3D][Benchmark] Process many particles" * doctest::skip()) {
+	const int amount = 20000;
+	const int frame_count = 60;
+	CPUParticles3D *particles = _make_particles(amount, 0);
+	SceneTree::get_singleton()->get_root()->add_child(particles);
+	SceneTree::get_singleton()->process(0.016);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		SceneTree::get_singleton()->process(0.016);
+	}
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("%d particles, %.3f ms per frame.", amount, elapsed / 1000.0 / frame_count));
+
+	memdelete(particles);
+}
+
+} // namespace TestCPUParticles3D
+
+#endif // TEST_CPU_PARTICLES_3D_H
@@ -32,6 +32,7 @@
 #define TEST_NODE_H
 
 #include "core/object/class_db.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 #include "scene/resources/packed_scene.h"
 
@@ -892,6 +893,133 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Groups") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *main_thread_parent = memnew(Node);
+	Node *sub_thread_parent = memnew(Node);
+	tree->get_root()->add_child(main_thread_parent);
+	tree->get_root()->add_child(sub_thread_parent);
+	sub_thread_parent->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+
+	const int node_count = 64;
+	Vector<Node *> nodes;
+	for (int i = 0; i < node_count; i++) {
+		Node *node = memnew(Node);
+		(i % 2 ? sub_thread_parent : main_thread_parent)->add_child(node);
+		node->add_to_group("enemies");
+		nodes.push_back(node);
+	}
+
+	SUBCASE("Removing nodes from the middle of a group should keep the others in tree order") {
+		for (int i = 0; i < node_count; i += 3) {
+			nodes[i]->remove_from_group("enemies");
+		}
+		CHECK(tree->get_node_count_in_group("enemies") == node_count - (node_count + 2) / 3);
+
+		List<Node *> group_nodes;
+		tree->get_nodes_in_group("enemies", &group_nodes);
+		CHECK(group_nodes.size() == tree->get_node_count_in_group("enemies"));
+
+		Vector<Node *> iterated;
+		tree->for_each_node_in_group("enemies", [&iterated](Node *p_node) {
+			iterated.push_back(p_node);
+		});
+		CHECK(iterated.size() == group_nodes.size());
+
+		int i = 0;
+		for (Node *node : group_nodes) {
+			CHECK_FALSE(node->get_index() == -1);
+			CHECK(node->is_in_group("enemies"));
+			CHECK(iterated[i] == node);
+			if (i > 0) {
+				CHECK(iterated[i - 1]->is_greater_than(node) == false);
+			}
+			i++;
+		}
+
+		nodes[1]->add_to_group("enemies");
+		CHECK(tree->get_node_count_in_group("enemies") == node_count - (node_count + 2) / 3);
+		nodes[0]->add_to_group("enemies");
+		CHECK(tree->get_first_node_in_group("enemies") == nodes[0]);
+	}
+
+	SUBCASE("Nodes removed from the tree during iteration should be skipped") {
+		int visited = 0;
+		tree->for_each_node_in_group("enemies", [&](Node *p_node) {
+			visited++;
+			if (p_node == nodes[0]) {
+				main_thread_parent->remove_child(nodes[2]);
+			}
+		});
+		CHECK(visited == node_count - 1);
+		CHECK(tree->get_node_count_in_group("enemies") == node_count - 1);
+		memdelete(nodes[2]);
+	}
+
+	SUBCASE("Threaded group calls should reach every node") {
+		tree->call_group_flags(SceneTree::GROUP_CALL_THREADED, "enemies", "set_meta", "hit", true);
+		for (Node *node : nodes) {
+			CHECK(node->has_meta("hit"));
+		}
+	}
+
+	memdelete(sub_thread_parent);
+	memdelete(main_thread_parent);
+}
+
+TEST_CASE("[SceneTree][Node][Benchmark] Calling a large group" * doctest::skip()) {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *parent = memnew(Node);
+	tree->get_root()->add_child(parent);
+
+	const int thread_group_count = 16;
+	const int node_count = 20000;
+	Vector<Node *> thread_groups;
+	for (int i = 0; i < thread_group_count; i++) {
+		Node *thread_group = memnew(Node);
+		parent->add_child(thread_group);
+		thread_group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		thread_groups.push_back(thread_group);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Vector<Node *> nodes;
+	for (int i = 0; i < node_count; i++) {
+		Node *node = memnew(Node);
+		thread_groups[i % thread_group_count]->add_child(node);
+		node->add_to_group("enemies");
+		nodes.push_back(node);
+	}
+	const uint64_t add_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	tree->call_group("enemies", "set_meta", "hit", 1);
+	const uint64_t sequential_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	tree->call_group_flags(SceneTree::GROUP_CALL_THREADED, "enemies", "set_meta", "hit", 2);
+	const uint64_t threaded_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int count = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	tree->for_each_node_in_group("enemies", [&count](Node *p_node) {
+		count += int(p_node->get_meta("hit")) == 2;
+	});
+	const uint64_t iterate_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(count == node_count);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < node_count; i += 2) {
+		nodes[i]->remove_from_group("enemies");
+	}
+	const uint64_t remove_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(tree->get_node_count_in_group("enemies") == node_count / 2);
+
+	MESSAGE(node_count, " nodes: adding ", add_usec, " usec, sequential call ", sequential_usec, " usec, threaded call ", threaded_usec, " usec, iterating ", iterate_usec, " usec, removing half ", remove_usec, " usec.");
+
+	memdelete(parent);
+}
+
 } // namespace TestNode
 
 #endif // TEST_NODE_H
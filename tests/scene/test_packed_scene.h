@@ -31,6 +31,8 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -215,6 +217,83 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+static Node *_make_spawn_scene(const Vector2 &p_position) {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("Bullet");
+	scene->set_position(p_position);
+	scene->set_rotation(0.5);
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Trail");
+	child->set_z_index(3);
+	child->set_visible(false);
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	Array binds;
+	binds.push_back("hidden");
+	binds.push_back(true);
+	child->connect("visibility_changed", Callable(scene, "set_meta").bindv(binds), Object::CONNECT_PERSIST);
+	return scene;
+}
+
+TEST_CASE("[PackedScene] Repeated instantiation") {
+	Node *scene = _make_spawn_scene(Vector2(4, 8));
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(scene) == OK);
+	memdelete(scene);
+
+	for (int i = 0; i < 3; i++) {
+		Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+		REQUIRE(instance);
+		CHECK(instance->get_position() == Vector2(4, 8));
+		CHECK(instance->get_rotation() == doctest::Approx(0.5));
+
+		Node2D *child = Object::cast_to<Node2D>(instance->get_node(NodePath("Trail")));
+		REQUIRE(child);
+		CHECK(child->get_z_index() == 3);
+		CHECK_FALSE(child->is_visible());
+
+		child->set_visible(true);
+		CHECK(instance->get_meta("hidden", false) == Variant(true));
+		memdelete(instance);
+	}
+
+	SUBCASE("Packing again should not reuse what was resolved for the previous scene") {
+		scene = _make_spawn_scene(Vector2(16, 32));
+		CHECK(packed_scene->pack(scene) == OK);
+		memdelete(scene);
+
+		Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+		REQUIRE(instance);
+		CHECK(instance->get_position() == Vector2(16, 32));
+		memdelete(instance);
+	}
+}
+
+TEST_CASE("[PackedScene][Benchmark] Spawn rate" * doctest::skip()) {
+	Node *scene = _make_spawn_scene(Vector2(4, 8));
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(scene) == OK);
+	memdelete(scene);
+
+	const int spawn_count = 500;
+	uint64_t usec[2] = {};
+	for (int pass = 0; pass < 2; pass++) {
+		SceneState::set_instantiate_plans_enabled(pass == 1);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < spawn_count; i++) {
+			memdelete(packed_scene->instantiate());
+		}
+		usec[pass] = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+	SceneState::set_instantiate_plans_enabled(true);
+
+	MESSAGE(spawn_count, " instantiations: ", usec[0], " usec resolving everything by name, ", usec[1], " usec with the instantiation plan.");
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,241 @@
+/**************************************************************************/
+/*  test_scene_pool.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_POOL_H
+#define TEST_SCENE_POOL_H
+
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_pool.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestScenePool {
+
+class _TestPooledNode : public Node2D {
+	GDCLASS(_TestPooledNode, Node2D);
+
+	Node *target = nullptr;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_target", "target"), &_TestPooledNode::set_target);
+		ClassDB::bind_method(D_METHOD("get_target"), &_TestPooledNode::get_target);
+		ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "target", PROPERTY_HINT_NODE_TYPE, "Node"), "set_target", "get_target");
+	}
+
+	void _notification(int p_what) {
+		switch (p_what) {
+			case NOTIFICATION_POOL_RELEASED: {
+				released++;
+			} break;
+			case NOTIFICATION_POOL_ACQUIRED: {
+				acquired++;
+			} break;
+		}
+	}
+
+public:
+	void set_target(Node *p_target) { target = p_target; }
+	Node *get_target() const { return target; }
+
+	int released = 0;
+	int acquired = 0;
+};
+
+static Ref<PackedScene> _make_pooled_scene() {
+	GDREGISTER_CLASS(_TestPooledNode);
+
+	_TestPooledNode *root = memnew(_TestPooledNode);
+	root->set_name("Projectile");
+	root->set_position(Vector2(1, 2));
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Sprite");
+	child->set_z_index(2);
+	root->add_child(child);
+	child->set_owner(root);
+	root->set_target(child);
+
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	CHECK(scene->pack(root) == OK);
+	memdelete(root);
+	return scene;
+}
+
+TEST_CASE("[SceneTree][ScenePool] Reusing instances") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_make_pooled_scene());
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	_TestPooledNode *node = Object::cast_to<_TestPooledNode>(pool->acquire());
+	REQUIRE(node);
+	CHECK(pool->get_available_count() == 0);
+	root->add_child(node);
+
+	SUBCASE("Released instances should be reused and reset") {
+		node->set_position(Vector2(50, 60));
+		node->set_rotation(1.0);
+		Node2D *child = Object::cast_to<Node2D>(node->get_node(NodePath("Sprite")));
+		child->set_z_index(7);
+		ObjectID id = node->get_instance_id();
+
+		pool->release(node);
+		CHECK_FALSE(node->is_inside_tree());
+		CHECK(node->get_parent() == nullptr);
+		CHECK(node->released == 1);
+		CHECK(pool->get_available_count() == 1);
+
+		_TestPooledNode *reused = Object::cast_to<_TestPooledNode>(pool->acquire());
+		REQUIRE(reused);
+		CHECK(reused->get_instance_id() == id);
+		CHECK(reused->acquired == 1);
+		CHECK(reused->get_position() == Vector2(1, 2));
+		CHECK(reused->get_rotation() == 0.0);
+		CHECK(child->get_z_index() == 2);
+		CHECK(pool->get_available_count() == 0);
+		memdelete(reused);
+	}
+
+	SUBCASE("Node references should be reset to the node of the same instance") {
+		_TestPooledNode *other = Object::cast_to<_TestPooledNode>(pool->acquire());
+		REQUIRE(other);
+		Node *other_child = other->get_node(NodePath("Sprite"));
+		CHECK(other->get_target() == other_child);
+		other->set_target(nullptr);
+
+		pool->release(other);
+		CHECK(pool->acquire() == other);
+		CHECK(other->get_target() == other_child);
+
+		memdelete(other);
+		memdelete(node);
+	}
+
+	SUBCASE("Instances released to a full pool should be freed") {
+		pool->set_max_size(1);
+		pool->prewarm(4);
+		CHECK(pool->get_available_count() == 1);
+
+		ObjectID id = node->get_instance_id();
+		pool->release(node);
+		CHECK(pool->get_available_count() == 1);
+		CHECK(node->is_queued_for_deletion());
+		SceneTree::get_singleton()->process(0);
+		CHECK(ObjectDB::get_instance(id) == nullptr);
+	}
+
+	SUBCASE("Instances of other scenes should be rejected") {
+		Node2D *other = memnew(Node2D);
+		other->set_scene_file_path("res://other_scene.tscn");
+		root->add_child(other);
+
+		ERR_PRINT_OFF;
+		pool->release(other);
+		ERR_PRINT_ON;
+		CHECK(other->get_parent() == root);
+		CHECK(pool->get_available_count() == 0);
+
+		memdelete(other);
+		memdelete(node);
+	}
+
+	SUBCASE("Instances kept in the tree should be dormant until reused") {
+		pool->set_keep_in_tree(true);
+		pool->release(node);
+		CHECK(node->get_parent() == root);
+		CHECK_FALSE(node->can_process());
+		CHECK_FALSE(node->is_visible());
+		CHECK(node->released == 1);
+
+		CHECK(pool->acquire() == node);
+		CHECK(node->get_parent() == root);
+		CHECK(node->can_process());
+		CHECK(node->is_visible());
+		CHECK(node->acquired == 1);
+		memdelete(node);
+	}
+
+	SUBCASE("Clearing the pool should free the available instances") {
+		ObjectID id = node->get_instance_id();
+		pool->release(node);
+		pool->clear();
+		CHECK(pool->get_available_count() == 0);
+		CHECK(ObjectDB::get_instance(id) == nullptr);
+	}
+}
+
+TEST_CASE("[SceneTree][ScenePool][Benchmark] Spawning and despawning" * doctest::skip()) {
+	Ref<PackedScene> scene = _make_pooled_scene();
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(scene);
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	const int cycles = 1000;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < cycles; i++) {
+		Node *node = scene->instantiate();
+		root->add_child(node);
+		root->remove_child(node);
+		memdelete(node);
+	}
+	const uint64_t instantiate_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < cycles; i++) {
+		Node *node = pool->acquire();
+		root->add_child(node);
+		pool->release(node);
+	}
+	const uint64_t pool_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(pool->get_available_count() == 1);
+
+	pool->set_keep_in_tree(true);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < cycles; i++) {
+		Node *node = pool->acquire();
+		if (!node->is_inside_tree()) {
+			root->add_child(node);
+		}
+		pool->release(node);
+	}
+	const uint64_t dormant_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(pool->get_available_count() == 1);
+
+	MESSAGE(cycles, " spawns: ", instantiate_usec, " usec instantiating and freeing, ", pool_usec, " usec through a pool, ", dormant_usec, " usec through a pool keeping instances in the tree.");
+}
+
+} // namespace TestScenePool
+
+#endif // TEST_SCENE_POOL_H
@@ -33,7 +33,9 @@
 
 #include "tests/test_macros.h"
 
+#include "core/os/os.h"
 #include "scene/3d/skeleton_3d.h"
+#include "scene/main/window.h"
 
 namespace TestSkeleton3D {
 
@@ -73,6 +75,108 @@ TEST_CASE("[Skeleton3D] Test per-bone meta") {
 	skeleton->set_bone_meta(0, "non-existing-key", Variant());
 	memdelete(skeleton);
 }
+
+// Two chains of `p_chain_length` bones, the second one branching in the middle.
+static Skeleton3D *_make_branched_skeleton(int p_chain_length) {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	for (int chain = 0; chain < 2; chain++) {
+		for (int i = 0; i < p_chain_length; i++) {
+			int bone = skeleton->add_bone(vformat("chain_%d_%d", chain, i));
+			if (i > 0) {
+				skeleton->set_bone_parent(bone, bone - 1);
+			}
+			skeleton->set_bone_rest(bone, Transform3D(Basis(), Vector3(0, 1, 0)));
+			skeleton->set_bone_pose_position(bone, Vector3(0, 1, 0));
+		}
+	}
+	int branch = skeleton->add_bone("branch");
+	skeleton->set_bone_parent(branch, p_chain_length + p_chain_length / 2);
+	skeleton->set_bone_pose_position(branch, Vector3(1, 0, 0));
+	return skeleton;
+}
+
+static Transform3D _expected_global_pose(Skeleton3D *p_skeleton, int p_bone) {
+	int parent = p_skeleton->get_bone_parent(p_bone);
+	Transform3D pose = p_skeleton->get_bone_pose(p_bone);
+	return parent >= 0 ? _expected_global_pose(p_skeleton, parent) * pose : pose;
+}
+
+static bool _global_poses_match(Skeleton3D *p_skeleton) {
+	for (int i = 0; i < p_skeleton->get_bone_count(); i++) {
+		if (!p_skeleton->get_bone_global_pose(i).is_equal_approx(_expected_global_pose(p_skeleton, i))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Global poses are only recalculated for the changed bones") {
+	const int chain_length = 6;
+	Skeleton3D *skeleton = _make_branched_skeleton(chain_length);
+	SceneTree::get_singleton()->get_root()->add_child(skeleton);
+	SceneTree::get_singleton()->process(0.016);
+	CHECK(_global_poses_match(skeleton));
+
+	SUBCASE("A bone and its children are updated once per frame") {
+		// Bones chain_1_3 to chain_1_5, and the branch.
+		skeleton->set_bone_pose_rotation(chain_length + 3, Quaternion(Vector3(0, 0, 1), 0.5));
+		skeleton->set_bone_pose_rotation(chain_length + 4, Quaternion(Vector3(1, 0, 0), 0.5));
+		SceneTree::get_singleton()->process(0.016);
+		CHECK(skeleton->get_global_pose_update_count() == 1);
+		CHECK(skeleton->get_global_pose_bone_update_count() == 4);
+		CHECK(_global_poses_match(skeleton));
+	}
+
+	SUBCASE("Poses requested before the update are not calculated again") {
+		skeleton->set_bone_pose_rotation(1, Quaternion(Vector3(0, 1, 0), 0.5));
+		CHECK(skeleton->get_bone_global_pose(2).is_equal_approx(_expected_global_pose(skeleton, 2)));
+		SceneTree::get_singleton()->process(0.016);
+		CHECK(skeleton->get_global_pose_bone_update_count() == chain_length - 1);
+		CHECK(_global_poses_match(skeleton));
+	}
+
+	SUBCASE("Updating the children of a bone leaves the other bones dirty") {
+		skeleton->set_bone_pose_rotation(0, Quaternion(Vector3(0, 0, 1), 0.5));
+		skeleton->set_bone_pose_rotation(chain_length, Quaternion(Vector3(0, 0, 1), 0.5));
+		skeleton->force_update_bone_children_transforms(chain_length);
+		CHECK(skeleton->get_bone_global_pose(chain_length * 2).is_equal_approx(_expected_global_pose(skeleton, chain_length * 2)));
+		SceneTree::get_singleton()->process(0.016);
+		CHECK(skeleton->get_global_pose_bone_update_count() == chain_length * 2 + 1);
+		CHECK(_global_poses_match(skeleton));
+	}
+
+	memdelete(skeleton);
+}
+
+TEST_CASE("[SceneTree][Skeleton3D][Benchmark] Update the global poses of many skeletons" * doctest::skip()) {
+	const int skeleton_count = 200;
+	const int frame_count = 30;
+	LocalVector<Skeleton3D *> skeletons;
+	for (int i = 0; i < skeleton_count; i++) {
+		Skeleton3D *skeleton = _make_branched_skeleton(30);
+		SceneTree::get_singleton()->get_root()->add_child(skeleton);
+		skeletons.push_back(skeleton);
+	}
+	SceneTree::get_singleton()->process(0.016);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		for (Skeleton3D *skeleton : skeletons) {
+			for (int bone = 0; bone < skeleton->get_bone_count(); bone += 3) {
+				skeleton->set_bone_pose_rotation(bone, Quaternion(Vector3(0, 0, 1), frame * 0.01));
+			}
+		}
+		SceneTree::get_singleton()->process(0.016);
+	}
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("%d skeletons with %d bones, %.3f ms per frame.", skeleton_count, skeletons[0]->get_bone_count(), elapsed / 1000.0 / frame_count));
+
+	for (Skeleton3D *skeleton : skeletons) {
+		memdelete(skeleton);
+	}
+}
+
 } // namespace TestSkeleton3D
 
 #endif // TEST_SKELETON_3D_H
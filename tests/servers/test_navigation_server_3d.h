@@ -790,6 +790,31 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same results as individual queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(i % 4, 0, i / 4));
+				query_parameters->set_target_position(Vector3(10 - i % 4, 0, 10 - i / 4));
+				query_parameters->set_navigation_layers(i % 5 == 0 ? 2 : 1);
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+			navigation_server->query_paths(batch_parameters, batch_results);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(batch_parameters[i], query_result);
+				const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_types(), query_result->get_path_types());
+				CHECK_EQ(batch_result->get_path_rids(), query_result->get_path_rids());
+				CHECK_EQ(batch_result->get_path_owner_ids(), query_result->get_path_owner_ids());
+			}
+		}
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.